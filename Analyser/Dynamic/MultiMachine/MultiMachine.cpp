@@ -57,6 +57,11 @@ MachineTypes::MouseMachine *MultiMachine::mouse_machine() {
 	return nullptr;
 }
 
+MachineTypes::StateProducer *MultiMachine::state_producer() {
+	// State can be captured only once a single machine has been settled upon.
+	return has_picked_ ? machines_.front()->state_producer() : nullptr;
+}
+
 #undef Provider
 
 bool MultiMachine::would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines) {
@@ -20,9 +20,13 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 		FourMegabytes);
 	MemorySize memory_size = MemorySize::OneMegabyte;
 
+	/// Substitutes an instruction-granularity 68000, which is much faster but only approximately timed.
+	bool fast_cpu = false;
+
 	Target() : Analyser::Static::Target(Machine::AtariST) {
 		if(needs_declare()) {
 			DeclareField(memory_size);
+			DeclareField(fast_cpu);
 			AnnounceEnum(MemorySize);
 		}
 	}
@@ -18,10 +18,14 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 	ReflectableEnum(Model, Mac128k, Mac512k, Mac512ke, MacPlus);
 	Model model = Model::MacPlus;
 
+	/// Substitutes an instruction-granularity 68000, which is much faster but only approximately timed.
+	bool fast_cpu = false;
+
 	Target() : Analyser::Static::Target(Machine::Macintosh) {
 		// Boilerplate for declaring fields and potential values.
 		if(needs_declare()) {
 			DeclareField(model);
+			DeclareField(fast_cpu);
 			AnnounceEnum(Model);
 		}
 	}
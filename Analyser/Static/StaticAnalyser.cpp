@@ -13,6 +13,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <iterator>
+#include <limits>
 
 // Analysers
 #include "Acorn/StaticAnalyser.hpp"
@@ -84,6 +85,7 @@
 #include "../../Storage/Tape/Formats/ZXSpectrumTAP.hpp"
 
 // Target Platform Types
+#include "../../Storage/Archive.hpp"
 #include "../../Storage/TargetPlatforms.hpp"
 
 template<class> inline constexpr bool always_false_v = false;
@@ -105,8 +107,9 @@ std::string get_extension(const std::string &name) {
 
 class MediaAccumulator {
 	public:
-	MediaAccumulator(const std::string &file_name, TargetPlatform::IntType &potential_platforms) :
-		file_name_(file_name), potential_platforms_(potential_platforms), extension_(get_extension(file_name)) {}
+	MediaAccumulator(const std::string &file_name, TargetPlatform::IntType &potential_platforms, bool copy_on_write) :
+		file_name_(file_name), potential_platforms_(potential_platforms), extension_(get_extension(file_name)),
+		copy_on_write_(copy_on_write) {}
 
 	/// Adds @c instance to the media collection and adds @c platforms to the set of potentials.
 	/// If @c instance is an @c TargetPlatform::TypeDistinguisher then it is given an opportunity to restrict the set of potentials.
@@ -155,6 +158,15 @@ class MediaAccumulator {
 		}
 	}
 
+	/// Performs a @c try_insert for a mass storage device of @c InstanceT if @c extension matches that of the file name,
+	/// providing the file name and whether to open it copy-on-write as construction arguments.
+	template <typename InstanceT>
+	void try_mass_storage(TargetPlatform::IntType platforms, const char *extension) {
+		if(name_matches(extension))	{
+			try_insert<InstanceT>(platforms, file_name_, copy_on_write_);
+		}
+	}
+
 	bool name_matches(const char *extension) {
 		return extension_ == extension;
 	}
@@ -165,18 +177,30 @@ class MediaAccumulator {
 		const std::string &file_name_;
 		TargetPlatform::IntType &potential_platforms_;
 		const std::string extension_;
+		const bool copy_on_write_;
 };
 
 }
 
-static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::IntType &potential_platforms) {
-	MediaAccumulator accumulator(file_name, potential_platforms);
+static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::IntType &potential_platforms, bool copy_on_write) {
+	// If this is an archive, collect media from all files within it.
+	const auto archived_files = Storage::Archive::expand(file_name);
+	if(!archived_files.empty()) {
+		Media media;
+		for(const auto &archived_file: archived_files) {
+			media += GetMediaAndPlatforms(archived_file, potential_platforms, copy_on_write);
+		}
+		Storage::Archive::release(file_name);
+		return media;
+	}
+
+	MediaAccumulator accumulator(file_name, potential_platforms, copy_on_write);
 
 	// 2MG
 	if(accumulator.name_matches("2mg")) {
 		// 2MG uses a factory method; defer to it.
 		try {
-			const auto media = Disk::Disk2MG::open(file_name);
+			const auto media = Disk::Disk2MG::open(file_name, copy_on_write);
 			std::visit([&](auto &&arg) {
 				using Type = typename std::decay<decltype(arg)>::type;
 
@@ -210,7 +234,7 @@ static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::
 	accumulator.try_standard<Tape::CSW>(TargetPlatform::AllTape, "csw");
 
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::D64>>(TargetPlatform::Commodore, "d64");
-	accumulator.try_standard<MassStorage::DAT>(TargetPlatform::Acorn, "dat");
+	accumulator.try_mass_storage<MassStorage::DAT>(TargetPlatform::Acorn, "dat");
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::DMK>>(TargetPlatform::MSX, "dmk");
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::AppleDSK>>(TargetPlatform::DiskII, "do");
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::SSD>>(TargetPlatform::Acorn, "dsd");
@@ -218,14 +242,18 @@ static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::
 		TargetPlatform::AmstradCPC | TargetPlatform::Oric | TargetPlatform::ZXSpectrum, "dsk");
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::AppleDSK>>(TargetPlatform::DiskII, "dsk");
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::MacintoshIMG>>(TargetPlatform::Macintosh, "dsk");
-	accumulator.try_standard<MassStorage::HFV>(TargetPlatform::Macintosh, "dsk");
-	accumulator.try_standard<MassStorage::DSK>(TargetPlatform::Macintosh, "dsk");
+	accumulator.try_mass_storage<MassStorage::HFV>(TargetPlatform::Macintosh, "dsk");
+	accumulator.try_mass_storage<MassStorage::DSK>(TargetPlatform::Macintosh, "dsk");
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::FAT12>>(TargetPlatform::MSX, "dsk");
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::OricMFMDSK>>(TargetPlatform::Oric, "dsk");
 
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::G64>>(TargetPlatform::Commodore, "g64");
 
-	accumulator.try_standard<MassStorage::HDV>(TargetPlatform::AppleII, "hdv");
+	if(accumulator.name_matches("hdv")) {
+		accumulator.try_insert<MassStorage::HDV>(
+			TargetPlatform::AppleII,
+			file_name, 0, std::numeric_limits<long>::max(), copy_on_write);
+	}
 	accumulator.try_standard<Disk::DiskImageHolder<Disk::HFE>>(
 		TargetPlatform::Acorn | TargetPlatform::AmstradCPC | TargetPlatform::Commodore | TargetPlatform::Oric | TargetPlatform::ZXSpectrum,
 		"hfe");	// TODO: switch to AllDisk once the MSX stops being so greedy.
@@ -298,12 +326,12 @@ static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::
 	return accumulator.media;
 }
 
-Media Analyser::Static::GetMedia(const std::string &file_name) {
+Media Analyser::Static::GetMedia(const std::string &file_name, bool copy_on_write) {
 	TargetPlatform::IntType throwaway;
-	return GetMediaAndPlatforms(file_name, throwaway);
+	return GetMediaAndPlatforms(file_name, throwaway, copy_on_write);
 }
 
-TargetList Analyser::Static::GetTargets(const std::string &file_name) {
+TargetList Analyser::Static::GetTargets(const std::string &file_name, bool copy_on_write) {
 	const std::string extension = get_extension(file_name);
 	TargetList targets;
 
@@ -327,12 +355,27 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 	if(try_snapshot("szx", Storage::State::SZX::load)) return targets;
 	if(try_snapshot("z80", Storage::State::Z80::load)) return targets;
 
+	// If this is an archive, evaluate each file within it independently.
+	const auto archived_files = Storage::Archive::expand(file_name);
+	if(!archived_files.empty()) {
+		for(const auto &archived_file: archived_files) {
+			auto new_targets = GetTargets(archived_file, copy_on_write);
+			std::move(new_targets.begin(), new_targets.end(), std::back_inserter(targets));
+		}
+		Storage::Archive::release(file_name);
+		std::stable_sort(targets.begin(), targets.end(),
+			[] (const std::unique_ptr<Target> &a, const std::unique_ptr<Target> &b) {
+				return a->confidence > b->confidence;
+			});
+		return targets;
+	}
+
 	// Otherwise:
 	//
 	// Collect all disks, tapes ROMs, etc as can be extrapolated from this file, forming the
 	// union of all platforms this file might be a target for.
 	TargetPlatform::IntType potential_platforms = 0;
-	Media media = GetMediaAndPlatforms(file_name, potential_platforms);
+	Media media = GetMediaAndPlatforms(file_name, potential_platforms, copy_on_write);
 
 	// Hand off to platform-specific determination of whether these
 	// things are actually compatible and, if so, how to load them.
@@ -71,13 +71,19 @@ typedef std::vector<std::unique_ptr<Target>> TargetList;
 /*!
 	Attempts, through any available means, to return a list of potential targets for the file with the given name.
 
+	If @c copy_on_write is @c true then any mass storage devices are opened such that writes
+	are retained in memory only, leaving the underlying file unmodified.
+
 	@returns The list of potential targets, sorted from most to least probable.
 */
-TargetList GetTargets(const std::string &file_name);
+TargetList GetTargets(const std::string &file_name, bool copy_on_write = false);
 
 /*!
 	Inspects the supplied file and determines the media included.
+
+	If @c copy_on_write is @c true then any mass storage devices are opened such that writes
+	are retained in memory only, leaving the underlying file unmodified.
 */
-Media GetMedia(const std::string &file_name);
+Media GetMedia(const std::string &file_name, bool copy_on_write = false);
 
 }
@@ -13,6 +13,7 @@
 #include "Implementation/6522Storage.hpp"
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 
 namespace MOS::MOS6522 {
 
@@ -112,12 +113,20 @@ template <class BusHandlerT> class MOS6522: public MOS6522Storage {
 		/// @returns @c true if the IRQ line is currently active; @c false otherwise.
 		bool get_interrupt_line() const;
 
+		/// @returns The time until this 6522 next might change its interrupt line or outputs other than
+		/// as a result of a register access or input change; @c HalfCycles::max() if no such change is pending.
+		/// This permits a 6522 to be held in a @c JustInTimeActor.
+		HalfCycles next_sequence_point() const;
+
 		/// Updates the port handler to the current time and then requests that it flush.
 		void flush();
 
 	private:
 		void do_phase1();
 		void do_phase2();
+		bool is_quiet() const;
+		int quiet_cycles() const;
+		void skip_cycles(int cycles);
 		void shift_in();
 		void shift_out();
 
@@ -136,6 +145,123 @@ template <class BusHandlerT> class MOS6522: public MOS6522Storage {
 		void evaluate_port_b_output();
 };
 
+/*!
+	Captures the complete internal state of a 6522; bus handlers should be flushed
+	before capture as time owed to them isn't included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	uint8_t output[2]{}, input[2]{}, data_direction[2]{};
+	uint16_t timer[2]{}, timer_latch[2]{}, last_timer[2]{};
+	int next_timer[2] = {-1, -1};
+	uint8_t shift = 0;
+	uint8_t auxiliary_control = 0, peripheral_control = 0;
+	uint8_t interrupt_flags = 0, interrupt_enable = 0;
+	bool timer_needs_reload = false;
+	uint8_t timer_port_b_output = 0xff;
+
+	bool is_phase2 = false;
+	bool control_inputs[4]{};		// CA1, CA2, CB1, CB2.
+	uint8_t control_outputs[4]{};	// As above; 0 = on, 1 = off, 2 = input.
+	uint8_t handshake_modes[2]{};
+	bool timer_is_running[2]{};
+	bool interrupt_status = false;
+	int shift_bits_remaining = 8;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(output);
+			DeclareField(input);
+			DeclareField(data_direction);
+			DeclareField(timer);
+			DeclareField(timer_latch);
+			DeclareField(last_timer);
+			DeclareField(next_timer);
+			DeclareField(shift);
+			DeclareField(auxiliary_control);
+			DeclareField(peripheral_control);
+			DeclareField(interrupt_flags);
+			DeclareField(interrupt_enable);
+			DeclareField(timer_needs_reload);
+			DeclareField(timer_port_b_output);
+			DeclareField(is_phase2);
+			DeclareField(control_inputs);
+			DeclareField(control_outputs);
+			DeclareField(handshake_modes);
+			DeclareField(timer_is_running);
+			DeclareField(interrupt_status);
+			DeclareField(shift_bits_remaining);
+		}
+	}
+
+	State(const MOS6522Storage &source) : State() {
+		const auto &registers = source.registers_;
+		for(int c = 0; c < 2; c++) {
+			output[c] = registers.output[c];
+			input[c] = registers.input[c];
+			data_direction[c] = registers.data_direction[c];
+			timer[c] = registers.timer[c];
+			timer_latch[c] = registers.timer_latch[c];
+			last_timer[c] = registers.last_timer[c];
+			next_timer[c] = registers.next_timer[c];
+
+			control_inputs[c*2 + 0] = source.control_inputs_[c].lines[0];
+			control_inputs[c*2 + 1] = source.control_inputs_[c].lines[1];
+			control_outputs[c*2 + 0] = uint8_t(source.control_outputs_[c].lines[0]);
+			control_outputs[c*2 + 1] = uint8_t(source.control_outputs_[c].lines[1]);
+			handshake_modes[c] = uint8_t(source.handshake_modes_[c]);
+			timer_is_running[c] = source.timer_is_running_[c];
+		}
+		shift = registers.shift;
+		auxiliary_control = registers.auxiliary_control;
+		peripheral_control = registers.peripheral_control;
+		interrupt_flags = registers.interrupt_flags;
+		interrupt_enable = registers.interrupt_enable;
+		timer_needs_reload = registers.timer_needs_reload;
+		timer_port_b_output = registers.timer_port_b_output;
+
+		is_phase2 = source.is_phase2_;
+		interrupt_status = source.last_posted_interrupt_status_;
+		shift_bits_remaining = source.shift_bits_remaining_;
+	}
+
+	/// Restores this state to @c target, then informs its bus handler of the interrupt line.
+	/// Port and control line outputs are not reposted; those are assumed to be captured by
+	/// the owner of the port handler.
+	template <typename VIA> void apply(VIA &target) const {
+		MOS6522Storage &storage = target;
+		auto &registers = storage.registers_;
+		for(int c = 0; c < 2; c++) {
+			registers.output[c] = output[c];
+			registers.input[c] = input[c];
+			registers.data_direction[c] = data_direction[c];
+			registers.timer[c] = timer[c];
+			registers.timer_latch[c] = timer_latch[c];
+			registers.last_timer[c] = last_timer[c];
+			registers.next_timer[c] = next_timer[c];
+
+			storage.control_inputs_[c].lines[0] = control_inputs[c*2 + 0];
+			storage.control_inputs_[c].lines[1] = control_inputs[c*2 + 1];
+			storage.control_outputs_[c].lines[0] = MOS6522Storage::LineState(control_outputs[c*2 + 0]);
+			storage.control_outputs_[c].lines[1] = MOS6522Storage::LineState(control_outputs[c*2 + 1]);
+			storage.handshake_modes_[c] = MOS6522Storage::HandshakeMode(handshake_modes[c]);
+			storage.timer_is_running_[c] = timer_is_running[c];
+		}
+		registers.shift = shift;
+		registers.auxiliary_control = auxiliary_control;
+		registers.peripheral_control = peripheral_control;
+		registers.interrupt_flags = interrupt_flags;
+		registers.interrupt_enable = interrupt_enable;
+		registers.timer_needs_reload = timer_needs_reload;
+		registers.timer_port_b_output = timer_port_b_output;
+
+		storage.is_phase2_ = is_phase2;
+		storage.last_posted_interrupt_status_ = interrupt_status;
+		storage.shift_bits_remaining_ = shift_bits_remaining;
+
+		target.bus_handler().set_interrupt_status(interrupt_status);
+	}
+};
+
 }
 
 #include "Implementation/6522Implementation.hpp"
@@ -8,6 +8,8 @@
 
 #include "../../../Outputs/Log.hpp"
 
+#include <algorithm>
+
 // As-yet unimplemented (incomplete list):
 //
 //	PB6 count-down mode for timer 2.
@@ -383,6 +385,79 @@ template <typename T> void MOS6522<T>::evaluate_port_b_output() {
 		registers_.data_direction[1] | timer_control_bit);
 }
 
+template <typename T> bool MOS6522<T>::is_quiet() const {
+	// Reloads, pending timer writes, pulse-mode outputs yet to return high and shifting under
+	// phase 2 all mean that something other than a timer decrement will happen on the next cycle.
+	// Pulse mode on CB2 also reannounces the shift register's output each cycle, which might have
+	// been changed by a write.
+	return
+		!registers_.timer_needs_reload &&
+		registers_.next_timer[0] < 0 &&
+		registers_.next_timer[1] < 0 &&
+		(handshake_modes_[0] != HandshakeMode::Pulse || control_outputs_[0].lines[1] == LineState::On) &&
+		(
+			handshake_modes_[1] != HandshakeMode::Pulse ||
+			(control_outputs_[1].lines[1] == LineState::On && shift_mode() == ShiftMode::Disabled)
+		) &&
+		!is_shifting_under_phase2();
+}
+
+template <typename T> int MOS6522<T>::quiet_cycles() const {
+	if(!is_quiet()) return 0;
+
+	int cycles = std::numeric_limits<int>::max();
+	if(timer_is_running_[0]) {
+		cycles = cycles_until_underflow(registers_.timer[0], registers_.last_timer[0], 1);
+	}
+	if(timer_is_running_[1]) {
+		cycles = std::min(cycles, cycles_until_underflow(registers_.timer[1], registers_.last_timer[1], timer2_clock_decrement()));
+	}
+	return cycles;
+}
+
+template <typename T> void MOS6522<T>::skip_cycles(int cycles) {
+	// Equivalent to performing do_phase1() and do_phase2() the specified number of times,
+	// provided that number is no greater than quiet_cycles().
+	const int timer2_decrement = timer2_clock_decrement();
+	registers_.last_timer[0] = uint16_t(registers_.timer[0] - (cycles - 1));
+	registers_.timer[0] = uint16_t(registers_.last_timer[0] - 1);
+	registers_.last_timer[1] = uint16_t(registers_.timer[1] - (cycles - 1) * timer2_decrement);
+	registers_.timer[1] = uint16_t(registers_.last_timer[1] - timer2_decrement);
+	time_since_bus_handler_call_ += HalfCycles(cycles * 2);
+}
+
+template <typename T> HalfCycles MOS6522<T>::next_sequence_point() const {
+	if(!is_quiet()) return HalfCycles(1);
+
+	// A pending phase 2 will be just a decrement, so apply it here.
+	uint16_t timer[2] = {registers_.timer[0], registers_.timer[1]};
+	uint16_t last_timer[2] = {registers_.last_timer[0], registers_.last_timer[1]};
+	const int timer2_decrement = timer2_clock_decrement();
+	if(is_phase2_) {
+		last_timer[0] = timer[0];
+		last_timer[1] = timer[1];
+		--timer[0];
+		timer[1] = uint16_t(timer[1] - timer2_decrement);
+	}
+
+	// Consider only those underflows that might have an external effect: upon the interrupt line,
+	// PB7 or the shift register.
+	int cycles = std::numeric_limits<int>::max();
+	if(timer_is_running_[0] && ((registers_.interrupt_enable & InterruptFlag::Timer1) || timer1_is_controlling_pb7())) {
+		cycles = cycles_until_underflow(timer[0], last_timer[0], 1);
+	}
+	if(timer_is_running_[1] && ((registers_.interrupt_enable & InterruptFlag::Timer2) || is_shifting_under_t2())) {
+		cycles = std::min(cycles, cycles_until_underflow(timer[1], last_timer[1], timer2_decrement));
+	}
+
+	if(cycles == std::numeric_limits<int>::max()) {
+		return HalfCycles::max();
+	}
+
+	// Underflows are observed during phase 1.
+	return HalfCycles(cycles * 2 + (is_phase2_ ? 2 : 1));
+}
+
 /*! Runs for a specified number of half cycles. */
 template <typename T> void MOS6522<T>::run_for(const HalfCycles half_cycles) {
 	auto number_of_half_cycles = half_cycles.as_integral();
@@ -394,9 +469,15 @@ template <typename T> void MOS6522<T>::run_for(const HalfCycles half_cycles) {
 	}
 
 	while(number_of_half_cycles >= 2) {
-		do_phase1();
-		do_phase2();
-		number_of_half_cycles -= 2;
+		const auto cycles = std::min<decltype(number_of_half_cycles)>(quiet_cycles(), number_of_half_cycles >> 1);
+		if(cycles) {
+			skip_cycles(int(cycles));
+			number_of_half_cycles -= cycles * 2;
+		} else {
+			do_phase1();
+			do_phase2();
+			number_of_half_cycles -= 2;
+		}
 	}
 
 	if(number_of_half_cycles) {
@@ -415,9 +496,16 @@ template <typename T> void MOS6522<T>::flush() {
 /*! Runs for a specified number of cycles. */
 template <typename T> void MOS6522<T>::run_for(const Cycles cycles) {
 	auto number_of_cycles = cycles.as_integral();
-	while(number_of_cycles--) {
-		do_phase1();
-		do_phase2();
+	while(number_of_cycles) {
+		const auto quiet = std::min<decltype(number_of_cycles)>(quiet_cycles(), number_of_cycles);
+		if(quiet) {
+			skip_cycles(int(quiet));
+			number_of_cycles -= quiet;
+		} else {
+			do_phase1();
+			do_phase2();
+			--number_of_cycles;
+		}
 	}
 }
 
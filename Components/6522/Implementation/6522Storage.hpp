@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 
 namespace MOS::MOS6522 {
 
@@ -97,12 +98,31 @@ class MOS6522Storage {
 		ShiftMode shift_mode() const {
 			return ShiftMode((registers_.auxiliary_control >> 2) & 7);
 		}
+		bool is_shifting_under_t2() const {
+			const auto mode = shift_mode();
+			return mode == ShiftMode::InUnderT2 || mode == ShiftMode::OutUnderT2FreeRunning || mode == ShiftMode::OutUnderT2;
+		}
+		bool is_shifting_under_phase2() const {
+			const auto mode = shift_mode();
+			return mode == ShiftMode::InUnderPhase2 || mode == ShiftMode::OutUnderPhase2;
+		}
 		bool portb_is_latched() const {
 			return registers_.auxiliary_control & 0x02;
 		}
 		bool port1_is_latched() const {
 			return registers_.auxiliary_control & 0x01;
 		}
+
+		/// @returns The number of whole cycles, each beginning with phase 1, that will elapse before a running
+		/// timer that holds @c timer, having previously held @c last_timer, is seen to underflow when decremented
+		/// by @c decrement per cycle; @c std::numeric_limits<int>::max() if it never will.
+		static int cycles_until_underflow(uint16_t timer, uint16_t last_timer, int decrement) {
+			if(timer == 0xffff && !last_timer) return 0;
+			if(!decrement) return std::numeric_limits<int>::max();
+			return timer + 1;
+		}
+
+		friend struct State;
 };
 
 }
@@ -13,9 +13,15 @@
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
+#include "../../Reflection/Struct.hpp"
+
+#include <algorithm>
+#include <iterator>
 
 namespace MOS::MOS6560 {
 
+struct State;
+
 // audio state
 class AudioGenerator: public ::Outputs::Speaker::SampleSource {
 	public:
@@ -511,6 +517,105 @@ template <class BusHandler> class MOS6560 {
 			bool supports_interlacing = 0;
 		} timing_;
 		OutputMode output_mode_ = OutputMode::NTSC;
+
+		friend struct ::MOS::MOS6560::State;
+};
+
+/*!
+	Captures the register and raster state of a 6560; the output mode is considered to be
+	part of machine configuration rather than state.
+*/
+struct State: public Reflection::StructImpl<State> {
+	uint8_t registers[16]{};
+
+	int horizontal_counter = 0, vertical_counter = 0;
+	bool vertical_drawing_latch = false, horizontal_drawing_latch = false;
+	int rows_this_field = 0, columns_this_line = 0;
+	int pixel_line_cycle = 0, column_counter = 0;
+	int current_row = 0;
+	uint16_t current_character_row = 0;
+	uint16_t video_matrix_address_counter = 0, base_video_matrix_address_counter = 0;
+	uint8_t character_code = 0, character_colour = 0, character_value = 0;
+	bool is_odd_frame = false, is_odd_line = false;
+	uint8_t output_state = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(registers);
+			DeclareField(horizontal_counter);
+			DeclareField(vertical_counter);
+			DeclareField(vertical_drawing_latch);
+			DeclareField(horizontal_drawing_latch);
+			DeclareField(rows_this_field);
+			DeclareField(columns_this_line);
+			DeclareField(pixel_line_cycle);
+			DeclareField(column_counter);
+			DeclareField(current_row);
+			DeclareField(current_character_row);
+			DeclareField(video_matrix_address_counter);
+			DeclareField(base_video_matrix_address_counter);
+			DeclareField(character_code);
+			DeclareField(character_colour);
+			DeclareField(character_value);
+			DeclareField(is_odd_frame);
+			DeclareField(is_odd_line);
+			DeclareField(output_state);
+		}
+	}
+
+	template <typename Chip> State(const Chip &source) : State() {
+		std::copy(std::begin(source.registers_.direct_values), std::end(source.registers_.direct_values), std::begin(registers));
+
+		horizontal_counter = source.horizontal_counter_;
+		vertical_counter = source.vertical_counter_;
+		vertical_drawing_latch = source.vertical_drawing_latch_;
+		horizontal_drawing_latch = source.horizontal_drawing_latch_;
+		rows_this_field = source.rows_this_field_;
+		columns_this_line = source.columns_this_line_;
+		pixel_line_cycle = source.pixel_line_cycle_;
+		column_counter = source.column_counter_;
+		current_row = source.current_row_;
+		current_character_row = source.current_character_row_;
+		video_matrix_address_counter = source.video_matrix_address_counter_;
+		base_video_matrix_address_counter = source.base_video_matrix_address_counter_;
+		character_code = source.character_code_;
+		character_colour = source.character_colour_;
+		character_value = source.character_value_;
+		is_odd_frame = source.is_odd_frame_;
+		is_odd_line = source.is_odd_line_;
+		output_state = uint8_t(source.this_state_);
+	}
+
+	template <typename Chip> void apply(Chip &target) const {
+		// Replay register writes; that'll also reestablish derived register
+		// state and the audio generator.
+		for(int c = 0; c < 16; c++) {
+			target.write(c, registers[c]);
+		}
+
+		target.horizontal_counter_ = horizontal_counter;
+		target.vertical_counter_ = vertical_counter;
+		target.vertical_drawing_latch_ = vertical_drawing_latch;
+		target.horizontal_drawing_latch_ = horizontal_drawing_latch;
+		target.rows_this_field_ = rows_this_field;
+		target.columns_this_line_ = columns_this_line;
+		target.pixel_line_cycle_ = pixel_line_cycle;
+		target.column_counter_ = column_counter;
+		target.current_row_ = current_row;
+		target.current_character_row_ = current_character_row;
+		target.video_matrix_address_counter_ = video_matrix_address_counter;
+		target.base_video_matrix_address_counter_ = base_video_matrix_address_counter;
+		target.character_code_ = character_code;
+		target.character_colour_ = character_colour;
+		target.character_value_ = character_value;
+		target.is_odd_frame_ = is_odd_frame;
+		target.is_odd_line_ = is_odd_line;
+
+		// Begin a new run of output from here; the CRT will resynchronise.
+		target.this_state_ = target.output_state_ = decltype(target.this_state_)(output_state);
+		target.cycles_in_state_ = 0;
+		target.pixel_pointer = nullptr;
+	}
 };
 
 }
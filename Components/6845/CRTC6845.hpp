@@ -9,9 +9,12 @@
 #pragma once
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <iterator>
 
 namespace Motorola::CRTC {
 
@@ -410,6 +413,116 @@ template <class BusHandlerT, Personality personality, CursorType cursor_type> cl
 		unsigned int character_is_visible_shifter_ = 0;
 
 		bool is_cursor_line_ = false;
+
+		friend struct State;
+};
+
+struct State: public Reflection::StructImpl<State> {
+	uint8_t registers[18]{};
+	uint8_t dummy_register = 0;
+	int selected_register = 0;
+	uint8_t status = 0;
+
+	// Counters.
+	uint8_t character_counter = 0, line_counter = 0;
+	bool character_is_visible = false, line_is_visible = false;
+	int hsync_counter = 0, vsync_counter = 0;
+	bool is_in_adjustment_period = false;
+	uint16_t line_address = 0, end_of_line_address = 0;
+	unsigned int character_is_visible_shifter = 0;
+	bool is_cursor_line = false;
+
+	// Bus state.
+	bool display_enable = false, hsync = false, vsync = false, cursor = false;
+	uint16_t refresh_address = 0, row_address = 0;
+	int field_count = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(registers);
+			DeclareField(dummy_register);
+			DeclareField(selected_register);
+			DeclareField(status);
+			DeclareField(character_counter);
+			DeclareField(line_counter);
+			DeclareField(character_is_visible);
+			DeclareField(line_is_visible);
+			DeclareField(hsync_counter);
+			DeclareField(vsync_counter);
+			DeclareField(is_in_adjustment_period);
+			DeclareField(line_address);
+			DeclareField(end_of_line_address);
+			DeclareField(character_is_visible_shifter);
+			DeclareField(is_cursor_line);
+			DeclareField(display_enable);
+			DeclareField(hsync);
+			DeclareField(vsync);
+			DeclareField(cursor);
+			DeclareField(refresh_address);
+			DeclareField(row_address);
+			DeclareField(field_count);
+		}
+	}
+
+	template <typename CRTC> State(const CRTC &source) : State() {
+		std::copy(std::begin(source.registers_), std::end(source.registers_), std::begin(registers));
+		dummy_register = source.dummy_register_;
+		selected_register = source.selected_register_;
+		status = source.status_;
+
+		character_counter = source.character_counter_;
+		line_counter = source.line_counter_;
+		character_is_visible = source.character_is_visible_;
+		line_is_visible = source.line_is_visible_;
+		hsync_counter = source.hsync_counter_;
+		vsync_counter = source.vsync_counter_;
+		is_in_adjustment_period = source.is_in_adjustment_period_;
+		line_address = source.line_address_;
+		end_of_line_address = source.end_of_line_address_;
+		character_is_visible_shifter = source.character_is_visible_shifter_;
+		is_cursor_line = source.is_cursor_line_;
+
+		display_enable = source.bus_state_.display_enable;
+		hsync = source.bus_state_.hsync;
+		vsync = source.bus_state_.vsync;
+		cursor = source.bus_state_.cursor;
+		refresh_address = source.bus_state_.refresh_address;
+		row_address = source.bus_state_.row_address;
+		field_count = source.bus_state_.field_count;
+	}
+
+	template <typename CRTC> void apply(CRTC &target) const {
+		// Replay register writes to reestablish the derived layout, then
+		// restore the read-only registers directly.
+		for(uint8_t c = 0; c < 16; c++) {
+			target.select_register(c);
+			target.set_register(registers[c]);
+		}
+		std::copy(std::begin(registers), std::end(registers), std::begin(target.registers_));
+		target.dummy_register_ = dummy_register;
+		target.selected_register_ = selected_register;
+		target.status_ = status;
+
+		target.character_counter_ = character_counter;
+		target.line_counter_ = line_counter;
+		target.character_is_visible_ = character_is_visible;
+		target.line_is_visible_ = line_is_visible;
+		target.hsync_counter_ = hsync_counter;
+		target.vsync_counter_ = vsync_counter;
+		target.is_in_adjustment_period_ = is_in_adjustment_period;
+		target.line_address_ = line_address;
+		target.end_of_line_address_ = end_of_line_address;
+		target.character_is_visible_shifter_ = character_is_visible_shifter;
+		target.is_cursor_line_ = is_cursor_line;
+
+		target.bus_state_.display_enable = display_enable;
+		target.bus_state_.hsync = hsync;
+		target.bus_state_.vsync = vsync;
+		target.bus_state_.cursor = cursor;
+		target.bus_state_.refresh_address = refresh_address;
+		target.bus_state_.row_address = row_address;
+		target.bus_state_.field_count = field_count;
+	}
 };
 
 }
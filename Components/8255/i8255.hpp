@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "../../Reflection/Struct.hpp"
+
 #include <cstdint>
 
 namespace Intel::i8255 {
@@ -84,6 +86,32 @@ template <class T> class i8255 {
 		uint8_t control_;
 		uint8_t outputs_[3];
 		T &port_handler_;
+
+		friend struct State;
+};
+
+struct State: public Reflection::StructImpl<State> {
+	uint8_t control = 0;
+	uint8_t outputs[3]{};
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(control);
+			DeclareField(outputs);
+		}
+	}
+
+	template <typename i8255> State(const i8255 &source) : State() {
+		control = source.control_;
+		for(int c = 0; c < 3; c++) outputs[c] = source.outputs_[c];
+	}
+
+	/// Restores this state to @c target, reposting all current outputs to its port handler.
+	template <typename i8255> void apply(i8255 &target) const {
+		target.control_ = control;
+		for(int c = 0; c < 3; c++) target.outputs_[c] = outputs[c];
+		target.update_outputs();
+	}
 };
 
 }
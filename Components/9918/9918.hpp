@@ -10,8 +10,10 @@
 
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 
 #include <cstdint>
+#include <vector>
 
 namespace TI::TMS {
 
@@ -123,6 +125,47 @@ template <Personality personality> class TMS9918: private Base<personality> {
 			@returns @c true if the interrupt line is currently active; @c false otherwise.
 		*/
 		bool get_interrupt_line() const;
+
+	private:
+		friend struct State;
+};
+
+/*!
+	Captures the programmer-visible state of a TMS or descendant: registers, RAM and
+	raster position. Yamaha commands that are in progress are not captured; they
+	are stopped upon restore.
+*/
+struct State: public Reflection::StructImpl<State> {
+	uint8_t registers[64]{};
+	std::vector<uint8_t> ram;
+
+	uint8_t status = 0;
+	uint32_t ram_pointer = 0;
+	uint8_t read_ahead_buffer = 0;
+	bool write_phase = false;
+	uint8_t low_write = 0;
+
+	uint8_t line_interrupt_target = 0xff;
+	uint8_t line_interrupt_counter = 0;
+	bool line_interrupt_pending = false;
+	int latched_column = 0;
+	int row = 0, column = 0;
+
+	// Yamaha extensions.
+	std::vector<uint8_t> expansion_ram;
+	uint32_t palette[16]{};
+	uint8_t palette_entry = 0;
+	bool palette_write_phase = false;
+	uint8_t new_colour = 0;
+	int indirect_register = 0;
+
+	// Sega extensions.
+	uint32_t colour_ram[32]{};
+	bool cram_is_selected = false;
+
+	State();
+	template <Personality personality> State(const TMS9918<personality> &);
+	template <Personality personality> void apply(TMS9918<personality> &) const;
 };
 
 }
@@ -8,9 +8,11 @@
 
 #include "../9918.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cstdlib>
+#include <iterator>
 #include "../../../Outputs/Log.hpp"
 
 using namespace TI::TMS;
@@ -725,6 +727,7 @@ void Base<personality>::commit_register(int reg, uint8_t value) {
 	} else {
 		reg &= 0x7;
 	}
+	registers_[size_t(reg)] = value;
 
 	//
 	// Generic TMS functionality.
@@ -1362,6 +1365,134 @@ void TMS9918<personality>::latch_horizontal_counter() {
 	this->latched_column_ = this->fetch_pointer_.column;
 }
 
+// MARK: - State.
+
+State::State() {
+	if(needs_declare()) {
+		DeclareField(registers);
+		DeclareField(ram);
+		DeclareField(status);
+		DeclareField(ram_pointer);
+		DeclareField(read_ahead_buffer);
+		DeclareField(write_phase);
+		DeclareField(low_write);
+		DeclareField(line_interrupt_target);
+		DeclareField(line_interrupt_counter);
+		DeclareField(line_interrupt_pending);
+		DeclareField(latched_column);
+		DeclareField(row);
+		DeclareField(column);
+		DeclareField(expansion_ram);
+		DeclareField(palette);
+		DeclareField(palette_entry);
+		DeclareField(palette_write_phase);
+		DeclareField(new_colour);
+		DeclareField(indirect_register);
+		DeclareField(colour_ram);
+		DeclareField(cram_is_selected);
+	}
+}
+
+template <Personality personality>
+State::State(const TMS9918<personality> &source) : State() {
+	const Base<personality> &base = source;
+
+	std::copy(base.registers_.begin(), base.registers_.end(), std::begin(registers));
+	ram.assign(base.ram_.begin(), base.ram_.end());
+
+	status = base.status_;
+	ram_pointer = base.ram_pointer_;
+	read_ahead_buffer = base.read_ahead_buffer_;
+	write_phase = base.write_phase_;
+	low_write = base.low_write_;
+
+	line_interrupt_target = base.line_interrupt_target_;
+	line_interrupt_counter = base.line_interrupt_counter_;
+	line_interrupt_pending = base.line_interrupt_pending_;
+	latched_column = base.latched_column_;
+	row = base.fetch_pointer_.row;
+	column = base.fetch_pointer_.column;
+
+	if constexpr (is_yamaha_vdp(personality)) {
+		expansion_ram.assign(base.expansion_ram_.begin(), base.expansion_ram_.end());
+		std::copy(base.palette_.begin(), base.palette_.end(), std::begin(palette));
+		palette_entry = base.palette_entry_;
+		palette_write_phase = base.palette_write_phase_;
+		new_colour = base.new_colour_;
+		indirect_register = base.indirect_register_;
+	}
+
+	if constexpr (is_sega_vdp(personality)) {
+		std::copy(std::begin(base.colour_ram_), std::end(base.colour_ram_), std::begin(colour_ram));
+		cram_is_selected = base.cram_is_selected_;
+	}
+}
+
+template <Personality personality>
+void State::apply(TMS9918<personality> &target) const {
+	Base<personality> &base = target;
+
+	// Reestablish palette first, so that register 7 can update the Yamaha's background palette.
+	if constexpr (is_yamaha_vdp(personality)) {
+		std::copy(std::begin(palette), std::end(palette), base.palette_.begin());
+		std::copy(std::begin(palette), std::end(palette), base.background_palette_.begin());
+	}
+
+	// Replay all register writes, substituting a STOP for any Yamaha command.
+	constexpr int register_count = is_yamaha_vdp(personality) ? 47 : (is_sega_vdp(personality) ? 11 : 8);
+	for(int c = 0; c < register_count; c++) {
+		base.commit_register(c, (is_yamaha_vdp(personality) && c == 46) ? 0 : registers[c]);
+	}
+
+	// The line interrupt target has a non-zero reset value, so may not be reflected in registers.
+	base.line_interrupt_target_ = line_interrupt_target;
+
+	// Run forward until the raster position is as captured; this is never less than a
+	// full frame, so that all line buffers are repopulated.
+	constexpr int CyclesPerLine = LineLayout<personality>::CyclesPerLine;
+	const int frame_length = CyclesPerLine * base.mode_timing_.total_lines;
+	const int current = base.fetch_pointer_.row * CyclesPerLine + base.fetch_pointer_.column;
+	const int captured = row * CyclesPerLine + column;
+	target.run_for(base.clock_converter_.half_cycles_before_internal_cycles(
+		frame_length + (captured - current + frame_length) % frame_length
+	));
+
+	// Restore memory and all other state.
+	std::copy(ram.begin(), ram.begin() + ptrdiff_t(std::min(ram.size(), base.ram_.size())), base.ram_.begin());
+	base.status_ = status;
+	base.ram_pointer_ = typename Base<personality>::AddressT(ram_pointer);
+	base.read_ahead_buffer_ = read_ahead_buffer;
+	base.queued_access_ = MemoryAccess::None;
+	base.write_phase_ = write_phase;
+	base.low_write_ = low_write;
+
+	base.line_interrupt_counter_ = line_interrupt_counter;
+	base.line_interrupt_pending_ = line_interrupt_pending;
+	base.latched_column_ = latched_column;
+
+	if constexpr (is_yamaha_vdp(personality)) {
+		std::copy(expansion_ram.begin(), expansion_ram.begin() + ptrdiff_t(std::min(expansion_ram.size(), base.expansion_ram_.size())), base.expansion_ram_.begin());
+		base.palette_entry_ = palette_entry;
+		base.palette_write_phase_ = palette_write_phase;
+		base.new_colour_ = new_colour;
+		base.indirect_register_ = indirect_register;
+	}
+
+	if constexpr (is_sega_vdp(personality)) {
+		std::copy(std::begin(colour_ram), std::end(colour_ram), std::begin(base.colour_ram_));
+		base.cram_is_selected_ = cram_is_selected;
+	}
+}
+
+template State::State(const TMS9918<Personality::TMS9918A> &);
+template State::State(const TMS9918<Personality::V9938> &);
+template State::State(const TMS9918<Personality::SMSVDP> &);
+template State::State(const TMS9918<Personality::SMS2VDP> &);
+template void State::apply(TMS9918<Personality::TMS9918A> &) const;
+template void State::apply(TMS9918<Personality::V9938> &) const;
+template void State::apply(TMS9918<Personality::SMSVDP> &) const;
+template void State::apply(TMS9918<Personality::SMS2VDP> &) const;
+
 template class TI::TMS::TMS9918<Personality::TMS9918A>;
 template class TI::TMS::TMS9918<Personality::V9938>;
 //template class TI::TMS::TMS9918<Personality::V9958>;
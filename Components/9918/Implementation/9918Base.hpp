@@ -110,6 +110,9 @@ template <Personality personality> struct Base: public Storage<personality> {
 	// The main status register.
 	uint8_t status_ = 0;
 
+	// The most recent value written to each register.
+	std::array<uint8_t, 64> registers_{};
+
 	// Current state of programmer input.
 	bool write_phase_ = false;	// Determines whether the VDP is expecting the low or high byte of a write.
 	uint8_t low_write_ = 0;		// Buffers the low byte of a write.
@@ -9,6 +9,7 @@
 #include <cmath>
 
 #include "AY38910.hpp"
+#include "../../SignalProcessing/BandLimitedSteps.hpp"
 
 //namespace GI {
 //namespace AY38910 {
@@ -123,6 +124,23 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 	}
 
 	while(c < number_of_samples) {
+		advance();
+
+		for(int ic = 0; ic < 4 && c < number_of_samples; ic++) {
+			if constexpr (is_stereo) {
+				reinterpret_cast<uint32_t *>(target)[c] = output_volume_;
+			} else {
+				target[c] = int16_t(output_volume_);
+			}
+			c++;
+			master_divider_++;
+		}
+	}
+
+	master_divider_ &= 3;
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::advance() {
 #define step_channel(c) \
 	if(tone_counters_[c]) tone_counters_[c]--;\
 	else {\
@@ -130,46 +148,82 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 		tone_counters_[c] = tone_periods_[c] << 1;\
 	}
 
-		// Update the tone channels.
-		step_channel(0);
-		step_channel(1);
-		step_channel(2);
+	// Update the tone channels.
+	step_channel(0);
+	step_channel(1);
+	step_channel(2);
 
 #undef step_channel
 
-		// Update the noise generator. This recomputes the new bit repeatedly but harmlessly, only shifting
-		// it into the official 17 upon divider underflow.
-		if(noise_counter_) noise_counter_--;
-		else {
-			noise_counter_ = noise_period_ << 1;	// To cover the double resolution of envelopes.
-			noise_output_ ^= noise_shift_register_&1;
-			noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
-			noise_shift_register_ >>= 1;
-		}
+	// Update the noise generator. This recomputes the new bit repeatedly but harmlessly, only shifting
+	// it into the official 17 upon divider underflow.
+	if(noise_counter_) noise_counter_--;
+	else {
+		noise_counter_ = noise_period_ << 1;	// To cover the double resolution of envelopes.
+		noise_output_ ^= noise_shift_register_&1;
+		noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
+		noise_shift_register_ >>= 1;
+	}
 
-		// Update the envelope generator. Table based for pattern lookup, with a 'refill' step: a way of
-		// implementing non-repeating patterns by locking them to the final table position.
-		if(envelope_divider_) envelope_divider_--;
-		else {
-			envelope_divider_ = envelope_period_;
-			envelope_position_ ++;
-			if(envelope_position_ == 64) envelope_position_ = envelope_overflow_masks_[output_registers_[13]];
-		}
+	// Update the envelope generator. Table based for pattern lookup, with a 'refill' step: a way of
+	// implementing non-repeating patterns by locking them to the final table position.
+	if(envelope_divider_) envelope_divider_--;
+	else {
+		envelope_divider_ = envelope_period_;
+		envelope_position_ ++;
+		if(envelope_position_ == 64) envelope_position_ = envelope_overflow_masks_[output_registers_[13]];
+	}
+
+	evaluate_output_volume();
+}
 
-		evaluate_output_volume();
+template <bool is_stereo> template <typename TargetT> void AY38910<is_stereo>::get_steps(std::size_t number_of_samples, TargetT &target) {
+	// Post anything that has changed since the last call.
+	post_step(0, target);
 
-		for(int ic = 0; ic < 4 && c < number_of_samples; ic++) {
-			if constexpr (is_stereo) {
-				reinterpret_cast<uint32_t *>(target)[c] = output_volume_;
-			} else {
-				target[c] = int16_t(output_volume_);
-			}
-			c++;
-			master_divider_++;
-		}
+	// Complete the current tick, if it's already underway.
+	std::size_t c = std::size_t(4 - (master_divider_ & 3)) & 3;
+	if(c >= number_of_samples) {
+		master_divider_ = int(std::size_t(master_divider_) + number_of_samples) & 3;
+		return;
 	}
 
-	master_divider_ &= 3;
+	while(true) {
+		// Output can change only when a counter expires, so skip directly to the next tick in which one does.
+		const std::size_t ticks = (number_of_samples - c + 3) >> 2;
+		const std::size_t quiet_ticks = std::min(
+			ticks,
+			std::size_t(std::min({tone_counters_[0], tone_counters_[1], tone_counters_[2], noise_counter_, envelope_divider_}))
+		);
+		tone_counters_[0] -= int(quiet_ticks);
+		tone_counters_[1] -= int(quiet_ticks);
+		tone_counters_[2] -= int(quiet_ticks);
+		noise_counter_ -= int(quiet_ticks);
+		envelope_divider_ -= int(quiet_ticks);
+		c += quiet_ticks << 2;
+		if(quiet_ticks == ticks) break;
+
+		advance();
+		post_step(c, target);
+		c += 4;
+		if(c >= number_of_samples) break;
+	}
+
+	// The final tick may run beyond the end of this call.
+	master_divider_ = int(4 - (c - number_of_samples)) & 3;
+}
+
+template <bool is_stereo> template <typename TargetT> void AY38910<is_stereo>::post_step(std::size_t offset, TargetT &target) {
+	if(output_volume_ == posted_volume_) return;
+
+	if constexpr (is_stereo) {
+		const int16_t *const output_volumes = reinterpret_cast<const int16_t *>(&output_volume_);
+		const int16_t *const posted_volumes = reinterpret_cast<const int16_t *>(&posted_volume_);
+		target.add_step(offset, int16_t(output_volumes[0] - posted_volumes[0]), int16_t(output_volumes[1] - posted_volumes[1]));
+	} else {
+		target.add_step(offset, int16_t(int16_t(output_volume_) - int16_t(posted_volume_)));
+	}
+	posted_volume_ = output_volume_;
 }
 
 template <bool is_stereo> void AY38910<is_stereo>::evaluate_output_volume() {
@@ -400,3 +454,8 @@ template <bool is_stereo> void AY38910<is_stereo>::update_bus() {
 // Ensure both mono and stereo versions of the AY are built.
 template class GI::AY38910::AY38910<true>;
 template class GI::AY38910::AY38910<false>;
+
+// Build steps for the targets used by speakers: a mono AY may be mixed into mono or stereo output.
+template void GI::AY38910::AY38910<false>::get_steps(std::size_t, SignalProcessing::BandLimitedSteps<1> &);
+template void GI::AY38910::AY38910<false>::get_steps(std::size_t, SignalProcessing::BandLimitedSteps<2> &);
+template void GI::AY38910::AY38910<true>::get_steps(std::size_t, SignalProcessing::BandLimitedSteps<2> &);
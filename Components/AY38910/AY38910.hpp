@@ -13,6 +13,9 @@
 
 #include "../../Reflection/Struct.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace GI::AY38910 {
 
 /*!
@@ -107,9 +110,11 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 
 		// to satisfy ::Outputs::Speaker (included via ::Outputs::Filter.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		template <typename TargetT> void get_steps(std::size_t number_of_samples, TargetT &target);
 		bool is_zero_level() const;
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return is_stereo; }
+		static constexpr bool get_supports_steps() { return true; }
 
 	private:
 		Concurrency::AsyncTaskQueue<false> &task_queue_;
@@ -151,6 +156,13 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 		uint8_t data_input_, data_output_;
 
 		uint32_t output_volume_;
+		uint32_t posted_volume_ = 0;
+
+		/// Performs one tick of the tone, noise and envelope generators, then updates output volume.
+		void advance();
+
+		/// Posts to @c target any change in output volume since the last step posted.
+		template <typename TargetT> void post_step(std::size_t offset, TargetT &target);
 
 		void update_bus();
 		PortHandler *port_handler_ = nullptr;
@@ -207,7 +219,12 @@ struct State: public Reflection::StructImpl<State> {
 		}
 	}
 
-	template <typename AY> void apply(AY &target) {
+	template <typename AY> State(const AY &source) : State() {
+		std::copy(std::begin(source.registers_), std::end(source.registers_), std::begin(registers));
+		selected_register = uint8_t(source.selected_register_);
+	}
+
+	template <typename AY> void apply(AY &target) const {
 		// Establish emulator-thread state
 		for(uint8_t c = 0; c < 16; c++) {
 			target.select_register(c);
@@ -7,6 +7,7 @@
 //
 
 #include "AudioToggle.hpp"
+#include "../../SignalProcessing/BandLimitedSteps.hpp"
 
 using namespace Audio;
 
@@ -25,6 +26,19 @@ void Toggle::set_sample_volume_range(std::int16_t range) {
 
 void Toggle::skip_samples(std::size_t) {}
 
+bool Toggle::is_zero_level() const {
+	return !level_;
+}
+
+template <typename TargetT> void Toggle::get_steps(std::size_t, TargetT &target) {
+	// Output changes only between calls.
+	target.add_step(0, int16_t(level_ - posted_level_));
+	posted_level_ = level_;
+}
+
+template void Toggle::get_steps(std::size_t, SignalProcessing::BandLimitedSteps<1> &);
+template void Toggle::get_steps(std::size_t, SignalProcessing::BandLimitedSteps<2> &);
+
 void Toggle::set_output(bool enabled) {
 	if(is_enabled_ == enabled) return;
 	is_enabled_ = enabled;
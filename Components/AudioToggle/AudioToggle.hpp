@@ -23,6 +23,9 @@ class Toggle: public Outputs::Speaker::SampleSource {
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
 		void set_sample_volume_range(std::int16_t range);
 		void skip_samples(const std::size_t number_of_samples);
+		bool is_zero_level() const;
+		template <typename TargetT> void get_steps(std::size_t number_of_samples, TargetT &target);
+		static constexpr bool get_supports_steps() { return true; }
 
 		void set_output(bool enabled);
 		bool get_output() const;
@@ -34,6 +37,7 @@ class Toggle: public Outputs::Speaker::SampleSource {
 
 		// Accessed on the audio thread.
 		int16_t level_ = 0, volume_ = 0;
+		int16_t posted_level_ = 0;
 };
 
 }
@@ -7,7 +7,9 @@
 //
 
 #include "SN76489.hpp"
+#include "../../SignalProcessing/BandLimitedSteps.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -108,54 +110,108 @@ void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 
 	while(c < number_of_samples) {
-		bool did_flip = false;
+		advance();
 
-#define step_channel(x, s) \
-		if(channels_[x].counter) channels_[x].counter--;\
-		else {\
-			channels_[x].level ^= 1;\
-			channels_[x].counter = channels_[x].divider;\
-			s;\
+		for(int ic = 0; ic < master_divider_period_ && c < number_of_samples; ++ic) {
+			target[c] = output_volume_;
+			c++;
+			master_divider_++;
 		}
+	}
+
+	master_divider_ &= (master_divider_period_ - 1);
+}
 
-		step_channel(0, /**/);
-		step_channel(1, /**/);
-		step_channel(2, did_flip = true);
+void SN76489::advance() {
+	bool did_flip = false;
+
+#define step_channel(x, s) \
+	if(channels_[x].counter) channels_[x].counter--;\
+	else {\
+		channels_[x].level ^= 1;\
+		channels_[x].counter = channels_[x].divider;\
+		s;\
+	}
+
+	step_channel(0, /**/);
+	step_channel(1, /**/);
+	step_channel(2, did_flip = true);
 
 #undef step_channel
 
-		if(channels_[3].divider != 0xffff) {
-			if(channels_[3].counter) channels_[3].counter--;
-			else {
-				did_flip = true;
-				channels_[3].counter = channels_[3].divider;
-			}
+	if(channels_[3].divider != 0xffff) {
+		if(channels_[3].counter) channels_[3].counter--;
+		else {
+			did_flip = true;
+			channels_[3].counter = channels_[3].divider;
 		}
+	}
 
-		if(did_flip) {
-			channels_[3].level = noise_shifter_ & 1;
-			int new_bit = channels_[3].level;
-			switch(noise_mode_) {
-				default: break;
-				case Noise15:
-					new_bit ^= (noise_shifter_ >> 1);
-				break;
-				case Noise16:
-					new_bit ^= (noise_shifter_ >> 3);
-				break;
-			}
-			noise_shifter_ >>= 1;
-			noise_shifter_ |= (new_bit & 1) << (shifter_is_16bit_ ? 15 : 14);
+	if(did_flip) {
+		channels_[3].level = noise_shifter_ & 1;
+		int new_bit = channels_[3].level;
+		switch(noise_mode_) {
+			default: break;
+			case Noise15:
+				new_bit ^= (noise_shifter_ >> 1);
+			break;
+			case Noise16:
+				new_bit ^= (noise_shifter_ >> 3);
+			break;
 		}
+		noise_shifter_ >>= 1;
+		noise_shifter_ |= (new_bit & 1) << (shifter_is_16bit_ ? 15 : 14);
+	}
 
-		evaluate_output_volume();
+	evaluate_output_volume();
+}
 
-		for(int ic = 0; ic < master_divider_period_ && c < number_of_samples; ++ic) {
-			target[c] = output_volume_;
-			c++;
-			master_divider_++;
+template <typename TargetT> void SN76489::get_steps(std::size_t number_of_samples, TargetT &target) {
+	const auto post_step = [&] (std::size_t offset) {
+		if(output_volume_ == posted_volume_) return;
+		target.add_step(offset, int16_t(output_volume_ - posted_volume_));
+		posted_volume_ = output_volume_;
+	};
+
+	// Post anything that has changed since the last call.
+	post_step(0);
+
+	// Complete the current tick, if it's already underway.
+	const std::size_t period = std::size_t(master_divider_period_);
+	std::size_t c = (period - std::size_t(master_divider_ & (master_divider_period_ - 1))) & (period - 1);
+	if(c >= number_of_samples) {
+		master_divider_ = int(std::size_t(master_divider_) + number_of_samples) & (master_divider_period_ - 1);
+		return;
+	}
+
+	while(true) {
+		// Output can change only when a counter expires, so skip directly to the next tick in which one does.
+		// Channel 3 doesn't count if it is tracking channel 2.
+		const std::size_t ticks = (number_of_samples - c + period - 1) / period;
+		uint16_t next_expiry = std::min({channels_[0].counter, channels_[1].counter, channels_[2].counter});
+		if(channels_[3].divider != 0xffff) {
+			next_expiry = std::min(next_expiry, channels_[3].counter);
+		}
+		const std::size_t quiet_ticks = std::min(ticks, std::size_t(next_expiry));
+
+		for(int channel = 0; channel < 3; channel++) {
+			channels_[channel].counter -= uint16_t(quiet_ticks);
+		}
+		if(channels_[3].divider != 0xffff) {
+			channels_[3].counter -= uint16_t(quiet_ticks);
 		}
+		c += quiet_ticks * period;
+		if(quiet_ticks == ticks) break;
+
+		advance();
+		post_step(c);
+		c += period;
+		if(c >= number_of_samples) break;
 	}
 
-	master_divider_ &= (master_divider_period_ - 1);
+	// The final tick may run beyond the end of this call.
+	master_divider_ = int(period - (c - number_of_samples)) & (master_divider_period_ - 1);
 }
+
+template void SN76489::get_steps(std::size_t, SignalProcessing::BandLimitedSteps<1> &);
+template void SN76489::get_steps(std::size_t, SignalProcessing::BandLimitedSteps<2> &);
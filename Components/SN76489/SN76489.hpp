@@ -29,15 +29,21 @@ class SN76489: public Outputs::Speaker::SampleSource {
 
 		// As per SampleSource.
 		void get_samples(std::size_t number_of_samples, std::int16_t *target);
+		template <typename TargetT> void get_steps(std::size_t number_of_samples, TargetT &target);
 		bool is_zero_level() const;
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
+		static constexpr bool get_supports_steps() { return true; }
 
 	private:
 		int master_divider_ = 0;
 		int master_divider_period_ = 16;
 		int16_t output_volume_ = 0;
+		int16_t posted_volume_ = 0;
 		void evaluate_output_volume();
+
+		/// Performs one tick of all channels, then updates output volume.
+		void advance();
 		int volumes_[16];
 
 		Concurrency::AsyncTaskQueue<false> &task_queue_;
@@ -0,0 +1,209 @@
+//
+//  SPSCRing.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Concurrency {
+
+/*!
+	A fixed-capacity ring buffer for exactly one producer thread and one consumer thread.
+
+	All operations are wait-free: neither side ever blocks the other, so this is suitable for
+	feeding a realtime thread such as an audio callback.
+
+	Writes that don't fit are truncated, and reads of more than is available are short. Each
+	occurrence is counted, as an overrun or an underrun respectively.
+*/
+template <typename T> class SPSCRing {
+	public:
+		/// Constructs a ring able to hold at least @c capacity elements.
+		SPSCRing(size_t capacity) {
+			size_t size = 1;
+			while(size < capacity) size <<= 1;
+			buffer_.resize(size);
+			mask_ = size - 1;
+		}
+
+		// MARK: - Producer.
+
+		/*!
+			Enqueues up to @c count elements from @c source.
+
+			@returns The number of elements enqueued; if this is fewer than @c count then an overrun is recorded.
+		*/
+		size_t write(const T *source, size_t count) {
+			const size_t write_index = write_index_.load(std::memory_order_relaxed);
+			const size_t read_index = read_index_.load(std::memory_order_acquire);
+			const size_t length = std::min(count, buffer_.size() - (write_index - read_index));
+
+			const size_t offset = write_index & mask_;
+			const size_t first_length = std::min(length, buffer_.size() - offset);
+			std::copy(source, source + first_length, &buffer_[offset]);
+			std::copy(source + first_length, source + length, buffer_.begin());
+			write_index_.store(write_index + length, std::memory_order_release);
+
+			if(length < count) overruns_.fetch_add(1, std::memory_order_relaxed);
+			return length;
+		}
+
+		// MARK: - Consumer.
+
+		/*!
+			Dequeues up to @c count elements to @c target.
+
+			@returns The number of elements dequeued; if this is fewer than @c count then an underrun is recorded.
+		*/
+		size_t read(T *target, size_t count) {
+			const size_t read_index = read_index_.load(std::memory_order_relaxed);
+			const size_t write_index = write_index_.load(std::memory_order_acquire);
+			const size_t length = std::min(count, write_index - read_index);
+
+			const size_t offset = read_index & mask_;
+			const size_t first_length = std::min(length, buffer_.size() - offset);
+			std::copy(&buffer_[offset], &buffer_[offset] + first_length, target);
+			std::copy(buffer_.begin(), buffer_.begin() + ptrdiff_t(length - first_length), target + first_length);
+			read_index_.store(read_index + length, std::memory_order_release);
+
+			if(length < count) underruns_.fetch_add(1, std::memory_order_relaxed);
+			return length;
+		}
+
+		/*!
+			Dequeues and discards up to @c count elements.
+
+			@returns The number of elements discarded.
+		*/
+		size_t discard(size_t count) {
+			const size_t read_index = read_index_.load(std::memory_order_relaxed);
+			const size_t write_index = write_index_.load(std::memory_order_acquire);
+			const size_t length = std::min(count, write_index - read_index);
+
+			read_index_.store(read_index + length, std::memory_order_release);
+			return length;
+		}
+
+		// MARK: - Either thread.
+
+		/// @returns The number of elements currently enqueued; this is exact only if called from the producer or consumer while the other is idle.
+		size_t size() const {
+			return write_index_.load(std::memory_order_acquire) - read_index_.load(std::memory_order_acquire);
+		}
+
+		/// @returns The maximum number of elements that can be enqueued.
+		size_t capacity() const {
+			return buffer_.size();
+		}
+
+		/// @returns The number of writes so far that didn't fit.
+		size_t overruns() const {
+			return overruns_.load(std::memory_order_relaxed);
+		}
+
+		/// @returns The number of reads so far that couldn't be fully satisfied.
+		size_t underruns() const {
+			return underruns_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::vector<T> buffer_;
+		size_t mask_;
+
+		// Indices increase monotonically and are masked only upon use; each is written
+		// by one side only so is kept on its own cache line.
+		alignas(64) std::atomic<size_t> write_index_{0};
+		alignas(64) std::atomic<size_t> read_index_{0};
+
+		std::atomic<size_t> overruns_{0};
+		std::atomic<size_t> underruns_{0};
+};
+
+/*!
+	Extends @c SPSCRing for a consumer that periodically requires a fixed quantity of data, such
+	as an audio callback, seeking to keep latency as low as possible without underrunning.
+
+	Latency is held near a target quantity of buffered data. That target rises whenever an underrun
+	occurs and decays back towards the minimum during periods without one. Anything buffered beyond the
+	target plus the largest single write is discarded, oldest first, so that latency can't accumulate.
+*/
+template <typename T> class AdaptiveLatencyRing: public SPSCRing<T> {
+	public:
+		/*!
+			@param capacity The maximum number of elements that can be buffered.
+			@param minimum_latency The lowest number of elements to target.
+			@param alignment The granularity at which elements may be discarded, e.g. the number of channels
+				in interleaved audio.
+		*/
+		AdaptiveLatencyRing(size_t capacity, size_t minimum_latency, size_t alignment = 1) :
+			SPSCRing<T>(capacity),
+			alignment_(std::max(alignment, size_t(1))),
+			minimum_latency_(align(minimum_latency)),
+			target_latency_(minimum_latency_) {}
+
+		// MARK: - Producer.
+
+		/// Enqueues up to @c count elements from @c source, noting the size of the write for latency targeting.
+		size_t write(const T *source, size_t count) {
+			if(count > largest_write_.load(std::memory_order_relaxed)) {
+				largest_write_.store(count, std::memory_order_relaxed);
+			}
+			return SPSCRing<T>::write(source, count);
+		}
+
+		// MARK: - Consumer.
+
+		/*!
+			Populates all @c count elements of @c target, filling with @c T() in the event of an underrun,
+			then adjusts the latency target and discards any excess.
+		*/
+		void read_all(T *target, size_t count) {
+			const size_t length = SPSCRing<T>::read(target, count);
+			std::fill(target + length, target + count, T());
+
+			const size_t maximum_target = align(this->capacity() / 2);
+			if(length < count) {
+				target_latency_ = std::min(maximum_target, target_latency_ + align(count / 2));
+				reads_since_underrun_ = 0;
+			} else if(++reads_since_underrun_ == DecayPeriod) {
+				target_latency_ -= align((target_latency_ - minimum_latency_) / 8);
+				reads_since_underrun_ = 0;
+			}
+
+			const size_t limit = target_latency_ + largest_write_.load(std::memory_order_relaxed);
+			const size_t buffered = this->size();
+			if(buffered > limit) {
+				this->discard(align(buffered - limit));
+			}
+		}
+
+		/// @returns The current latency target, in elements. Should be called only by the consumer.
+		size_t target_latency() const {
+			return target_latency_;
+		}
+
+	private:
+		static constexpr int DecayPeriod = 64;
+
+		const size_t alignment_;
+		const size_t minimum_latency_;
+
+		std::atomic<size_t> largest_write_{0};
+
+		size_t target_latency_;
+		int reads_since_underrun_ = 0;
+
+		size_t align(size_t value) const {
+			return value - (value % alignment_);
+		}
+};
+
+}
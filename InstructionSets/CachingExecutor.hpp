@@ -10,13 +10,13 @@
 
 #include "../Numeric/Sizes.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <limits>
 #include <list>
-#include <map>
-#include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace InstructionSet {
 
@@ -46,20 +46,32 @@ template <
 > class CachingExecutor {
 	public:
 		using Performer = void (Executor::*)();
-		using PerformerIndex = typename MinIntTypeValue<max_performer_count>::type;
+		using PerformerIndex = typename MinIntTypeValue<max_performer_count + 1>::type;
 		using ProgramCounterType = typename MinIntTypeValue<max_address>::type;
 
+		CachingExecutor() {
+			performers_[EndOfAddressSpace] = &CachingExecutor::run_off_end;
+		}
+
 		// MARK: - Parser call-ins.
 
-		void announce_overflow(ProgramCounterType) {
-			/*
-				Should be impossible for now; this is intended to provide information
-				when page caching.
-			*/
+		void announce_overflow(ProgramCounterType address) {
+			// Parsing reached the end of a page without finding an unconditional branch;
+			// note where to continue from.
+			continuation_ = address;
+			has_continuation_ = true;
 		}
-		void announce_instruction(ProgramCounterType, InstructionType instruction) {
+		void announce_instruction(ProgramCounterType address, InstructionType instruction) {
+			Page &page = *translation_page_;
+
+			// Record an entry point if this instruction is within the page being translated;
+			// instructions in subsequent pages will be picked up from their own pages.
+			if(page_of(address) == page.page_number) {
+				page.entry_points.emplace(address, page.actions.size());
+			}
+
 			// Dutifully map the instruction to a performer and keep it.
-			program_.push_back(static_cast<Executor *>(this)->action_for(instruction));
+			page.actions.push_back(static_cast<Executor *>(this)->action_for(instruction));
 
 			if constexpr (retain_instructions) {
 				// TODO.
@@ -71,7 +83,9 @@ template <
 		// Storage for the statically-allocated list of performers. It's a bit more
 		// work for executors to fill this array, but subsequently performers can be
 		// indexed by array position, which is a lot more compact than a generic pointer.
-		std::array<Performer, max_performer_count+1> performers_;
+		//
+		// The final entry is reserved for use by the CachingExecutor itself.
+		std::array<Performer, max_performer_count+2> performers_;
 		ProgramCounterType program_counter_;
 
 		/*!
@@ -84,18 +98,18 @@ template <
 			has_branched_ = true;
 			program_counter_ = address;
 
-			// Temporary implementation: just interpret.
-			program_.clear();
-			program_index_ = 0;
-			static_cast<Executor *>(this)->parse(address, ProgramCounterType(max_address));
-
-//			const auto page = find_page(address);
-//			const auto entry = page->entry_points.find(address);
-//			if(entry == page->entry_points.end()) {
-//				// Requested segment wasn't found; check whether it was
-//				// within the recently translated list and otherwise
-//				// translate it.
-//			}
+			Page *const page = find_page(address);
+			auto entry = page->entry_points.find(address);
+			if(entry == page->entry_points.end()) {
+				// Requested segment wasn't found; translate it.
+				translate(*page, address);
+				entry = page->entry_points.find(address);
+			}
+
+			program_ = page->actions.data();
+			program_index_ = entry->second;
+			program_page_ = page;
+			needs_retranslation_ = false;
 		}
 
 		/*!
@@ -105,16 +119,45 @@ template <
 		*/
 		void set_is_stopped(bool) {}
 
+		/*!
+			Should be called by a specific executor upon any write to @c address that might
+			modify code; any cached translations that include @c address are discarded.
+		*/
+		inline void invalidate(ProgramCounterType address) {
+			const auto page_number = page_of(address);
+			if(!source_counts_[page_number]) return;
+
+			for(size_t c = 0; c < allocated_pages_; c++) {
+				Page &page = pages_[c];
+				if(page.is_valid && page.page_number <= page_number && page.last_source_page >= page_number) {
+					release(page);
+				}
+			}
+		}
+
+		/*!
+			Discards all cached translations, e.g. after wholesale replacement of memory contents.
+		*/
+		void invalidate_all() {
+			for(size_t c = 0; c < allocated_pages_; c++) {
+				if(pages_[c].is_valid) release(pages_[c]);
+			}
+		}
+
 		/*!
 			Executes up to the next branch.
 		*/
 		void run_to_branch() {
+			retranslate_if_needed();
 			has_branched_ = false;
-			for(auto index: program_) {
-				const auto performer = performers_[index];
-				(static_cast<Executor *>(this)->*performer)();
-				if(has_branched_) break;
+			Executor *const executor = static_cast<Executor *>(this);
+			while(!has_branched_) {
+				const auto performer = performers_[program_[program_index_]];
+				++program_index_;
+
+				(executor->*performer)();
 			}
+			retranslate_if_needed();
 		}
 
 		/*!
@@ -124,6 +167,7 @@ template <
 		*/
 		void run_for(int duration) {
 			remaining_duration_ += duration;
+			retranslate_if_needed();
 
 			while(remaining_duration_ > 0) {
 				has_branched_ = false;
@@ -134,6 +178,7 @@ template <
 
 					(executor->*performer)();
 				}
+				retranslate_if_needed();
 			}
 		}
 
@@ -148,50 +193,178 @@ template <
 	private:
 		bool has_branched_ = false;
 		int remaining_duration_ = 0;
-		std::vector<PerformerIndex> program_;
+
+		// A performer that is appended to any translation that reaches the end of the address
+		// space without an unconditional branch; it continues execution from the start of the
+		// address space, or from wherever the program counter wraps to if max_address isn't
+		// one less than a power of two.
+		static constexpr PerformerIndex EndOfAddressSpace = PerformerIndex(max_performer_count + 1);
+		void run_off_end() {
+			set_program_counter(ProgramCounterType(program_counter_ & max_address));
+		}
+
+		// The program currently being executed, being a pointer into the actions
+		// of program_page_.
+		const PerformerIndex *program_ = nullptr;
 		size_t program_index_ = 0;
 
-		/* TODO: almost below here can be shoved off into an LRUCache object, or similar. */
+		// MARK: - Page cache.
+
+		// TODO: are 1kb pages always appropriate? Is 64 the correct amount to keep?
+		static constexpr int page_shift = 10;
+		static constexpr size_t max_cached_pages = 64;
+		static constexpr size_t page_count = size_t(max_address >> page_shift) + 1;
+
+		static constexpr ProgramCounterType page_of(ProgramCounterType address) {
+			return ProgramCounterType(address >> page_shift);
+		}
+
+		struct Page {
+			/// Indicates whether this page currently holds a translation.
+			bool is_valid = false;
+
+			/// The page number this page currently caches.
+			ProgramCounterType page_number = 0;
+
+			/// The final page from which any of @c actions were parsed; translations
+			/// run until an unconditional branch, so may extend beyond the end of this page.
+			ProgramCounterType last_source_page = 0;
 
-//		static constexpr size_t max_cached_pages = 64;
+			/// Maps from addresses within this page to the index within @c actions of the
+			/// performer for the instruction at that address.
+			std::unordered_map<ProgramCounterType, size_t> entry_points;
 
-//		struct Page {
-//			std::map<ProgramCounterType, PerformerIndex> entry_points;
+			/// The concatenation of all translations that begin within this page.
+			std::vector<PerformerIndex> actions;
 
-			// TODO: can I statically these two? Should I?
-//			std::vector<PerformerIndex> actions_;
-//			std::vector<typename std::enable_if<!std::is_same<InstructionType, void>::value, InstructionType>::type> instructions_;
-//		};
-//		std::array<Page, max_cached_pages> pages_;
+			/// This page's position within touched_pages_.
+			typename std::list<Page *>::iterator lru_position;
+
+			// TODO: retain instructions too, if retain_instructions is set.
+		};
+		std::array<Page, max_cached_pages> pages_;
+		size_t allocated_pages_ = 0;
 
 		// Maps from page numbers to pages.
-//		std::unordered_map<ProgramCounterType, Page *> cached_pages_;
+		std::array<Page *, page_count> cached_pages_{};
+
+		// Counts, for each page of the address space, the number of cached pages that include
+		// a translation from it; that's zero for the vast majority of writes, allowing invalidation
+		// to exit early.
+		std::array<uint8_t, page_count> source_counts_{};
 
-		// Maintains an LRU of recently-used pages in case of a need for reuse.
-//		std::list<ProgramCounterType> touched_pages_;
+		// Maintains an LRU of recently-used pages, most recent at the front.
+		std::list<Page *> touched_pages_;
+
+		// Translation state.
+		Page *translation_page_ = nullptr;
+		Page *program_page_ = nullptr;
+		bool has_continuation_ = false;
+		bool needs_retranslation_ = false;
+		ProgramCounterType continuation_ = 0;
 
 		/*!
 			Finds or creates the page that contains @c address.
 		*/
-/*		Page *find_page(ProgramCounterType address) {
-			// TODO: are 1kb pages always appropriate? Is 64 the correct amount to keep?
-			const auto page_address = ProgramCounterType(address >> 10);
+		Page *find_page(ProgramCounterType address) {
+			const auto page_number = page_of(address);
 
-			auto page = cached_pages_.find(page_address);
-			if(page == cached_pages_.end()) {
+			Page *page = cached_pages_[page_number];
+			if(!page) {
 				// Page wasn't found; either allocate a new one or
-				// reuse one that already exists.
-				if(cached_pages_.size() == max_cached_pages) {
+				// reuse the least-recently used.
+				if(allocated_pages_ < max_cached_pages) {
+					page = &pages_[allocated_pages_];
+					++allocated_pages_;
 
+					touched_pages_.push_front(page);
+					page->lru_position = touched_pages_.begin();
 				} else {
+					page = touched_pages_.back();
+					if(page->is_valid) release(*page);
 
+					touched_pages_.splice(touched_pages_.begin(), touched_pages_, page->lru_position);
 				}
-			} else {
+
+				page->is_valid = true;
+				page->page_number = page->last_source_page = page_number;
+				++source_counts_[page_number];
+				cached_pages_[page_number] = page;
+			} else if(page->lru_position != touched_pages_.begin()) {
 				// Page was found; LRU shuffle it.
+				touched_pages_.splice(touched_pages_.begin(), touched_pages_, page->lru_position);
+			}
+
+			return page;
+		}
+
+		/*!
+			Parses from @c address into @c page, continuing across page boundaries as necessary
+			until an unconditional branch is found.
+		*/
+		void translate(Page &page, ProgramCounterType address) {
+			translation_page_ = &page;
+
+			auto start = address;
+			auto bound = ProgramCounterType(std::min<uint64_t>(start | ((1 << page_shift) - 1), max_address));
+			while(true) {
+				has_continuation_ = false;
+				static_cast<Executor *>(this)->parse(start, bound);
+
+				// Stop if an unconditional branch was found.
+				if(!has_continuation_) break;
+
+				// If there's nowhere left to go, end with a jump back to the start of the
+				// address space. Any instruction that straddles the end is not supported.
+				if(bound == max_address) {
+					page.actions.push_back(EndOfAddressSpace);
+					break;
+				}
+
+				// Otherwise continue to the end of the following page. If the continuation
+				// is mid-instruction, that instruction straddles the two pages.
+				start = continuation_;
+				bound = ProgramCounterType(std::min<uint64_t>(bound + (1 << page_shift), max_address));
+
+				const auto bound_page = page_of(bound);
+				if(bound_page > page.last_source_page) {
+					page.last_source_page = bound_page;
+					++source_counts_[bound_page];
+				}
 			}
 
-			return nullptr;
-		}*/
+			translation_page_ = nullptr;
+		}
+
+		/*!
+			Discards the translations held by @c page.
+		*/
+		void release(Page &page) {
+			for(auto c = page.page_number; c <= page.last_source_page; c++) {
+				--source_counts_[c];
+			}
+			cached_pages_[page.page_number] = nullptr;
+
+			page.is_valid = false;
+			page.entry_points.clear();
+			page.actions.clear();	// Capacity is retained, so program_ remains safe to hold until the next branch.
+
+			touched_pages_.splice(touched_pages_.end(), touched_pages_, page.lru_position);
+
+			// If this is the page currently being executed from, exit the run loop
+			// after the current performer and reparse from the program counter.
+			if(&page == program_page_) {
+				has_branched_ = true;
+				needs_retranslation_ = true;
+				program_page_ = nullptr;
+			}
+		}
+
+		void retranslate_if_needed() {
+			if(needs_retranslation_) {
+				set_program_counter(program_counter_);
+			}
+		}
 };
 
 }
@@ -46,6 +46,7 @@ void Executor::set_rom(const std::vector<uint8_t> &rom) {
 	// Copy into place, and reset.
 	const auto length = std::min(size_t(0x1000), rom.size());
 	memcpy(&memory_[0x2000 - length], rom.data(), length);
+	invalidate_all();
 	reset();
 }
 
@@ -128,6 +129,7 @@ void Executor::write(uint16_t address, uint8_t value) {
 	// RAM writes are easy.
 	if(address < 0x60) {
 		memory_[address] = value;
+		invalidate(address);
 		return;
 	}
 
@@ -114,6 +114,10 @@ template<typename Target, bool include_entries_and_accesses> struct Parser {
 				start += next.first;
 			}
 		}
+
+		// The closing bound was reached without any terminating instruction; announce
+		// that so that the target can continue from here if desired.
+		target.announce_overflow(start);
 	}
 };
 
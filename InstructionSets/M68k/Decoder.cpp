@@ -1911,6 +1911,21 @@ Preinstruction Predecoder<model>::decodeF(uint16_t) {
 
 template <Model model>
 Preinstruction Predecoder<model>::decode(uint16_t instruction) {
+	static const struct Table {
+		Table() {
+			Predecoder<model> decoder;
+			for(int c = 0; c < 65536; c++) {
+				entries[c] = decoder.decode_uncached(uint16_t(c));
+			}
+		}
+		Preinstruction entries[65536];
+	} table;
+
+	return table.entries[instruction];
+}
+
+template <Model model>
+Preinstruction Predecoder<model>::decode_uncached(uint16_t instruction) {
 	// Divide first based on line.
 	switch(instruction & 0xf000) {
 		case 0x0000:	return decode0(instruction);
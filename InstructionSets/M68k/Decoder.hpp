@@ -27,9 +27,16 @@ namespace InstructionSet::M68k {
 */
 template <Model model> class Predecoder {
 	public:
+		/*!
+			@returns The preinstruction for @c instruction. All 65,536 possible results are
+			generated upon first use, making this a table lookup thereafter.
+		*/
 		Preinstruction decode(uint16_t instruction);
 
 	private:
+		// Performs a full decode of @c instruction; used to populate the table behind @c decode.
+		Preinstruction decode_uncached(uint16_t instruction);
+
 		// Page by page decoders; each gets a bit ad hoc so
 		// it is neater to separate them.
 		Preinstruction decode0(uint16_t instruction);
@@ -51,7 +51,7 @@ void Executor<model, BusHandler>::signal_bus_error(FunctionCode code, uint32_t a
 
 template <Model model, typename BusHandler>
 void Executor<model, BusHandler>::set_interrupt_level(int level) {
-	state_.interrupt_input_ = level;
+	state_.interrupt_input = level;
 	state_.stopped &= !state_.status.would_accept_interrupt(level);
 }
 
@@ -383,13 +383,15 @@ void Executor<model, BusHandler>::State::run(int &count) {
 	while(count--) {
 		// Check for a new interrupt.
 		if(status.would_accept_interrupt(interrupt_input)) {
-			const int vector = bus_handler_.acknowlege_interrupt(interrupt_input);
+			// Capture the level now; the bus handler may change the input during acknowledgement.
+			const int interrupt_level = interrupt_input;
+			const int vector = bus_handler_.acknowlege_interrupt(interrupt_level);
 			if(vector >= 0) {
 				raise_exception<false>(vector);
 			} else {
-				raise_exception<false>(Exception::InterruptAutovectorBase - 1 + interrupt_input);
+				raise_exception<false>(Exception::InterruptAutovectorBase - 1 + interrupt_level);
 			}
-			status.interrupt_level = interrupt_input;
+			status.interrupt_level = interrupt_level;
 		}
 
 		// Capture the trace bit, indicating whether to trace
@@ -17,7 +17,6 @@ constexpr DataSize operand_size(Operation r_operation) {
 		// complete the switch statement.
 		case Operation::Undefined:
 		case Operation::NOP:
-		case Operation::STOP:
 		case Operation::RESET:
 		case Operation::RTE:	case Operation::RTR:
 		case Operation::RTD:
@@ -57,6 +56,7 @@ constexpr DataSize operand_size(Operation r_operation) {
 		case Operation::SUBAw:	case Operation::SUBXw:
 		case Operation::MOVEw:	case Operation::MOVEAw:
 		case Operation::MOVESw:
+		case Operation::STOP:
 		case Operation::ORItoSR:
 		case Operation::ANDItoSR:
 		case Operation::EORItoSR:
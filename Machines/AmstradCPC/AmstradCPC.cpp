@@ -10,6 +10,7 @@
 
 #include "Keyboard.hpp"
 #include "FDC.hpp"
+#include "State.hpp"
 
 #include "../../Processors/Z80/Z80.hpp"
 
@@ -109,6 +110,8 @@ class InterruptTimer {
 		bool interrupt_request_ = false;
 		bool last_interrupt_request_ = false;
 		int timer_ = 0;
+
+		friend struct GateArrayState;
 };
 
 /*!
@@ -121,6 +124,7 @@ class AYDeferrer {
 		/// Constructs a new AY instance and sets its clock rate.
 		AYDeferrer() : ay_(GI::AY38910::Personality::AY38910, audio_queue_), speaker_(ay_) {
 			speaker_.set_input_rate(1000000);
+			speaker_.set_uses_band_limited_steps(true);
 			// Per the CPC Wiki:
 			// "A is output to the right, channel C is output left, and channel B is output to both left and right".
 			ay_.set_output_mixing(0.0, 0.5, 1.0, 1.0, 0.5, 0.0);
@@ -312,14 +316,7 @@ class CRTCBusHandler {
 			// Check for a trailing CRTC hsync; if one occurred then that's the trigger potentially to change modes.
 			if(!was_hsync_ && state.hsync) {
 				if(mode_ != next_mode_) {
-					mode_ = next_mode_;
-					switch(mode_) {
-						default:
-						case 0:		pixel_divider_ = 4;	break;
-						case 1:		pixel_divider_ = 2;	break;
-						case 2:		pixel_divider_ = 1;	break;
-					}
-					build_mode_table();
+					set_mode(next_mode_);
 				}
 			}
 
@@ -383,6 +380,17 @@ class CRTCBusHandler {
 		}
 
 	private:
+		void set_mode(int mode) {
+			mode_ = mode;
+			switch(mode_) {
+				default:
+				case 0:		pixel_divider_ = 4;	break;
+				case 1:		pixel_divider_ = 2;	break;
+				case 2:		pixel_divider_ = 1;	break;
+			}
+			build_mode_table();
+		}
+
 		void output_border(int length) {
 			assert(length >= 0);
 
@@ -582,6 +590,8 @@ class CRTCBusHandler {
 		uint8_t border_ = 0;
 
 		InterruptTimer &interrupt_timer_;
+
+		friend struct GateArrayState;
 };
 using CRTC = Motorola::CRTC::CRTC6845<
 	CRTCBusHandler,
@@ -759,6 +769,7 @@ template <bool has_fdc> class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::StateProducer,
 	public Utility::TypeRecipient<CharacterMapper>,
 	public CPU::Z80::BusHandler,
 	public ClockingHint::Observer,
@@ -1172,6 +1183,66 @@ template <bool has_fdc> class ConcreteMachine:
 			return key_state_.get_joysticks();
 		}
 
+		// MARK: - StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<State>();
+			get_state(*state);
+			return state;
+		}
+
+		bool get_state(Reflection::Struct &target) final {
+			const auto state = dynamic_cast<State *>(&target);
+			if(!state) return false;
+
+			state->z80 = CPU::Z80::State(z80_);
+			state->crtc = Motorola::CRTC::State(crtc_);
+			state->gate_array = GateArrayState(crtc_bus_handler_, interrupt_timer_);
+			state->i8255 = Intel::i8255::State(i8255_);
+
+			ay_.update();
+			state->ay = GI::AY38910::State(ay_.ay());
+
+			state->ram.assign(std::begin(ram_), std::begin(ram_) + (has_128k_ ? 128*1024 : 64*1024));
+			state->ram_configuration = ram_configuration_;
+			state->lower_rom_is_paged = read_pointers_[0] != write_pointers_[0];
+			state->upper_rom_is_paged = upper_rom_is_paged_;
+			state->upper_rom = upper_rom_;
+
+			state->clock_offset = clock_offset_.as<int>();
+			state->crtc_counter = crtc_counter_.as<int>();
+
+			return true;
+		}
+
+		bool set_state(const Reflection::Struct &state) final {
+			const auto cpc_state = dynamic_cast<const State *>(&state);
+			if(!cpc_state) return false;
+
+			cpc_state->z80.apply(z80_);
+			cpc_state->crtc.apply(crtc_);
+			cpc_state->gate_array.apply(crtc_bus_handler_, interrupt_timer_);
+			z80_.set_interrupt_line(interrupt_timer_.get_request());
+
+			// Reposting 8255 output will reestablish the AY's control lines, so
+			// restore AY registers only afterwards.
+			ay_.update();
+			cpc_state->i8255.apply(i8255_);
+			cpc_state->ay.apply(ay_.ay());
+
+			std::copy(cpc_state->ram.begin(), cpc_state->ram.begin() + ptrdiff_t(std::min(sizeof(ram_), cpc_state->ram.size())), ram_);
+
+			write_to_gate_array(0xc0 | cpc_state->ram_configuration);
+			upper_rom_ = ROMType(cpc_state->upper_rom);
+			upper_rom_is_paged_ = cpc_state->upper_rom_is_paged;
+			read_pointers_[0] = cpc_state->lower_rom_is_paged ? roms_[ROMType::OS].data() : write_pointers_[0];
+			read_pointers_[3] = upper_rom_is_paged_ ? roms_[upper_rom_].data() : write_pointers_[3];
+
+			clock_offset_ = HalfCycles(cpc_state->clock_offset);
+			crtc_counter_ = HalfCycles(cpc_state->crtc_counter);
+
+			return true;
+		}
+
 	private:
 		inline void write_to_gate_array(uint8_t value) {
 			switch(value >> 6) {
@@ -1193,6 +1264,7 @@ template <bool has_fdc> class ConcreteMachine:
 				case 3:
 					// Perform RAM paging, if 128kb is permitted.
 					if(has_128k_) {
+						ram_configuration_ = value & 7;
 						const bool adjust_low_read_pointer = read_pointers_[0] == write_pointers_[0];
 						const bool adjust_high_read_pointer = read_pointers_[3] == write_pointers_[3];
 #define RAM_BANK(x) &ram_[x * 16384]
@@ -1268,6 +1340,7 @@ template <bool has_fdc> class ConcreteMachine:
 		std::vector<uint8_t> roms_[3];
 		bool upper_rom_is_paged_ = false;
 		ROMType upper_rom_;
+		uint8_t ram_configuration_ = 0;
 
 		uint8_t *ram_pages_[4]{};
 		const uint8_t *read_pointers_[4]{};
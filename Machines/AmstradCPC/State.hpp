@@ -0,0 +1,128 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "../../Reflection/Struct.hpp"
+#include "../../Processors/Z80/State/State.hpp"
+
+#include "../../Components/6845/CRTC6845.hpp"
+#include "../../Components/8255/i8255.hpp"
+#include "../../Components/AY38910/AY38910.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace AmstradCPC {
+
+/*!
+	Captures the gate array: palette, mode and sync tracking, plus the interrupt timer.
+*/
+struct GateArrayState: public Reflection::StructImpl<GateArrayState> {
+	// Palette entries and border are stored as mapped colours, i.e. as output to the CRT.
+	uint8_t palette[16]{};
+	uint8_t border = 0;
+	int pen = 0;
+	int mode = 2, next_mode = 2;
+
+	bool was_hsync = false, was_vsync = false;
+	int cycles_into_hsync = 0;
+
+	int interrupt_timer = 0;
+	int interrupt_reset_counter = 0;
+	bool interrupt_request = false;
+
+	GateArrayState() {
+		if(needs_declare()) {
+			DeclareField(palette);
+			DeclareField(border);
+			DeclareField(pen);
+			DeclareField(mode);
+			DeclareField(next_mode);
+			DeclareField(was_hsync);
+			DeclareField(was_vsync);
+			DeclareField(cycles_into_hsync);
+			DeclareField(interrupt_timer);
+			DeclareField(interrupt_reset_counter);
+			DeclareField(interrupt_request);
+		}
+	}
+
+	template <typename CRTCBusHandler, typename InterruptTimer>
+	GateArrayState(const CRTCBusHandler &source, const InterruptTimer &timer) : GateArrayState() {
+		std::copy(std::begin(source.palette_), std::end(source.palette_), std::begin(palette));
+		border = source.border_;
+		pen = source.pen_;
+		mode = source.mode_;
+		next_mode = source.next_mode_;
+		was_hsync = source.was_hsync_;
+		was_vsync = source.was_vsync_;
+		cycles_into_hsync = source.cycles_into_hsync_;
+
+		interrupt_timer = timer.timer_;
+		interrupt_reset_counter = timer.reset_counter_;
+		interrupt_request = timer.interrupt_request_;
+	}
+
+	template <typename CRTCBusHandler, typename InterruptTimer>
+	void apply(CRTCBusHandler &target, InterruptTimer &timer) const {
+		std::copy(std::begin(palette), std::end(palette), std::begin(target.palette_));
+		target.border_ = border;
+		target.pen_ = pen;
+		target.next_mode_ = next_mode;
+		target.set_mode(mode);
+		target.was_hsync_ = was_hsync;
+		target.was_vsync_ = was_vsync;
+		target.cycles_into_hsync_ = cycles_into_hsync;
+
+		timer.timer_ = interrupt_timer;
+		timer.reset_counter_ = interrupt_reset_counter;
+		timer.interrupt_request_ = interrupt_request;
+	}
+};
+
+struct State: public Reflection::StructImpl<State> {
+	CPU::Z80::State z80;
+	Motorola::CRTC::State crtc;
+	GateArrayState gate_array;
+	Intel::i8255::State i8255;
+	GI::AY38910::State ay;
+
+	// 64kb or 128kb, in bank order.
+	std::vector<uint8_t> ram;
+
+	// Paging.
+	uint8_t ram_configuration = 0;
+	bool lower_rom_is_paged = true;
+	bool upper_rom_is_paged = true;
+	int upper_rom = 0;
+
+	// Phase of the CPU relative to the CRTC and wait-state generation.
+	int clock_offset = 0;
+	int crtc_counter = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(z80);
+			DeclareField(crtc);
+			DeclareField(gate_array);
+			DeclareField(i8255);
+			DeclareField(ay);
+			DeclareField(ram);
+			DeclareField(ram_configuration);
+			DeclareField(lower_rom_is_paged);
+			DeclareField(upper_rom_is_paged);
+			DeclareField(upper_rom);
+			DeclareField(clock_offset);
+			DeclareField(crtc_counter);
+		}
+	}
+};
+
+}
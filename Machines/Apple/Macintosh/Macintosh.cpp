@@ -36,6 +36,7 @@
 #include "../../../Components/DiskII/MacintoshDoubleDensityDrive.hpp"
 
 #include "../../../Processors/68000/68000.hpp"
+#include "../../../Processors/68000/FastProcessor.hpp"
 
 #include "../../../Storage/MassStorage/SCSI/SCSI.hpp"
 #include "../../../Storage/MassStorage/SCSI/DirectAccessDevice.hpp"
@@ -65,7 +66,7 @@ Log::Logger<Log::Source::Macintosh> logger;
 namespace Apple {
 namespace Macintosh {
 
-template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachine:
+template <Analyser::Static::Macintosh::Target::Model model, bool fast_cpu> class ConcreteMachine:
 	public Machine,
 	public MachineTypes::TimedMachine,
 	public MachineTypes::ScanProducer,
@@ -749,7 +750,11 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				Inputs::QuadratureMouse &mouse_;
 		};
 
-		CPU::MC68000::Processor<ConcreteMachine, true, true> mc68000_;
+		std::conditional_t<
+			fast_cpu,
+			CPU::MC68000::FastProcessor<ConcreteMachine>,
+			CPU::MC68000::Processor<ConcreteMachine, true, true>
+		> mc68000_;
 
 		DriveSpeedAccumulator drive_speed_accumulator_;
 		IWMActor iwm_;
@@ -840,16 +845,28 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
 using namespace Apple::Macintosh;
 
+namespace {
+
+template <Analyser::Static::Macintosh::Target::Model model>
+std::unique_ptr<Machine> machine(const Analyser::Static::Macintosh::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) {
+	if(target.fast_cpu) {
+		return std::make_unique<ConcreteMachine<model, true>>(target, rom_fetcher);
+	}
+	return std::make_unique<ConcreteMachine<model, false>>(target, rom_fetcher);
+}
+
+}
+
 std::unique_ptr<Machine> Machine::Macintosh(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher) {
 	auto *const mac_target = dynamic_cast<const Analyser::Static::Macintosh::Target *>(target);
 
 	using Model = Analyser::Static::Macintosh::Target::Model;
 	switch(mac_target->model) {
 		default:
-		case Model::Mac128k:	return std::make_unique<ConcreteMachine<Model::Mac128k>>(*mac_target, rom_fetcher);
-		case Model::Mac512k:	return std::make_unique<ConcreteMachine<Model::Mac512k>>(*mac_target, rom_fetcher);
-		case Model::Mac512ke:	return std::make_unique<ConcreteMachine<Model::Mac512ke>>(*mac_target, rom_fetcher);
-		case Model::MacPlus:	return std::make_unique<ConcreteMachine<Model::MacPlus>>(*mac_target, rom_fetcher);
+		case Model::Mac128k:	return machine<Model::Mac128k>(*mac_target, rom_fetcher);
+		case Model::Mac512k:	return machine<Model::Mac512k>(*mac_target, rom_fetcher);
+		case Model::Mac512ke:	return machine<Model::Mac512ke>(*mac_target, rom_fetcher);
+		case Model::MacPlus:	return machine<Model::MacPlus>(*mac_target, rom_fetcher);
 	}
 }
 
@@ -23,7 +23,9 @@ class Bus {
 	public:
 		Bus() :
 			tia_sound_(audio_queue_),
-			speaker_(tia_sound_) {}
+			speaker_(tia_sound_) {
+			speaker_.set_uses_band_limited_steps(true);
+		}
 
 		virtual ~Bus() {
 			audio_queue_.flush();
@@ -7,6 +7,7 @@
 //
 
 #include "TIASound.hpp"
+#include "../../../SignalProcessing/BandLimitedSteps.hpp"
 
 using namespace Atari2600;
 
@@ -40,90 +41,107 @@ void Atari2600::TIASound::set_control(int channel, uint8_t control) {
 #define advance_poly5(c) poly5_counter_[channel] = (poly5_counter_[channel] >> 1) | (((poly5_counter_[channel] << 4) ^ (poly5_counter_[channel] << 2))&0x010)
 #define advance_poly9(c) poly9_counter_[channel] = (poly9_counter_[channel] >> 1) | (((poly9_counter_[channel] << 4) ^ (poly9_counter_[channel] << 8))&0x100)
 
-void Atari2600::TIASound::get_samples(std::size_t number_of_samples, int16_t *target) {
-	for(unsigned int c = 0; c < number_of_samples; c++) {
-		target[c] = 0;
-		for(int channel = 0; channel < 2; channel++) {
-			divider_counter_[channel] ++;
-			int divider_value = divider_counter_[channel] / (38 / CPUTicksPerAudioTick);
-			int level = 0;
-			switch(control_[channel]) {
-				case 0x0: case 0xb:	// constant 1
-					level = 1;
-				break;
-
-				case 0x4: case 0x5:	// div2 tone
-					level = (divider_value / (divider_[channel]+1))&1;
-				break;
-
-				case 0xc: case 0xd:	// div6 tone
-					level = (divider_value / ((divider_[channel]+1)*3))&1;
-				break;
-
-				case 0x6: case 0xa:	// div31 tone
-					level = (divider_value / (divider_[channel]+1))%30 <= 18;
-				break;
-
-				case 0xe:			// div93 tone
-					level = (divider_value / ((divider_[channel]+1)*3))%30 <= 18;
-				break;
-
-				case 0x1:			// 4-bit poly
-					level = poly4_counter_[channel]&1;
-					if(divider_value == divider_[channel]+1) {
-						divider_counter_[channel] = 0;
-						advance_poly4(channel);
-					}
-				break;
-
-				case 0x2:			// 4-bit poly div31
-					level = poly4_counter_[channel]&1;
-					if(divider_value%(30*(divider_[channel]+1)) == 18) {
+int16_t Atari2600::TIASound::next_sample() {
+	int16_t sample = 0;
+	for(int channel = 0; channel < 2; channel++) {
+		divider_counter_[channel] ++;
+		int divider_value = divider_counter_[channel] / (38 / CPUTicksPerAudioTick);
+		int level = 0;
+		switch(control_[channel]) {
+			case 0x0: case 0xb:	// constant 1
+				level = 1;
+			break;
+
+			case 0x4: case 0x5:	// div2 tone
+				level = (divider_value / (divider_[channel]+1))&1;
+			break;
+
+			case 0xc: case 0xd:	// div6 tone
+				level = (divider_value / ((divider_[channel]+1)*3))&1;
+			break;
+
+			case 0x6: case 0xa:	// div31 tone
+				level = (divider_value / (divider_[channel]+1))%30 <= 18;
+			break;
+
+			case 0xe:			// div93 tone
+				level = (divider_value / ((divider_[channel]+1)*3))%30 <= 18;
+			break;
+
+			case 0x1:			// 4-bit poly
+				level = poly4_counter_[channel]&1;
+				if(divider_value == divider_[channel]+1) {
+					divider_counter_[channel] = 0;
+					advance_poly4(channel);
+				}
+			break;
+
+			case 0x2:			// 4-bit poly div31
+				level = poly4_counter_[channel]&1;
+				if(divider_value%(30*(divider_[channel]+1)) == 18) {
+					advance_poly4(channel);
+				}
+			break;
+
+			case 0x3:			// 5/4-bit poly
+				level = output_state_[channel];
+				if(divider_value == divider_[channel]+1) {
+					if(poly5_counter_[channel]&1) {
+						output_state_[channel] = poly4_counter_[channel]&1;
 						advance_poly4(channel);
 					}
-				break;
-
-				case 0x3:			// 5/4-bit poly
-					level = output_state_[channel];
-					if(divider_value == divider_[channel]+1) {
-						if(poly5_counter_[channel]&1) {
-							output_state_[channel] = poly4_counter_[channel]&1;
-							advance_poly4(channel);
-						}
-						advance_poly5(channel);
-					}
-				break;
-
-				case 0x7: case 0x9:	// 5-bit poly
-					level = poly5_counter_[channel]&1;
-					if(divider_value == divider_[channel]+1) {
-						divider_counter_[channel] = 0;
-						advance_poly5(channel);
-					}
-				break;
+					advance_poly5(channel);
+				}
+			break;
+
+			case 0x7: case 0x9:	// 5-bit poly
+				level = poly5_counter_[channel]&1;
+				if(divider_value == divider_[channel]+1) {
+					divider_counter_[channel] = 0;
+					advance_poly5(channel);
+				}
+			break;
+
+			case 0xf:			// 5-bit poly div6
+				level = poly5_counter_[channel]&1;
+				if(divider_value == (divider_[channel]+1)*3) {
+					divider_counter_[channel] = 0;
+					advance_poly5(channel);
+				}
+			break;
+
+			case 0x8:			// 9-bit poly
+				level = poly9_counter_[channel]&1;
+				if(divider_value == divider_[channel]+1) {
+					divider_counter_[channel] = 0;
+					advance_poly9(channel);
+				}
+			break;
+		}
 
-				case 0xf:			// 5-bit poly div6
-					level = poly5_counter_[channel]&1;
-					if(divider_value == (divider_[channel]+1)*3) {
-						divider_counter_[channel] = 0;
-						advance_poly5(channel);
-					}
-				break;
+		sample += (volume_[channel] * per_channel_volume_ * level) >> 4;
+	}
+	return sample;
+}
 
-				case 0x8:			// 9-bit poly
-					level = poly9_counter_[channel]&1;
-					if(divider_value == divider_[channel]+1) {
-						divider_counter_[channel] = 0;
-						advance_poly9(channel);
-					}
-				break;
-			}
+void Atari2600::TIASound::get_samples(std::size_t number_of_samples, int16_t *target) {
+	for(std::size_t c = 0; c < number_of_samples; c++) {
+		target[c] = next_sample();
+	}
+}
 
-			target[c] += (volume_[channel] * per_channel_volume_ * level) >> 4;
+template <typename TargetT> void Atari2600::TIASound::get_steps(std::size_t number_of_samples, TargetT &target) {
+	for(std::size_t c = 0; c < number_of_samples; c++) {
+		const int16_t sample = next_sample();
+		if(sample != posted_level_) {
+			target.add_step(c, int16_t(sample - posted_level_));
+			posted_level_ = sample;
 		}
 	}
 }
 
+template void Atari2600::TIASound::get_steps(std::size_t, SignalProcessing::BandLimitedSteps<1> &);
+
 void Atari2600::TIASound::set_sample_volume_range(std::int16_t range) {
 	per_channel_volume_ = range / 2;
 }
@@ -27,8 +27,10 @@ class TIASound: public Outputs::Speaker::SampleSource {
 
 		// To satisfy ::SampleSource.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		template <typename TargetT> void get_steps(std::size_t number_of_samples, TargetT &target);
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
+		static constexpr bool get_supports_steps() { return true; }
 
 	private:
 		Concurrency::AsyncTaskQueue<false> &audio_queue_;
@@ -44,6 +46,10 @@ class TIASound: public Outputs::Speaker::SampleSource {
 
 		int divider_counter_[2];
 		int16_t per_channel_volume_ = 0;
+		int16_t posted_level_ = 0;
+
+		/// Advances by a single sample, returning the level output.
+		int16_t next_sample();
 };
 
 }
@@ -14,6 +14,7 @@
 //#define LOG_TRACE
 //bool should_log = false;
 #include "../../../Processors/68000/68000.hpp"
+#include "../../../Processors/68000/FastProcessor.hpp"
 
 #include "../../../Components/AY38910/AY38910.hpp"
 #include "../../../Components/68901/MFP68901.hpp"
@@ -46,7 +47,7 @@ namespace ST {
 constexpr int CLOCK_RATE = 8021247;
 
 using Target = Analyser::Static::AtariST::Target;
-class ConcreteMachine:
+template <bool fast_cpu> class ConcreteMachine:
 	public Atari::ST::Machine,
 	public CPU::MC68000::BusHandler,
 	public MachineTypes::TimedMachine,
@@ -502,7 +503,11 @@ class ConcreteMachine:
 			speaker_.run_for(audio_queue_, cycles_since_audio_update_.divide_cycles(Cycles(4)));
 		}
 
-		CPU::MC68000::Processor<ConcreteMachine, true, true> mc68000_;
+		std::conditional_t<
+			fast_cpu,
+			CPU::MC68000::FastProcessor<ConcreteMachine>,
+			CPU::MC68000::Processor<ConcreteMachine, true, true>
+		> mc68000_;
 		HalfCycles bus_phase_;
 
 		JustInTimeActor<Video> video_;
@@ -715,7 +720,10 @@ std::unique_ptr<Machine> Machine::AtariST(const Analyser::Static::Target *target
 		return nullptr;
 	}
 
-	return std::make_unique<ConcreteMachine>(*atari_target, rom_fetcher);
+	if(atari_target->fast_cpu) {
+		return std::make_unique<ConcreteMachine<true>>(*atari_target, rom_fetcher);
+	}
+	return std::make_unique<ConcreteMachine<false>>(*atari_target, rom_fetcher);
 }
 
 Machine::~Machine() {}
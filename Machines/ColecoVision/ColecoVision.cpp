@@ -122,6 +122,7 @@ class ConcreteMachine:
 			mixer_(sn76489_, ay_),
 			speaker_(mixer_) {
 			speaker_.set_input_rate(3579545.0f / float(sn76489_divider));
+			speaker_.set_uses_band_limited_steps(true);
 			set_clock_rate(3579545);
 			joysticks_.emplace_back(new Joystick);
 			joysticks_.emplace_back(new Joystick);
@@ -8,6 +8,7 @@
 
 #include "../C1540.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <string>
@@ -16,6 +17,16 @@
 
 using namespace Commodore::C1540;
 
+namespace {
+
+/// @returns The number of whole cycles for which @c via can be run before it reaches its next sequence point.
+template <typename VIA> Cycles cycles_until_sequence_point(const VIA &via) {
+	const auto half_cycles = via.cycles_until_implicit_flush();
+	return std::max(Cycles(1), half_cycles.cycles() + Cycles(half_cycles.as_integral() & 1));
+}
+
+}
+
 ROM::Request Machine::rom_request(Personality personality) {
 	switch(personality) {
 		default:
@@ -39,6 +50,7 @@ MachineBase::MachineBase(Personality personality, const ROM::Map &roms) :
 	serial_port_VIA_port_handler_->set_interrupt_delegate(this);
 	drive_VIA_port_handler_.set_interrupt_delegate(this);
 	drive_VIA_port_handler_.set_delegate(this);
+	serial_port_VIA_port_handler_->set_delegate(this);
 
 	// set a bit rate
 	set_expected_bit_length(Storage::Encodings::CommodoreGCR::length_of_a_bit_in_time_zone(3));
@@ -59,6 +71,12 @@ MachineBase::MachineBase(Personality personality, const ROM::Map &roms) :
 		throw ROMMachine::Error::MissingROMs;
 	}
 	std::memcpy(rom_, roms.find(rom_name)->second.data(), std::min(sizeof(rom_), roms.find(rom_name)->second.size()));
+
+	// The DOS idle loop ends with a JMP $EBFF at $EC9B in both the 1540 and 1541 ROMs;
+	// check for it rather than assuming.
+	if(rom_[0x2c9b] == 0x4c && rom_[0x2c9c] == 0xff && rom_[0x2c9d] == 0xeb) {
+		idle_loop_address_ = 0xec9b;
+	}
 }
 
 Machine::Machine(Personality personality, const ROM::Map &roms) :
@@ -77,6 +95,25 @@ Cycles MachineBase::perform_bus_operation(CPU::MOS6502::BusOperation operation,
 			0x1c00-0x1c0f	the drive VIA
 			0xc000-0xffff	ROM
 	*/
+
+	// While asleep the 6502 is held before this bus cycle, until either an interrupt or
+	// a serial bus change wakes it or this run_for is exhausted. The VIAs continue to run.
+	Cycles duration(1);
+	if(is_asleep_) {
+		duration += sleep_for(time_remaining_ - duration);
+	}
+
+	if(
+		operation == CPU::MOS6502::BusOperation::ReadOpcode &&
+		address == idle_loop_address_ &&
+		!drive_VIA_port_handler_.get_motor_enabled() &&
+		!serial_port_VIA_.last_valid()->get_interrupt_line() &&
+		!drive_VIA_.last_valid()->get_interrupt_line()
+	) {
+		// Nothing further will happen until the serial bus changes or an interrupt occurs, so sleep until then.
+		is_asleep_ = true;
+	}
+
 	if(address < 0x800) {
 		if(isReadOperation(operation))
 			*value = ram_[address];
@@ -88,20 +125,43 @@ Cycles MachineBase::perform_bus_operation(CPU::MOS6502::BusOperation operation,
 		}
 	} else if(address >= 0x1800 && address <= 0x180f) {
 		if(isReadOperation(operation))
-			*value = serial_port_VIA_.read(address);
+			*value = serial_port_VIA_->read(address);
 		else
-			serial_port_VIA_.write(address, *value);
+			serial_port_VIA_->write(address, *value);
 	} else if(address >= 0x1c00 && address <= 0x1c0f) {
 		if(isReadOperation(operation))
-			*value = drive_VIA_.read(address);
+			*value = drive_VIA_->read(address);
 		else
-			drive_VIA_.write(address, *value);
+			drive_VIA_->write(address, *value);
+	}
+
+	serial_port_VIA_ += Cycles(1);
+	drive_VIA_ += Cycles(1);
+
+	// Clock the disk in lockstep, as the 6502 may be watching for a byte via the overflow flag.
+	if(drive_VIA_port_handler_.get_motor_enabled()) {
+		Storage::Disk::Controller::run_for(Cycles(1));
 	}
 
-	serial_port_VIA_.run_for(Cycles(1));
-	drive_VIA_.run_for(Cycles(1));
+	time_remaining_ -= duration;
+	return duration;
+}
 
-	return Cycles(1);
+Cycles MachineBase::sleep_for(Cycles limit) {
+	Cycles slept;
+	while(is_asleep_ && slept < limit) {
+		// Run the VIAs in bulk, but no further than the next point at which either might
+		// change its interrupt line; that will wake the 6502 if it sets the line.
+		const auto step = std::min({
+			limit - slept,
+			cycles_until_sequence_point(serial_port_VIA_),
+			cycles_until_sequence_point(drive_VIA_)
+		});
+		serial_port_VIA_ += step;
+		drive_VIA_ += step;
+		slept += step;
+	}
+	return slept;
 }
 
 void Machine::set_disk(std::shared_ptr<Storage::Disk::Disk> disk) {
@@ -109,24 +169,33 @@ void Machine::set_disk(std::shared_ptr<Storage::Disk::Disk> disk) {
 }
 
 void Machine::run_for(const Cycles cycles) {
+	time_remaining_ = cycles;
 	m6502_.run_for(cycles);
-
-	const bool drive_motor = drive_VIA_port_handler_.get_motor_enabled();
-	get_drive().set_motor_on(drive_motor);
-	if(drive_motor)
-		Storage::Disk::Controller::run_for(cycles);
 }
 
 void MachineBase::set_activity_observer(Activity::Observer *observer) {
-	drive_VIA_.bus_handler().set_activity_observer(observer);
+	drive_VIA_port_handler_.set_activity_observer(observer);
 	get_drive().set_activity_observer(observer, "Drive", false);
 }
 
+ClockingHint::Preference MachineBase::preferred_clocking() const {
+	return ClockingHint::Preference::JustInTime;
+}
+
+void MachineBase::wake() {
+	is_asleep_ = false;
+}
+
 // MARK: - 6522 delegate
 
 void MachineBase::mos6522_did_change_interrupt_status(void *) {
 	// both VIAs are connected to the IRQ line
-	m6502_.set_irq_line(serial_port_VIA_.get_interrupt_line() || drive_VIA_.get_interrupt_line());
+	// This is called from within the VIAs' own updates, so shouldn't cause another.
+	const bool irq_line = serial_port_VIA_.last_valid()->get_interrupt_line() || drive_VIA_.last_valid()->get_interrupt_line();
+	m6502_.set_irq_line(irq_line);
+	if(irq_line) {
+		wake();
+	}
 }
 
 // MARK: - Disk drive
@@ -163,9 +232,23 @@ void MachineBase::drive_via_did_set_data_density(void *, int density) {
 	set_expected_bit_length(Storage::Encodings::CommodoreGCR::length_of_a_bit_in_time_zone(unsigned(density)));
 }
 
+void MachineBase::drive_via_did_set_drive_motor(void *, bool enabled) {
+	get_drive().set_motor_on(enabled);
+}
+
+// MARK: - Serial port VIA delegate
+
+void MachineBase::serial_port_via_did_change_input(void *) {
+	wake();
+}
+
 // MARK: - SerialPortVIA
 
-SerialPortVIA::SerialPortVIA(MOS::MOS6522::MOS6522<SerialPortVIA> &via) : via_(via) {}
+SerialPortVIA::SerialPortVIA(JustInTimeActor<MOS::MOS6522::MOS6522<SerialPortVIA>> &via) : via_(via) {}
+
+void SerialPortVIA::set_delegate(Delegate *delegate) {
+	delegate_ = delegate;
+}
 
 uint8_t SerialPortVIA::get_port_input(MOS::MOS6522::Port port) {
 	if(port) return port_b_;
@@ -193,10 +276,12 @@ void SerialPortVIA::set_serial_line_state(::Commodore::Serial::Line line, bool v
 		case ::Commodore::Serial::Line::Attention:
 			attention_level_input_ = !value;
 			port_b_ = (port_b_ & ~0x80) | (value ? 0x00 : 0x80);
-			via_.set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !value);
+			via_->set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !value);
 			update_data_line();
 		break;
 	}
+
+	if(delegate_) delegate_->serial_port_via_did_change_input(this);
 }
 
 void SerialPortVIA::set_serial_port(const std::shared_ptr<::Commodore::Serial::Port> &serialPort) {
@@ -249,7 +334,11 @@ void DriveVIA::set_port_output(MOS::MOS6522::Port port, uint8_t value, uint8_t)
 	if(port) {
 		if(previous_port_b_output_ != value) {
 			// record drive motor state
-			drive_motor_ = !!(value&4);
+			const bool drive_motor = value & 4;
+			if(drive_motor != drive_motor_) {
+				drive_motor_ = drive_motor;
+				if(delegate_) delegate_->drive_via_did_set_drive_motor(this, drive_motor_);
+			}
 
 			// check for a head step
 			int step_difference = ((value&3) - (previous_port_b_output_&3))&3;
@@ -10,6 +10,7 @@
 
 #include "../../../../Processors/6502/6502.hpp"
 #include "../../../../Components/6522/6522.hpp"
+#include "../../../../ClockReceiver/JustInTime.hpp"
 
 #include "../../SerialBus.hpp"
 
@@ -20,6 +21,8 @@
 
 #include "../C1540.hpp"
 
+#include <optional>
+
 namespace Commodore::C1540 {
 
 /*!
@@ -39,7 +42,13 @@ namespace Commodore::C1540 {
 */
 class SerialPortVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 	public:
-		SerialPortVIA(MOS::MOS6522::MOS6522<SerialPortVIA> &via);
+		class Delegate {
+			public:
+				virtual void serial_port_via_did_change_input(void *serialPortVIA) = 0;
+		};
+		void set_delegate(Delegate *);
+
+		SerialPortVIA(JustInTimeActor<MOS::MOS6522::MOS6522<SerialPortVIA>> &via);
 
 		uint8_t get_port_input(MOS::MOS6522::Port);
 
@@ -49,12 +58,13 @@ class SerialPortVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 		void set_serial_port(const std::shared_ptr<::Commodore::Serial::Port> &);
 
 	private:
-		MOS::MOS6522::MOS6522<SerialPortVIA> &via_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<SerialPortVIA>> &via_;
 		uint8_t port_b_ = 0x0;
 		std::weak_ptr<::Commodore::Serial::Port> serial_port_;
 		bool attention_acknowledge_level_ = false;
 		bool attention_level_input_ = true;
 		bool data_level_output_ = false;
+		Delegate *delegate_ = nullptr;
 
 		void update_data_line();
 };
@@ -81,6 +91,7 @@ class DriveVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 			public:
 				virtual void drive_via_did_step_head(void *driveVIA, int direction) = 0;
 				virtual void drive_via_did_set_data_density(void *driveVIA, int density) = 0;
+				virtual void drive_via_did_set_drive_motor(void *driveVIA, bool enabled) = 0;
 		};
 		void set_delegate(Delegate *);
 
@@ -121,6 +132,7 @@ class SerialPort : public ::Commodore::Serial::Port {
 class MachineBase:
 	public CPU::MOS6502::BusHandler,
 	public MOS::MOS6522::IRQDelegatePortHandler::Delegate,
+	public SerialPortVIA::Delegate,
 	public DriveVIA::Delegate,
 	public Storage::Disk::Controller {
 
@@ -136,6 +148,14 @@ class MachineBase:
 		// to satisfy DriveVIA::Delegate
 		void drive_via_did_step_head(void *driveVIA, int direction);
 		void drive_via_did_set_data_density(void *driveVIA, int density);
+		void drive_via_did_set_drive_motor(void *driveVIA, bool enabled);
+
+		// to satisfy SerialPortVIA::Delegate
+		void serial_port_via_did_change_input(void *serialPortVIA);
+
+		/// Always prefers just-in-time clocking: the VIAs' timers continue to run even while the
+		/// drive's 6502 is asleep, and may wake it.
+		ClockingHint::Preference preferred_clocking() const final;
 
 		/// Attaches the activity observer to this C1540.
 		void set_activity_observer(Activity::Observer *observer);
@@ -150,10 +170,20 @@ class MachineBase:
 		std::shared_ptr<SerialPort> serial_port_;
 		DriveVIA drive_VIA_port_handler_;
 
-		MOS::MOS6522::MOS6522<DriveVIA> drive_VIA_;
-		MOS::MOS6522::MOS6522<SerialPortVIA> serial_port_VIA_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<DriveVIA>> drive_VIA_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<SerialPortVIA>> serial_port_VIA_;
 
 		int shift_register_ = 0, bit_window_offset_;
+
+		// The address of the final instruction of the DOS idle loop, if it is where expected in the ROM.
+		std::optional<uint16_t> idle_loop_address_;
+		bool is_asleep_ = false;
+		void wake();
+
+		// The time left in the current run_for, from which any sleep is taken.
+		Cycles time_remaining_;
+		Cycles sleep_for(Cycles limit);
+
 		virtual void process_input_bit(int value);
 		virtual void process_index_hole();
 };
@@ -0,0 +1,43 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "../../../Reflection/Struct.hpp"
+#include "../../../Processors/6502/State/State.hpp"
+
+#include "../../../Components/6522/6522.hpp"
+#include "../../../Components/6560/6560.hpp"
+
+#include <vector>
+
+namespace Commodore::Vic20 {
+
+struct State: public Reflection::StructImpl<State> {
+	CPU::MOS6502::State m6502;
+	MOS::MOS6560::State video;
+	MOS::MOS6522::State user_port_via;
+	MOS::MOS6522::State keyboard_via;
+
+	// The full 64kb address space, regardless of which parts are populated.
+	std::vector<uint8_t> ram;
+	std::vector<uint8_t> colour_ram;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(m6502);
+			DeclareField(video);
+			DeclareField(user_port_via);
+			DeclareField(keyboard_via);
+			DeclareField(ram);
+			DeclareField(colour_ram);
+		}
+	}
+};
+
+}
@@ -9,6 +9,7 @@
 #include "Vic20.hpp"
 
 #include "Keyboard.hpp"
+#include "State.hpp"
 
 #include "../../../Activity/Source.hpp"
 #include "../../MachineTypes.hpp"
@@ -18,6 +19,7 @@
 #include "../../../Components/6522/6522.hpp"
 
 #include "../../../ClockReceiver/ForceInline.hpp"
+#include "../../../ClockReceiver/JustInTime.hpp"
 #include "../../../Outputs/Log.hpp"
 
 #include "../../../Storage/Tape/Parsers/Commodore.hpp"
@@ -280,6 +282,7 @@ class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::StateProducer,
 	public Configurable::Device,
 	public CPU::MOS6502::BusHandler,
 	public MOS::MOS6522::IRQDelegatePortHandler::Delegate,
@@ -360,13 +363,13 @@ class ConcreteMachine:
 
 			if(target.has_c1540) {
 				// construct the 1540
-				c1540_ = std::make_unique<::Commodore::C1540::Machine>(Commodore::C1540::Personality::C1540, roms);
+				c1540_ = std::make_unique<JustInTimeActor<::Commodore::C1540::Machine, Cycles>>(Commodore::C1540::Personality::C1540, roms);
 
 				// attach it to the serial bus
-				c1540_->set_serial_bus(serial_bus_);
+				(*c1540_)->set_serial_bus(serial_bus_);
 
 				// give it a little warm up
-				c1540_->run_for(Cycles(2000000));
+				(*c1540_)->run_for(Cycles(2000000));
 			}
 
 			// Determine PAL/NTSC
@@ -451,7 +454,7 @@ class ConcreteMachine:
 			}
 
 			if(!media.disks.empty() && c1540_) {
-				c1540_->set_disk(media.disks.front());
+				(*c1540_)->set_disk(media.disks.front());
 			}
 
 			if(!media.cartridges.empty()) {
@@ -475,7 +478,7 @@ class ConcreteMachine:
 			} else {
 				switch(key) {
 					case KeyRestore:
-						user_port_via_.set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !is_pressed);
+						user_port_via_->set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !is_pressed);
 					break;
 #define ShiftedMap(source, target)	\
 					case source:	\
@@ -507,6 +510,12 @@ class ConcreteMachine:
 			// run the phase-1 part of this cycle, in which the VIC accesses memory
 			cycles_since_mos6560_update_++;
 
+			// The 1540 is clocked lazily, so bring it up to date before any VIA access: those are
+			// the only points at which the serial bus is sampled or changed.
+			if(c1540_ && (address&0xfc00) == 0x9000 && (address&0x30)) {
+				c1540_->flush();
+			}
+
 			// run the phase-2 part of the cycle, which is whatever the 6502 said it should be
 			if(isReadOperation(operation)) {
 				uint8_t result = processor_read_memory_map_[address >> 10] ? processor_read_memory_map_[address >> 10][address & 0x3ff] : 0xff;
@@ -515,8 +524,8 @@ class ConcreteMachine:
 						update_video();
 						result &= mos6560_.read(address);
 					}
-					if(address & 0x10) result &= user_port_via_.read(address);
-					if(address & 0x20) result &= keyboard_via_.read(address);
+					if(address & 0x10) result &= user_port_via_->read(address);
+					if(address & 0x20) result &= keyboard_via_->read(address);
 				}
 				*value = result;
 
@@ -603,14 +612,14 @@ class ConcreteMachine:
 						mos6560_.write(address, *value);
 					}
 					// The first VIA is selected by bit 4 = 1.
-					if(address & 0x10) user_port_via_.write(address, *value);
+					if(address & 0x10) user_port_via_->write(address, *value);
 					// The second VIA is selected by bit 5 = 1.
-					if(address & 0x20) keyboard_via_.write(address, *value);
+					if(address & 0x20) keyboard_via_->write(address, *value);
 				}
 			}
 
-			user_port_via_.run_for(Cycles(1));
-			keyboard_via_.run_for(Cycles(1));
+			user_port_via_ += Cycles(1);
+			keyboard_via_ += Cycles(1);
 			if(typer_ && address == 0xeb1e && operation == CPU::MOS6502::BusOperation::ReadOpcode) {
 				if(!typer_->type_next_character()) {
 					clear_all_keys();
@@ -618,7 +627,7 @@ class ConcreteMachine:
 				}
 			}
 			if(!tape_is_sleeping_ && !hold_tape_) tape_->run_for(Cycles(1));
-			if(c1540_) c1540_->run_for(Cycles(1));
+			if(c1540_) *c1540_ += Cycles(1);
 
 			return Cycles(1);
 		}
@@ -634,6 +643,9 @@ class ConcreteMachine:
 
 		void run_for(const Cycles cycles) final {
 			m6502_.run_for(cycles);
+			user_port_via_.flush();
+			keyboard_via_.flush();
+			if(c1540_) c1540_->flush();
 		}
 
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
@@ -656,9 +668,66 @@ class ConcreteMachine:
 			return mos6560_.get_speaker();
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<State>();
+			get_state(*state);
+			return state;
+		}
+
+		bool get_state(Reflection::Struct &target) final {
+			const auto state = dynamic_cast<State *>(&target);
+			if(!state) return false;
+
+			state->m6502 = CPU::MOS6502::State(m6502_);
+
+			update_video();
+			state->video = MOS::MOS6560::State(mos6560_);
+			user_port_via_.flush();
+			keyboard_via_.flush();
+			state->user_port_via = MOS::MOS6522::State(*user_port_via_.last_valid());
+			state->keyboard_via = MOS::MOS6522::State(*keyboard_via_.last_valid());
+
+			state->ram.assign(std::begin(ram_), std::end(ram_));
+			state->colour_ram.assign(std::begin(colour_ram_), std::end(colour_ram_));
+
+			return true;
+		}
+
+		bool set_state(const Reflection::Struct &state) final {
+			const auto vic_state = dynamic_cast<const State *>(&state);
+			if(!vic_state) return false;
+
+			vic_state->m6502.apply(m6502_);
+
+			update_video();
+			vic_state->video.apply(mos6560_);
+
+			user_port_via_.flush();
+			keyboard_via_.flush();
+			vic_state->user_port_via.apply(*user_port_via_.last_valid());
+			vic_state->keyboard_via.apply(*keyboard_via_.last_valid());
+			user_port_via_.update_sequence_point();
+			keyboard_via_.update_sequence_point();
+
+			// Repost the port outputs that the VIA port handlers track: the keyboard
+			// row selection and serial ATN.
+			keyboard_via_port_handler_->set_port_output(
+				MOS::MOS6522::Port::B, vic_state->keyboard_via.output[1], vic_state->keyboard_via.data_direction[1]);
+			user_port_via_port_handler_->set_port_output(
+				MOS::MOS6522::Port::A, vic_state->user_port_via.output[0], vic_state->user_port_via.data_direction[0]);
+
+			memcpy(ram_, vic_state->ram.data(), std::min(sizeof(ram_), vic_state->ram.size()));
+			memcpy(colour_ram_, vic_state->colour_ram.data(), std::min(sizeof(colour_ram_), vic_state->colour_ram.size()));
+
+			return true;
+		}
+
 		void mos6522_did_change_interrupt_status(void *) final {
-			m6502_.set_nmi_line(user_port_via_.get_interrupt_line());
-			m6502_.set_irq_line(keyboard_via_.get_interrupt_line());
+			// This is called from within the VIAs' own updates, so shouldn't cause another.
+			m6502_.set_nmi_line(user_port_via_.last_valid()->get_interrupt_line());
+			m6502_.set_irq_line(keyboard_via_.last_valid()->get_interrupt_line());
 		}
 
 		void type_string(const std::string &string) final {
@@ -670,7 +739,7 @@ class ConcreteMachine:
 		}
 
 		void tape_did_change_input(Storage::Tape::BinaryTapePlayer *tape) final {
-			keyboard_via_.set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !tape->get_input());
+			keyboard_via_->set_control_line_input(MOS::MOS6522::Port::A, MOS::MOS6522::Line::One, !tape->get_input());
 		}
 
 		KeyboardMapper *get_keyboard_mapper() final {
@@ -700,7 +769,7 @@ class ConcreteMachine:
 
 		// MARK: - Activity Source
 		void set_activity_observer(Activity::Observer *observer) final {
-			if(c1540_) c1540_->set_activity_observer(observer);
+			if(c1540_) (*c1540_)->set_activity_observer(observer);
 		}
 
 	private:
@@ -741,8 +810,8 @@ class ConcreteMachine:
 		std::shared_ptr<SerialPort> serial_port_;
 		std::shared_ptr<::Commodore::Serial::Bus> serial_bus_;
 
-		MOS::MOS6522::MOS6522<UserPortVIA> user_port_via_;
-		MOS::MOS6522::MOS6522<KeyboardVIA> keyboard_via_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<UserPortVIA>> user_port_via_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<KeyboardVIA>> keyboard_via_;
 
 		// Tape
 		std::shared_ptr<Storage::Tape::BinaryTapePlayer> tape_;
@@ -755,7 +824,7 @@ class ConcreteMachine:
 		}
 
 		// Disk
-		std::shared_ptr<::Commodore::C1540::Machine> c1540_;
+		std::unique_ptr<JustInTimeActor<::Commodore::C1540::Machine, Cycles>> c1540_;
 };
 
 }
@@ -31,6 +31,7 @@
 #include "Keyboard.hpp"
 #include "Plus3.hpp"
 #include "SoundGenerator.hpp"
+#include "State.hpp"
 #include "Tape.hpp"
 #include "Video.hpp"
 
@@ -43,6 +44,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 	public MachineTypes::AudioProducer,
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
+	public MachineTypes::StateProducer,
 	public Configurable::Device,
 	public CPU::MOS6502::BusHandler,
 	public Tape::Delegate,
@@ -308,6 +310,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 					case 0xfe06:
 						if(!isReadOperation(operation)) {
 							update_audio();
+							sound_divider_ = *value;
 							sound_generator_.set_divider(*value);
 							tape_.set_counter(*value);
 						}
@@ -428,7 +431,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 
 											int cycles_left_while_plausibly_in_data = 50;
 											tape_.clear_interrupts(Interrupt::ReceiveDataFull);
-											while(!tape_.get_tape()->is_at_end()) {
+											while(!tape_.is_at_end()) {
 												tape_.run_for_input_pulse();
 												--cycles_left_while_plausibly_in_data;
 												if(!cycles_left_while_plausibly_in_data) fast_load_is_in_data_ = false;
@@ -531,6 +534,85 @@ template <bool has_scsi_bus> class ConcreteMachine:
 			return &speaker_;
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<State>();
+			get_state(*state);
+			return state;
+		}
+
+		bool get_state(Reflection::Struct &target) final {
+			const auto state = dynamic_cast<State *>(&target);
+			if(!state) return false;
+
+			state->m6502 = CPU::MOS6502::State(m6502_);
+
+			video_.flush();
+			state->video = VideoOutput::State(*video_.last_valid());
+			state->tape = Tape::State(tape_);
+
+			state->ram.assign(std::begin(ram_), std::end(ram_));
+			state->sideways_ram.clear();
+			for(int c = 0; c < 16; c++) {
+				if(rom_write_masks_[c]) {
+					state->sideways_ram.insert(state->sideways_ram.end(), std::begin(roms_[c]), std::end(roms_[c]));
+				}
+			}
+
+			state->active_rom = active_rom_;
+			state->keyboard_is_active = keyboard_is_active_;
+			state->basic_is_active = basic_is_active_;
+
+			state->interrupt_status = interrupt_status_;
+			state->interrupt_control = interrupt_control_;
+
+			state->sound_divider = sound_divider_;
+			state->speaker_is_enabled = speaker_is_enabled_;
+
+			return true;
+		}
+
+		bool set_state(const Reflection::Struct &state) final {
+			const auto electron_state = dynamic_cast<const State *>(&state);
+			if(!electron_state) return false;
+
+			electron_state->m6502.apply(m6502_);
+
+			video_.flush();
+			electron_state->video.apply(*video_.last_valid());
+			video_.update_sequence_point();
+			video_access_range_ = video_.last_valid()->get_memory_access_range();
+
+			electron_state->tape.apply(tape_);
+
+			memcpy(ram_, electron_state->ram.data(), std::min(sizeof(ram_), electron_state->ram.size()));
+			auto sideways_ram = electron_state->sideways_ram.begin();
+			for(int c = 0; c < 16 && sideways_ram != electron_state->sideways_ram.end(); c++) {
+				if(rom_write_masks_[c]) {
+					const auto length = std::min(ptrdiff_t(sizeof(roms_[c])), electron_state->sideways_ram.end() - sideways_ram);
+					std::copy(sideways_ram, sideways_ram + length, roms_[c]);
+					sideways_ram += length;
+				}
+			}
+
+			active_rom_ = electron_state->active_rom & 15;
+			keyboard_is_active_ = electron_state->keyboard_is_active;
+			basic_is_active_ = electron_state->basic_is_active;
+
+			interrupt_status_ = electron_state->interrupt_status;
+			interrupt_control_ = electron_state->interrupt_control;
+			evaluate_interrupts();
+
+			update_audio();
+			sound_divider_ = electron_state->sound_divider;
+			speaker_is_enabled_ = electron_state->speaker_is_enabled;
+			sound_generator_.set_divider(sound_divider_);
+			sound_generator_.set_is_enabled(speaker_is_enabled_);
+
+			return true;
+		}
+
 		void run_for(const Cycles cycles) final {
 			m6502_.run_for(cycles);
 		}
@@ -775,6 +857,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 		Outputs::Speaker::PullLowpass<SoundGenerator> speaker_;
 
 		bool speaker_is_enabled_ = false;
+		uint8_t sound_divider_ = 0;
 
 		// MARK: - Caps Lock status and the activity observer.
 		const std::string caps_led = "CAPS";
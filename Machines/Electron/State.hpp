@@ -0,0 +1,62 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "../../Reflection/Struct.hpp"
+#include "../../Processors/6502/State/State.hpp"
+
+#include "Tape.hpp"
+#include "Video.hpp"
+
+#include <vector>
+
+namespace Electron {
+
+struct State: public Reflection::StructImpl<State> {
+	CPU::MOS6502::State m6502;
+	VideoOutput::State video;
+	Tape::State tape;
+
+	std::vector<uint8_t> ram;
+
+	// The contents of any sideways RAM, in slot order.
+	std::vector<uint8_t> sideways_ram;
+
+	// Paging.
+	int active_rom = 0;
+	bool keyboard_is_active = false;
+	bool basic_is_active = false;
+
+	// Interrupts.
+	uint8_t interrupt_status = 0;
+	uint8_t interrupt_control = 0;
+
+	// Audio.
+	uint8_t sound_divider = 0;
+	bool speaker_is_enabled = false;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(m6502);
+			DeclareField(video);
+			DeclareField(tape);
+			DeclareField(ram);
+			DeclareField(sideways_ram);
+			DeclareField(active_rom);
+			DeclareField(keyboard_is_active);
+			DeclareField(basic_is_active);
+			DeclareField(interrupt_status);
+			DeclareField(interrupt_control);
+			DeclareField(sound_divider);
+			DeclareField(speaker_is_enabled);
+		}
+	}
+};
+
+}
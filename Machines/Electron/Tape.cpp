@@ -91,3 +91,29 @@ void Tape::run_for(const Cycles cycles) {
 		}
 	}
 }
+
+// MARK: - State
+
+Tape::State::State(const Tape &source) : State() {
+	data_register = source.data_register_;
+	interrupt_status = source.interrupt_status_;
+	is_running = source.is_running_;
+	is_enabled = source.is_enabled_;
+	is_in_input_mode = source.is_in_input_mode_;
+	minimum_bits_until_full = source.input_.minimum_bits_until_full;
+	cycles_into_pulse = source.output_.cycles_into_pulse;
+	bits_remaining_until_empty = source.output_.bits_remaining_until_empty;
+}
+
+void Tape::State::apply(Tape &target) const {
+	target.data_register_ = data_register;
+	target.is_running_ = is_running;
+	target.is_enabled_ = is_enabled;
+	target.is_in_input_mode_ = is_in_input_mode;
+	target.input_.minimum_bits_until_full = minimum_bits_until_full;
+	target.output_.cycles_into_pulse = cycles_into_pulse;
+	target.output_.bits_remaining_until_empty = bits_remaining_until_empty;
+
+	target.interrupt_status_ = interrupt_status;
+	target.evaluate_interrupts();
+}
@@ -12,6 +12,7 @@
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../Storage/Tape/Tape.hpp"
+#include "../../Reflection/Struct.hpp"
 #include "../../Storage/Tape/Parsers/Acorn.hpp"
 #include "Interrupts.hpp"
 
@@ -45,6 +46,9 @@ class Tape:
 
 		void acorn_shifter_output_bit(int value);
 
+		/// Captures or restores the serial ULA state; tape position is not included.
+		struct State;
+
 	private:
 		void process_input_pulse(const Storage::Tape::Tape::Pulse &pulse);
 		inline void push_tape_bit(uint16_t bit);
@@ -72,4 +76,31 @@ class Tape:
 		::Storage::Tape::Acorn::Shifter shifter_;
 };
 
+struct Tape::State: public Reflection::StructImpl<Tape::State> {
+	uint16_t data_register = 0;
+	uint8_t interrupt_status = 0;
+	bool is_running = false;
+	bool is_enabled = false;
+	bool is_in_input_mode = false;
+	int minimum_bits_until_full = 0;
+	uint32_t cycles_into_pulse = 0;
+	uint32_t bits_remaining_until_empty = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(data_register);
+			DeclareField(interrupt_status);
+			DeclareField(is_running);
+			DeclareField(is_enabled);
+			DeclareField(is_in_input_mode);
+			DeclareField(minimum_bits_until_full);
+			DeclareField(cycles_into_pulse);
+			DeclareField(bits_remaining_until_empty);
+		}
+	}
+
+	State(const Tape &source);
+	void apply(Tape &target) const;
+};
+
 }
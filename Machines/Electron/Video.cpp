@@ -8,7 +8,9 @@
 
 #include "Video.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 
 using namespace Electron;
 
@@ -322,43 +324,46 @@ void VideoOutput::write(int address, uint8_t value) {
 				palette_[registers[index][1]]	= (palette_[registers[index][1]]&5)	| ((colour >> 1)&2);
 			}
 
-			// regenerate all palette tables for now
-			for(int byte = 0; byte < 256; byte++) {
-				uint8_t *target = reinterpret_cast<uint8_t *>(&palette_tables_.forty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-				target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
-				target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-				target[4] = palette_[(byte&0x08) >> 0];
-				target[5] = palette_[(byte&0x04) << 1];
-				target[6] = palette_[(byte&0x02) << 2];
-				target[7] = palette_[(byte&0x01) << 3];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.forty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty4bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
-			}
+			setup_palette_tables();
 		}
 		break;
 	}
 }
 
+void VideoOutput::setup_palette_tables() {
+	for(int byte = 0; byte < 256; byte++) {
+		uint8_t *target = reinterpret_cast<uint8_t *>(&palette_tables_.forty1bpp[byte]);
+		target[0] = palette_[(byte&0x80) >> 4];
+		target[1] = palette_[(byte&0x40) >> 3];
+		target[2] = palette_[(byte&0x20) >> 2];
+		target[3] = palette_[(byte&0x10) >> 1];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty2bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
+		target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
+		target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty1bpp[byte]);
+		target[0] = palette_[(byte&0x80) >> 4];
+		target[1] = palette_[(byte&0x40) >> 3];
+		target[2] = palette_[(byte&0x20) >> 2];
+		target[3] = palette_[(byte&0x10) >> 1];
+		target[4] = palette_[(byte&0x08) >> 0];
+		target[5] = palette_[(byte&0x04) << 1];
+		target[6] = palette_[(byte&0x02) << 2];
+		target[7] = palette_[(byte&0x01) << 3];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.forty2bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty4bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
+	}
+}
+
 void VideoOutput::setup_base_address() {
 	switch(screen_mode_) {
 		case 0: case 1: case 2: screen_mode_base_address_ = 0x3000; break;
@@ -500,3 +505,28 @@ void VideoOutput::emplace_pixel_line() {
 	screen_map_.emplace_back(DrawAction::Pixels, 80);
 	screen_map_.emplace_back(DrawAction::Blank, 48 - first_graphics_cycle);
 }
+
+// MARK: - State
+
+VideoOutput::State::State(const VideoOutput &source) : State() {
+	std::copy(std::begin(source.palette_), std::end(source.palette_), std::begin(palette));
+	screen_mode = source.screen_mode_;
+	start_screen_address = source.start_screen_address_;
+	output_position = source.output_position_;
+	interrupts = source.interrupts_;
+}
+
+void VideoOutput::State::apply(VideoOutput &target) const {
+	std::copy(std::begin(palette), std::end(palette), std::begin(target.palette_));
+	target.setup_palette_tables();
+
+	target.screen_mode_ = screen_mode;
+	target.setup_base_address();
+	target.start_screen_address_ = start_screen_address;
+
+	// Run for at least a whole frame, to arrive at the captured position with all
+	// line-by-line state properly established.
+	const int position = ((output_position % cycles_per_frame) + cycles_per_frame) % cycles_per_frame;
+	target.run_for(Cycles(cycles_per_frame + (position - target.output_position_ + cycles_per_frame) % cycles_per_frame));
+	target.interrupts_ = Electron::Interrupt(interrupts);
+}
@@ -10,6 +10,7 @@
 
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 #include "Interrupts.hpp"
 
 #include <vector>
@@ -81,11 +82,15 @@ class VideoOutput {
 		*/
 		Range get_memory_access_range();
 
+		/// Captures or restores register state and frame position.
+		struct State;
+
 	private:
 		inline void start_pixel_line();
 		inline void end_pixel_line();
 		inline void output_pixels(int number_of_cycles);
 		inline void setup_base_address();
+		inline void setup_palette_tables();
 
 		int output_position_ = 0;
 
@@ -135,4 +140,28 @@ class VideoOutput {
 		Electron::Interrupt interrupts_ = Electron::Interrupt(0);
 };
 
+struct VideoOutput::State: public Reflection::StructImpl<VideoOutput::State> {
+	uint8_t palette[16]{};
+	uint8_t screen_mode = 6;
+	uint16_t start_screen_address = 0;
+	int output_position = 0;
+	uint8_t interrupts = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(palette);
+			DeclareField(screen_mode);
+			DeclareField(start_screen_address);
+			DeclareField(output_position);
+			DeclareField(interrupts);
+		}
+	}
+
+	State(const VideoOutput &source);
+
+	/// Applies this state to @c target; all other raster state is regenerated by
+	/// running @c target forward to the captured frame position.
+	void apply(VideoOutput &target) const;
+};
+
 }
@@ -68,6 +68,17 @@ void Audio::set_sample_volume_range(int16_t range) {
 	});
 }
 
+bool Audio::is_zero_level() const {
+	// Output is trivially silent if every amplitude is zero.
+	for(int side = 0; side < 2; side++) {
+		if(
+			channels_[0].amplitude[side] || channels_[1].amplitude[side] || channels_[2].amplitude[side] ||
+			noise_.amplitude[side]
+		) return false;
+	}
+	return true;
+}
+
 void Audio::update_channel(int c) {
 	auto output = channels_[c].output & 1;
 	channels_[c].output <<= 1;
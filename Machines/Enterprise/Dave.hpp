@@ -39,6 +39,7 @@ class Audio: public Outputs::Speaker::SampleSource {
 		void set_sample_volume_range(int16_t range);
 		static constexpr bool get_is_stereo() { return true; }	// Dave produces stereo sound.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
+		bool is_zero_level() const;
 
 	private:
 		Concurrency::AsyncTaskQueue<false> &audio_queue_;
@@ -13,6 +13,7 @@
 #include "DiskROM.hpp"
 #include "Keyboard.hpp"
 #include "MemorySlotHandler.hpp"
+#include "State.hpp"
 
 #include "../../Analyser/Static/MSX/Cartridge.hpp"
 #include "Cartridges/ASCII8kb.hpp"
@@ -186,6 +187,7 @@ class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::StateProducer,
 	public Configurable::Device,
 	public ClockingHint::Observer,
 	public Activity::Source,
@@ -213,10 +215,13 @@ class ConcreteMachine:
 
 			// Set the AY to 50% of available volume, the toggle to 10% and leave 40% for an SCC.
 			// If there is an OPLL, give it equal volume to the AY and expect some clipping.
+			//
+			// The OPLL's output changes far too frequently to benefit from band-limited steps.
 			if constexpr (has_opll) {
 				speaker_.mixer.set_relative_volumes({0.5f, 0.1f, 0.4f, 0.5f});
 			} else {
 				speaker_.mixer.set_relative_volumes({0.5f, 0.1f, 0.4f});
+				speaker_.speaker.set_uses_band_limited_steps(true);
 			}
 
 			// Install the proper TV standard and select an ideal BIOS name.
@@ -703,21 +708,7 @@ class ConcreteMachine:
 									break;
 								}
 
-								ram_mapper_[port - 0xfc] = *cycle.value;
-
-								// Apply to RAM.
-								//
-								// On a real MSX this may also affect other slots.
-								// I've not yet needed it to propagate further, so
-								// have not implemented any onward route.
-								const uint16_t region = uint16_t((port - 0xfc) << 14);
-								const size_t base = size_t(*cycle.value) << 14;
-								if(base < RAMSize) {
-									ram_slot().template map<MemorySlot::AccessType::ReadWrite>(base, region, 0x4000);
-								} else {
-									ram_slot().unmap(region, 0x4000);
-								}
-
+								set_ram_mapper(port - 0xfc, *cycle.value);
 								update_paging();
 							} break;
 
@@ -846,11 +837,84 @@ class ConcreteMachine:
 			return ay_port_handler_.get_joysticks();
 		}
 
+		// MARK: - StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<State>();
+			get_state(*state);
+			return state;
+		}
+
+		bool get_state(Reflection::Struct &target) final {
+			const auto state = dynamic_cast<State *>(&target);
+			if(!state) return false;
+
+			state->z80 = CPU::Z80::State(z80_);
+			vdp_.flush();
+			state->vdp = TI::TMS::State(*vdp_.last_valid());
+			state->i8255 = Intel::i8255::State(i8255_);
+
+			update_audio();
+			state->ay = GI::AY38910::State(speaker_.ay);
+
+			state->ram.assign(ram(), ram() + RAMSize);
+			for(int c = 0; c < 4; c++) {
+				state->secondary_paging[c] = memory_slots_[c].secondary_paging();
+				state->ram_mapper[c] = ram_mapper_[c];
+			}
+
+			return true;
+		}
+
+		bool set_state(const Reflection::Struct &state) final {
+			const auto msx_state = dynamic_cast<const State *>(&state);
+			if(!msx_state) return false;
+
+			msx_state->z80.apply(z80_);
+
+			vdp_.flush();
+			msx_state->vdp.apply(*vdp_.last_valid());
+			vdp_.update_sequence_point();
+			z80_.set_interrupt_line(vdp_->get_interrupt_line());
+
+			update_audio();
+			msx_state->ay.apply(speaker_.ay);
+
+			std::copy(msx_state->ram.begin(), msx_state->ram.begin() + ptrdiff_t(std::min(size_t(RAMSize), msx_state->ram.size())), ram());
+			for(int c = 0; c < 4; c++) {
+				memory_slots_[c].set_secondary_paging(msx_state->secondary_paging[c]);
+				if constexpr (model != Target::Model::MSX1) {
+					set_ram_mapper(c, msx_state->ram_mapper[c]);
+				}
+			}
+
+			// Reposting 8255 output will also set primary paging, which updates all memory pointers.
+			msx_state->i8255.apply(i8255_);
+
+			return true;
+		}
+
 	private:
 		void update_audio() {
 			speaker_.speaker.run_for(speaker_.audio_queue, time_since_ay_update_.divide_cycles(Cycles(2)));
 		}
 
+		void set_ram_mapper(int page, uint8_t value) {
+			ram_mapper_[page] = value;
+
+			// Apply to RAM.
+			//
+			// On a real MSX this may also affect other slots.
+			// I've not yet needed it to propagate further, so
+			// have not implemented any onward route.
+			const uint16_t region = uint16_t(page << 14);
+			const size_t base = size_t(value) << 14;
+			if(base < RAMSize) {
+				ram_slot().template map<MemorySlot::AccessType::ReadWrite>(base, region, 0x4000);
+			} else {
+				ram_slot().unmap(region, 0x4000);
+			}
+		}
+
 		class i8255PortHandler: public Intel::i8255::PortHandler {
 			public:
 				i8255PortHandler(ConcreteMachine &machine, Audio::Toggle &audio_toggle, Storage::Tape::BinaryTapePlayer &tape_player) :
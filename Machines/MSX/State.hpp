@@ -0,0 +1,48 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "../../Reflection/Struct.hpp"
+#include "../../Processors/Z80/State/State.hpp"
+
+#include "../../Components/8255/i8255.hpp"
+#include "../../Components/9918/9918.hpp"
+#include "../../Components/AY38910/AY38910.hpp"
+
+#include <vector>
+
+namespace MSX {
+
+struct State: public Reflection::StructImpl<State> {
+	CPU::Z80::State z80;
+	TI::TMS::State vdp;
+	Intel::i8255::State i8255;
+	GI::AY38910::State ay;
+
+	// The full contents of main RAM; 64kb on an MSX 1, more on an MSX 2.
+	std::vector<uint8_t> ram;
+
+	// Paging. Primary slot selection is restored via the 8255.
+	uint8_t secondary_paging[4]{};
+	uint8_t ram_mapper[4]{};
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(z80);
+			DeclareField(vdp);
+			DeclareField(i8255);
+			DeclareField(ay);
+			DeclareField(ram);
+			DeclareField(secondary_paging);
+			DeclareField(ram_mapper);
+		}
+	}
+};
+
+}
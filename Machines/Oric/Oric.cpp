@@ -466,7 +466,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 					use_fast_tape_hack_ &&
 					operation == CPU::MOS6502::BusOperation::ReadOpcode &&
 					tape_player_.has_tape() &&
-					!tape_player_.get_tape()->is_at_end()) {
+					!tape_player_.is_at_end()) {
 
 					uint8_t next_byte = tape_player_.get_next_byte(!ram_[tape_speed_address_]);
 					m6502_.set_value_of(CPU::MOS6502Esque::A, next_byte);
@@ -476,8 +476,8 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 			} else {
 				if((address & 0xff00) == 0x0300) {
 					if(address < 0x0310 || (disk_interface == DiskInterface::None)) {
-						if(!isWriteOperation(operation)) *value = via_.read(address);
-						else via_.write(address, *value);
+						if(!isWriteOperation(operation)) *value = via_->read(address);
+						else via_->write(address, *value);
 					} else {
 						switch(disk_interface) {
 							default: break;
@@ -543,7 +543,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 				if(!string_serialiser_->advance()) string_serialiser_.reset();
 			}
 
-			via_.run_for(Cycles(1));
+			via_ += Cycles(1);
 			tape_player_.run_for(Cycles(1));
 			switch(disk_interface) {
 				default: break;
@@ -583,7 +583,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 				video_.flush();
 			}
 			if(outputs & Output::Audio) {
-				via_.flush();
+				via_->flush();
 			}
 			diskii_.flush();
 		}
@@ -611,6 +611,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 
 		void run_for(const Cycles cycles) final {
 			m6502_.run_for(cycles);
+			via_.flush();
 		}
 
 		// to satisfy MOS::MOS6522IRQDelegate::Delegate
@@ -621,7 +622,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 		// to satisfy Storage::Tape::BinaryTapePlayer::Delegate
 		void tape_did_change_input(Storage::Tape::BinaryTapePlayer *tape_player) final {
 			// set CB1
-			via_.set_control_line_input(MOS::MOS6522::Port::B, MOS::MOS6522::Line::One, !tape_player->get_input());
+			via_->set_control_line_input(MOS::MOS6522::Port::B, MOS::MOS6522::Line::One, !tape_player->get_input());
 		}
 
 		// for Utility::TypeRecipient::Delegate
@@ -723,7 +724,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 		bool use_fast_tape_hack_ = false;
 
 		VIAPortHandler via_port_handler_;
-		MOS::MOS6522::MOS6522<VIAPortHandler> via_;
+		JustInTimeActor<MOS::MOS6522::MOS6522<VIAPortHandler>> via_;
 		Keyboard keyboard_;
 
 		// the Microdisc, if in use.
@@ -747,7 +748,9 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 
 		// Helper to discern current IRQ state
 		inline void set_interrupt_line() {
-			bool irq_line = via_.get_interrupt_line();
+			// This may be called from within the VIA's own update, so shouldn't cause another;
+			// the VIA is flushed whenever its interrupt line could change.
+			bool irq_line = via_.last_valid()->get_interrupt_line();
 
 			// The Microdisc directly provides an interrupt line.
 			if constexpr (disk_interface == DiskInterface::Microdisc) {
@@ -305,7 +305,7 @@ class DMA {
 			}
 
 			const uint32_t address = uint32_t(pages.channel_page(channel) << 16) | access.first;
-			*memory_->at(address) = value;
+			memory_->access<uint8_t, Memory::AccessType::Write>(address) = value;
 			return access.second;
 		}
 
@@ -46,7 +46,12 @@ struct Memory {
 				// If this is a 16-bit access that runs past the end of the segment, it'll wrap back
 				// to the start. So the 16-bit value will need to be a local cache.
 				if(offset == 0xffff) {
-					return split_word<type>(physical_address, address(segment, 0));
+					const uint32_t high_address = address(segment, 0);
+					if constexpr (is_writeable(type)) {
+						did_write(physical_address);
+						did_write(high_address);
+					}
+					return split_word<type>(physical_address, high_address);
 				}
 			}
 
@@ -56,6 +61,13 @@ struct Memory {
 		// Accesses an address based on physical location.
 		template <typename IntT, AccessType type>
 		typename InstructionSet::x86::Accessor<IntT, type>::type access(uint32_t address) {
+			if constexpr (is_writeable(type)) {
+				did_write(address);
+				if constexpr (std::is_same_v<IntT, uint16_t>) {
+					did_write((address + 1) & 0xf'ffff);
+				}
+			}
+
 			// Dispense with the single-byte case trivially.
 			if constexpr (std::is_same_v<IntT, uint8_t>) {
 				return memory[address];
@@ -84,18 +96,26 @@ struct Memory {
 		void preauthorised_write(InstructionSet::x86::Source segment, uint16_t offset, IntT value) {
 			// Bytes can be written without further ado.
 			if constexpr (std::is_same_v<IntT, uint8_t>) {
-				memory[address(segment, offset) & 0xf'ffff] = value;
+				const uint32_t target = address(segment, offset) & 0xf'ffff;
+				did_write(target);
+				memory[target] = value;
 				return;
 			}
 
 			// Words that straddle the segment end must be split in two.
 			if(offset == 0xffff) {
-				memory[address(segment, offset) & 0xf'ffff] = value & 0xff;
-				memory[address(segment, 0x0000) & 0xf'ffff] = value >> 8;
+				const uint32_t low = address(segment, offset) & 0xf'ffff;
+				const uint32_t high = address(segment, 0x0000) & 0xf'ffff;
+				did_write(low);
+				did_write(high);
+				memory[low] = value & 0xff;
+				memory[high] = value >> 8;
 				return;
 			}
 
 			const uint32_t target = address(segment, offset) & 0xf'ffff;
+			did_write(target);
+			did_write((target + 1) & 0xf'ffff);
 
 			// Words that straddle the end of physical RAM must also be split in two.
 			if(target == 0xf'ffff) {
@@ -120,11 +140,24 @@ struct Memory {
 			return std::make_pair(memory.data(), 0x10'000);
 		}
 
+		//
+		// Write tracking, for the benefit of anything that caches decoded instructions.
+		//
+		static constexpr uint32_t WriteTrackingPageSize = 256;
+
+		/// @returns A count that changes whenever the WriteTrackingPageSize-byte page containing @c address is written to.
+		uint64_t write_generation(uint32_t address) const {
+			return write_generations_[address / WriteTrackingPageSize];
+		}
+
 		//
 		// External access.
 		//
 		void install(size_t address, const uint8_t *data, size_t length) {
 			std::copy(data, data + length, memory.begin() + std::vector<uint8_t>::difference_type(address));
+			for(size_t page = address / WriteTrackingPageSize; page * WriteTrackingPageSize < address + length; page++) {
+				++write_generations_[page];
+			}
 		}
 
 		uint8_t *at(uint32_t address) {
@@ -136,6 +169,11 @@ struct Memory {
 		Registers &registers_;
 		const Segments &segments_;
 
+		std::array<uint64_t, 1024*1024 / WriteTrackingPageSize> write_generations_{};
+		void did_write(uint32_t address) {
+			++write_generations_[address / WriteTrackingPageSize];
+		}
+
 		uint32_t segment_base(InstructionSet::x86::Source segment) {
 			using Source = InstructionSet::x86::Source;
 			switch(segment) {
@@ -22,6 +22,8 @@
 #include "../../InstructionSets/x86/Instruction.hpp"
 #include "../../InstructionSets/x86/Perform.hpp"
 
+#include "../../ClockReceiver/JustInTime.hpp"
+
 #include "../../Components/8255/i8255.hpp"
 #include "../../Components/8272/CommandDecoder.hpp"
 #include "../../Components/8272/Results.hpp"
@@ -359,6 +361,8 @@ class KeyboardController {
 		//; 00 - force clock line low, resetting keyboard, but on a 01->00 transition,
 		//;		IRQ1 would remain high
 		void set_mode(uint8_t mode) {
+			update();
+
 			const auto last_mode = mode_;
 			mode_ = Mode(mode);
 			switch(mode_) {
@@ -380,18 +384,23 @@ class KeyboardController {
 			}
 		}
 
-		void run_for(Cycles cycles) {
+		/// Applies all time that has accrued in @c cycles_since_update.
+		void update() {
+			const auto cycles = cycles_since_update.flush<Cycles>();
 			if(reset_delay_ <= 0) {
 				return;
 			}
 			reset_delay_ -= cycles.as<int>();
 			if(reset_delay_ <= 0) {
+				reset_delay_ = 0;
 				input_.clear();
 				post(0xaa);
 			}
 		}
 
 		uint8_t read() {
+			update();
+
 			pic_.apply_edge<1>(false);
 			if(input_.empty()) {
 				return 0;
@@ -406,6 +415,8 @@ class KeyboardController {
 		}
 
 		void post(uint8_t value) {
+			update();
+
 			if(mode_ != Mode::NormalOperation || reset_delay_) {
 				return;
 			}
@@ -413,6 +424,8 @@ class KeyboardController {
 			pic_.apply_edge<1>(true);
 		}
 
+		Cycles cycles_since_update = 0;
+
 	private:
 		enum class Mode {
 			NormalOperation = 0b01,
@@ -590,13 +603,75 @@ class i8255PortHandler : public Intel::i8255::PortHandler {
 };
 using PPI = Intel::i8255::i8255<i8255PortHandler>;
 
+/*!
+	Accumulates time that the CPU has spent but which hasn't yet been applied to the PIT, speaker, video and keyboard,
+	allowing the CPU to run batches of instructions without per-instruction bookkeeping for each.
+*/
+template <Target::VideoAdaptor video>
+class PeripheralClock {
+	public:
+		PeripheralClock(JustInTimeActor<PIT, Cycles> &pit, PCSpeaker &speaker, JustInTimeActor<typename Adaptor<video>::type, Cycles> &card, KeyboardController &keyboard) :
+			pit_(pit), speaker_(speaker), video_(card), keyboard_(keyboard) {}
+
+		/// Records that @c duration has passed, comprising @c ticks CPU ticks, without yet applying it.
+		void defer(Cycles duration, int ticks) {
+			pending_ += duration;
+			pending_ticks_ += ticks;
+		}
+
+		/// Applies all deferred time.
+		void apply() {
+			if(!pending_ticks_) return;
+
+			// Advance the speaker and PIT together to each point at which the PIT might change output, so that
+			// changes to channel 2 reach the speaker at the proper time.
+			const Cycles total = pending_;
+			while(pending_ > Cycles(0)) {
+				const Cycles step = std::min(pending_, pit_.cycles_until_implicit_flush());
+				speaker_.cycles_since_update += step;
+				pit_ += step;
+				pending_ -= step;
+			}
+
+			video_ += total;
+			keyboard_.cycles_since_update += Cycles(pending_ticks_);
+			pending_ticks_ = 0;
+		}
+
+		/// Applies all deferred time ahead of an I/O access, which might change when peripherals next need attention.
+		void synchronise() {
+			apply();
+			did_synchronise_ = true;
+		}
+
+		/// @returns @c true if @c synchronise has been called since this method was last called.
+		bool did_synchronise() {
+			const bool result = did_synchronise_;
+			did_synchronise_ = false;
+			return result;
+		}
+
+	private:
+		JustInTimeActor<PIT, Cycles> &pit_;
+		PCSpeaker &speaker_;
+		JustInTimeActor<typename Adaptor<video>::type, Cycles> &video_;
+		KeyboardController &keyboard_;
+
+		Cycles pending_;
+		int pending_ticks_ = 0;
+		bool did_synchronise_ = false;
+};
+
 template <Target::VideoAdaptor video>
 class IO {
 	public:
-		IO(PIT &pit, DMA &dma, PPI &ppi, PIC &pic, typename Adaptor<video>::type &card, FloppyController &fdc, RTC &rtc) :
-			pit_(pit), dma_(dma), ppi_(ppi), pic_(pic), video_(card), fdc_(fdc), rtc_(rtc) {}
+		IO(PeripheralClock<video> &clock, JustInTimeActor<PIT, Cycles> &pit, DMA &dma, PPI &ppi, PIC &pic, JustInTimeActor<typename Adaptor<video>::type, Cycles> &card, FloppyController &fdc, RTC &rtc) :
+			clock_(clock), pit_(pit), dma_(dma), ppi_(ppi), pic_(pic), video_(card), fdc_(fdc), rtc_(rtc) {}
 
 		template <typename IntT> void out(uint16_t port, IntT value) {
+			// Bring peripherals up to date, so that the access occurs at the current instant.
+			clock_.synchronise();
+
 			static constexpr uint16_t crtc_base =
 				video == Target::VideoAdaptor::MDA ? 0x03b0 : 0x03d0;
 
@@ -637,10 +712,10 @@ class IO {
 				case 0x0020:	pic_.write<0>(uint8_t(value));	break;
 				case 0x0021:	pic_.write<1>(uint8_t(value));	break;
 
-				case 0x0040:	pit_.write<0>(uint8_t(value));	break;
-				case 0x0041:	pit_.write<1>(uint8_t(value));	break;
-				case 0x0042:	pit_.write<2>(uint8_t(value));	break;
-				case 0x0043:	pit_.set_mode(uint8_t(value));	break;
+				case 0x0040:	pit_->write<0>(uint8_t(value));	break;
+				case 0x0041:	pit_->write<1>(uint8_t(value));	break;
+				case 0x0042:	pit_->write<2>(uint8_t(value));	break;
+				case 0x0043:	pit_->set_mode(uint8_t(value));	break;
 
 				case 0x0060:	case 0x0061:	case 0x0062:	case 0x0063:
 				case 0x0064:	case 0x0065:	case 0x0066:	case 0x0067:
@@ -664,24 +739,24 @@ class IO {
 				case crtc_base + 0:		case crtc_base + 2:
 				case crtc_base + 4:		case crtc_base + 6:
 					if constexpr (std::is_same_v<IntT, uint16_t>) {
-						video_.template write<0>(uint8_t(value));
-						video_.template write<1>(uint8_t(value >> 8));
+						video_->template write<0>(uint8_t(value));
+						video_->template write<1>(uint8_t(value >> 8));
 					} else {
-						video_.template write<0>(value);
+						video_->template write<0>(value);
 					}
 				break;
 				case crtc_base + 1:		case crtc_base + 3:
 				case crtc_base + 5:		case crtc_base + 7:
 					if constexpr (std::is_same_v<IntT, uint16_t>) {
-						video_.template write<1>(uint8_t(value));
-						video_.template write<0>(uint8_t(value >> 8));
+						video_->template write<1>(uint8_t(value));
+						video_->template write<0>(uint8_t(value >> 8));
 					} else {
-						video_.template write<1>(value);
+						video_->template write<1>(value);
 					}
 				break;
 
-				case crtc_base + 0x8:	video_.template write<0x8>(uint8_t(value));	break;
-				case crtc_base + 0x9:	video_.template write<0x9>(uint8_t(value));	break;
+				case crtc_base + 0x8:	video_->template write<0x8>(uint8_t(value));	break;
+				case crtc_base + 0x9:	video_->template write<0x9>(uint8_t(value));	break;
 
 				case 0x03f2:
 					fdc_.set_digital_output(uint8_t(value));
@@ -712,6 +787,8 @@ class IO {
 			}
 		}
 		template <typename IntT> IntT in([[maybe_unused]] uint16_t port) {
+			clock_.synchronise();
+
 			switch(port) {
 				default:
 					printf("Unhandled in: %04x\n", port);
@@ -736,9 +813,9 @@ class IO {
 				case 0x0020:	return pic_.read<0>();
 				case 0x0021:	return pic_.read<1>();
 
-				case 0x0040:	return pit_.read<0>();
-				case 0x0041:	return pit_.read<1>();
-				case 0x0042:	return pit_.read<2>();
+				case 0x0040:	return pit_->read<0>();
+				case 0x0041:	return pit_->read<1>();
+				case 0x0042:	return pit_->read<2>();
 
 				case 0x0060:	case 0x0061:	case 0x0062:	case 0x0063:
 				case 0x0064:	case 0x0065:	case 0x0066:	case 0x0067:
@@ -770,13 +847,13 @@ class IO {
 
 				case 0x03b8:
 					if constexpr (video == Target::VideoAdaptor::MDA) {
-						return video_.template read<0x8>();
+						return video_->template read<0x8>();
 					}
 				break;
 
 				case 0x3da:
 					if constexpr (video == Target::VideoAdaptor::CGA) {
-						return video_.template read<0xa>();
+						return video_->template read<0xa>();
 					}
 				break;
 
@@ -795,11 +872,12 @@ class IO {
 		}
 
 	private:
-		PIT &pit_;
+		PeripheralClock<video> &clock_;
+		JustInTimeActor<PIT, Cycles> &pit_;
 		DMA &dma_;
 		PPI &ppi_;
 		PIC &pic_;
-		typename Adaptor<video>::type &video_;
+		JustInTimeActor<typename Adaptor<video>::type, Cycles> &video_;
 		FloppyController &fdc_;
 		RTC &rtc_;
 };
@@ -882,7 +960,8 @@ class ConcreteMachine:
 			ppi_handler_(speaker_, keyboard_, video, DriveCount),
 			pit_(pit_observer_),
 			ppi_(ppi_handler_),
-			context(pit_, dma_, ppi_, pic_, video_, fdc_, rtc_)
+			clock_(pit_, speaker_, video_, keyboard_),
+			context(clock_, pit_, dma_, ppi_, pic_, video_, fdc_, rtc_)
 		{
 			// Capture speed.
 			speed_ = target.speed;
@@ -918,7 +997,7 @@ class ConcreteMachine:
 
 			// Give the video card something to read from.
 			const auto &font_contents = roms.find(font)->second;
-			video_.set_source(context.memory.at(Video::BaseAddress), font_contents);
+			video_->set_source(context.memory.at(Video::BaseAddress), font_contents);
 
 			// ... and insert media.
 			insert_media(target.media);
@@ -949,72 +1028,92 @@ class ConcreteMachine:
 				cpu_divisor_ %= 3;
 			}
 
-			while(ticks--) {
-				//
-				// First draft: all hardware runs in lockstep, as a multiple or divisor of the PIT frequency.
-				//
-
-				//
-				// Advance the PIT and audio.
-				//
-				pit_.run_for(1);
-				++speaker_.cycles_since_update;
-
-				// For original speed, the CPU performs instructions at a 1/3rd divider of the PIT clock,
-				// so run the PIT three times per 'tick'.
-				if constexpr (speed == Target::Speed::ApproximatelyOriginal) {
-					pit_.run_for(1);
-					++speaker_.cycles_since_update;
-					pit_.run_for(1);
-					++speaker_.cycles_since_update;
-				}
-
-				//
-				// Advance CRTC at a more approximate rate.
-				//
-				video_.run_for(speed == Target::Speed::Fast ? Cycles(1) : Cycles(3));
-
-				//
-				// Give the keyboard a notification of passing time; it's very approximately clocked,
-				// really just including 'some' delays to avoid being instant.
-				//
-				keyboard_.run_for(Cycles(1));
+			// Peripherals are advanced lazily: the PIT is updated only when accessed or when its output
+			// might next change, which is what causes interrupts and audio changes; the CRTC is updated
+			// when accessed and otherwise at least once per scanline.
+			//
+			// So the CPU runs in batches that end with the tick in which either of those things might next
+			// happen; time is applied to peripherals only at the end of each batch, or upon I/O. Since I/O
+			// might change when the PIT next needs attention, it also ends the batch.
+			constexpr Cycles tick_length = speed == Target::Speed::Fast ? Cycles(1) : Cycles(3);
+			constexpr Cycles::IntType cycles_per_tick = tick_length.as_integral();
+			const auto ticks_until = [](Cycles time) {
+				return (std::max(time.as_integral(), Cycles::IntType(1)) + cycles_per_tick - 1) / cycles_per_tick;
+			};
+			while(ticks) {
+				const int batch = int(std::min({
+					Cycles::IntType(ticks),
+					ticks_until(pit_.cycles_until_implicit_flush()),
+					ticks_until(PeripheralUpdateInterval - video_.time_since_flush()),
+				}));
+				ticks -= batch;
+				clock_.did_synchronise();
+
+				for(int tick = 0; tick < batch; tick++) {
+					//
+					// Advance the PIT and audio; for original speed, the CPU performs instructions at
+					// a 1/3rd divider of the PIT clock, so the PIT runs three times per 'tick'.
+					//
+					// Advance CRTC at a more approximate rate; the keyboard similarly gets only a very
+					// approximate notification of passing time, really just including 'some' delays to
+					// avoid being instant.
+					//
+					clock_.defer(tick_length, 1);
+					if(tick == batch - 1) {
+						clock_.apply();
+						if(video_.time_since_flush() >= PeripheralUpdateInterval) {
+							update_peripherals();
+						}
+					}
 
-				//
-				// Perform one CPU instruction every three PIT cycles.
-				// i.e. CPU instruction rate is 1/3 * ~1.19Mhz ~= 0.4 MIPS.
-				//
+					//
+					// Perform one CPU instruction every three PIT cycles.
+					// i.e. CPU instruction rate is 1/3 * ~1.19Mhz ~= 0.4 MIPS.
+					//
+
+					// Query for interrupts and apply if pending.
+					if(pic_.pending() && context.flags.template flag<InstructionSet::x86::Flag::Interrupt>()) {
+						// Regress the IP if a REP is in-progress so as to resume it later.
+						if(context.flow_controller.should_repeat()) {
+							context.registers.ip() = decoded_ip_;
+							context.flow_controller.begin_instruction();
+						}
 
-				// Query for interrupts and apply if pending.
-				if(pic_.pending() && context.flags.template flag<InstructionSet::x86::Flag::Interrupt>()) {
-					// Regress the IP if a REP is in-progress so as to resume it later.
-					if(context.flow_controller.should_repeat()) {
-						context.registers.ip() = decoded_ip_;
-						context.flow_controller.begin_instruction();
+						// Signal interrupt.
+						context.flow_controller.unhalt();
+						InstructionSet::x86::interrupt(
+							pic_.acknowledge(),
+							context
+						);
 					}
 
-					// Signal interrupt.
-					context.flow_controller.unhalt();
-					InstructionSet::x86::interrupt(
-						pic_.acknowledge(),
-						context
-					);
-				}
+					// Do nothing if currently halted; nothing can end the halt before the final tick
+					// of the batch, so skip straight to it.
+					if(context.flow_controller.halted()) {
+						const int idle_ticks = batch - 2 - tick;
+						if(idle_ticks > 0) {
+							clock_.defer(tick_length * Cycles(idle_ticks), idle_ticks);
+							tick += idle_ticks;
+						}
+						continue;
+					}
 
-				// Do nothing if currently halted.
-				if(context.flow_controller.halted()) {
-					continue;
-				}
+					if constexpr (speed == Target::Speed::Fast) {
+						// There's no divider applied, so this makes for 2*PIT = around 2.4 MIPS.
+						// That's broadly 80286 speed, if MIPS were a valid measure.
+						perform_instruction();
+						perform_instruction();
+					} else {
+						// With the clock divider above, this makes for a net of PIT/3 = around 0.4 MIPS.
+						// i.e. a shade more than 8086 speed, if MIPS were meaningful.
+						perform_instruction();
+					}
 
-				if constexpr (speed == Target::Speed::Fast) {
-					// There's no divider applied, so this makes for 2*PIT = around 2.4 MIPS.
-					// That's broadly 80286 speed, if MIPS were a valid measure.
-					perform_instruction();
-					perform_instruction();
-				} else {
-					// With the clock divider above, this makes for a net of PIT/3 = around 0.4 MIPS.
-					// i.e. a shade more than 8086 speed, if MIPS were meaningful.
-					perform_instruction();
+					if(clock_.did_synchronise()) {
+						clock_.apply();
+						ticks += batch - 1 - tick;
+						break;
+					}
 				}
 
 				// Other inevitably broad and fuzzy and inconsistent MIPS counts for my own potential future play:
@@ -1023,21 +1122,51 @@ class ConcreteMachine:
 				// 80486 @ 66Mhz: 25 MIPS.
 				// Pentium @ 100Mhz: 188 MIPS.
 			}
+
+			update_peripherals();
+		}
+
+		// The CGA's line length is 912 pixels at 12x the PIT clock, i.e. 76 PIT cycles.
+		static constexpr Cycles PeripheralUpdateInterval = Cycles(76);
+
+		void update_peripherals() {
+			video_.flush();
+			keyboard_.update();
 		}
 
 		void perform_instruction() {
 			// Get the next thing to execute.
 			if(!context.flow_controller.should_repeat()) {
-				// Decode from the current IP.
 				decoded_ip_ = context.registers.ip();
-				const auto remainder = context.memory.next_code();
-				decoded = decoder.decode(remainder.first, remainder.second);
-
-				// If that didn't yield a whole instruction then the end of memory must have been hit;
-				// continue from the beginning.
-				if(decoded.first <= 0) {
-					const auto all = context.memory.all();
-					decoded = decoder.decode(all.first, all.second);
+
+				// Use a cached decoding if there is one and the page it came from hasn't been written to since.
+				const uint32_t linear_ip = (context.segments.cs_base_ + decoded_ip_) & 0xf'ffff;
+				auto &cached = instruction_cache_[linear_ip & (InstructionCacheSize - 1)];
+				const auto generation = context.memory.write_generation(linear_ip);
+				if(cached.address == linear_ip && cached.generation == generation) {
+					decoded.first = cached.length;
+					decoded.second = cached.instruction;
+				} else {
+					// Decode from the current IP.
+					const auto remainder = context.memory.next_code();
+					decoded = decoder.decode(remainder.first, remainder.second);
+
+					// If that didn't yield a whole instruction then the end of memory must have been hit;
+					// continue from the beginning.
+					if(decoded.first <= 0) {
+						const auto all = context.memory.all();
+						decoded = decoder.decode(all.first, all.second);
+					} else if(
+						(linear_ip / Memory::WriteTrackingPageSize) ==
+						((linear_ip + uint32_t(decoded.first) - 1) / Memory::WriteTrackingPageSize)
+					) {
+						// Cache only instructions that sit entirely within a single page, so that
+						// a single generation test is sufficient.
+						cached.address = linear_ip;
+						cached.generation = generation;
+						cached.length = decoded.first;
+						cached.instruction = decoded.second;
+					}
 				}
 
 				context.registers.ip() += decoded.first;
@@ -1074,10 +1203,10 @@ class ConcreteMachine:
 
 		// MARK: - ScanProducer.
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) override {
-			video_.set_scan_target(scan_target);
+			video_->set_scan_target(scan_target);
 		}
 		Outputs::Display::ScanStatus get_scaled_scan_status() const override {
-			return video_.get_scaled_scan_status();
+			return video_.last_valid()->get_scaled_scan_status();
 		}
 
 		// MARK: - AudioProducer.
@@ -1130,39 +1259,40 @@ class ConcreteMachine:
 		}
 
 		void set_display_type(Outputs::Display::DisplayType display_type) override {
-			video_.set_display_type(display_type);
+			video_->set_display_type(display_type);
 
 			// Give the PPI a shout-out in case it isn't too late to switch to CGA40.
 			ppi_handler_.hint_is_composite(Outputs::Display::is_composite(display_type));
 		}
 
 		Outputs::Display::DisplayType get_display_type() const override {
-			return video_.get_display_type();
+			return video_.last_valid()->get_display_type();
 		}
 
 	private:
 		PIC pic_;
 		DMA dma_;
 		PCSpeaker speaker_;
-		Video video_;
+		JustInTimeActor<Video, Cycles> video_;
 
 		KeyboardController keyboard_;
 		FloppyController fdc_;
 		PITObserver pit_observer_;
 		i8255PortHandler ppi_handler_;
 
-		PIT pit_;
+		JustInTimeActor<PIT, Cycles> pit_;
 		PPI ppi_;
 		RTC rtc_;
+		PeripheralClock<video> clock_;
 
 		PCCompatible::KeyboardMapper keyboard_mapper_;
 
 		struct Context {
-			Context(PIT &pit, DMA &dma, PPI &ppi, PIC &pic, typename Adaptor<video>::type &card, FloppyController &fdc, RTC &rtc) :
+			Context(PeripheralClock<video> &clock, JustInTimeActor<PIT, Cycles> &pit, DMA &dma, PPI &ppi, PIC &pic, JustInTimeActor<Video, Cycles> &card, FloppyController &fdc, RTC &rtc) :
 				segments(registers),
 				memory(registers, segments),
 				flow_controller(registers, segments),
-				io(pit, dma, ppi, pic, card, fdc, rtc)
+				io(clock, pit, dma, ppi, pic, card, fdc, rtc)
 			{
 				reset();
 			}
@@ -1189,6 +1319,17 @@ class ConcreteMachine:
 		uint16_t decoded_ip_ = 0;
 		std::pair<int, InstructionSet::x86::Instruction<false>> decoded;
 
+		// A direct-mapped cache of decoded instructions, keyed by linear address and
+		// validated against Memory's write generations.
+		struct CachedInstruction {
+			uint32_t address = ~uint32_t(0);
+			int length = 0;
+			uint64_t generation = 0;
+			InstructionSet::x86::Instruction<false> instruction;
+		};
+		static constexpr size_t InstructionCacheSize = 8192;
+		std::array<CachedInstruction, InstructionCacheSize> instruction_cache_;
+
 		int cpu_divisor_ = 0;
 		Target::Speed speed_{};
 };
@@ -8,6 +8,10 @@
 
 #pragma once
 
+#include "../../ClockReceiver/ClockReceiver.hpp"
+
+#include <algorithm>
+
 namespace PCCompatible {
 
 template <bool is_8254, typename PITObserver>
@@ -38,13 +42,19 @@ class i8253 {
 		}
 
 		void run_for(Cycles cycles) {
-			// TODO: be intelligent enough to take ticks outside the loop when appropriate.
-			auto ticks = cycles.as<int>();
-			while(ticks--) {
-				channels_[0].template advance<0>(observer_, 1);
-				channels_[1].template advance<1>(observer_, 1);
-				channels_[2].template advance<2>(observer_, 1);
-			}
+			const auto ticks = cycles.as<int>();
+			channels_[0].template advance<0>(observer_, ticks);
+			channels_[1].template advance<1>(observer_, ticks);
+			channels_[2].template advance<2>(observer_, ticks);
+		}
+
+		/// @returns The amount of time until any channel might next change its output.
+		Cycles next_sequence_point() const {
+			return std::min({
+				channels_[0].next_output_change(),
+				channels_[1].next_output_change(),
+				channels_[2].next_output_change(),
+			});
 		}
 
 	private:
@@ -144,12 +154,13 @@ class i8253 {
 
 					case OperatingMode::SquareWaveGenerator: {
 						ticks <<= 1;
-						do {
+						while(true) {
 							// If there's a step from 1 to 0 within the next batch of ticks,
-							// toggle output and apply a reload.
-							if(counter && ticks >= counter) {
+							// toggle output and apply a reload. A counter of 0 acts as 65536.
+							const int count = counter ? counter : 0x1'0000;
+							if(ticks >= count) {
 								set_output<channel>(observer, output ^ true);
-								ticks -= counter;
+								ticks -= count;
 
 								const uint16_t reload_mask = output ? 0xffff : 0xfffe;
 								counter = reload & reload_mask;
@@ -157,16 +168,18 @@ class i8253 {
 								continue;
 							}
 							counter -= ticks;
-						} while(false);
+							break;
+						}
 					} break;
 
 					case OperatingMode::RateGenerator:
-						do {
+						while(true) {
 							// Check for a step from 2 to 1 within the next batch of ticks, which would cause output
-							// to go high.
-							if(counter > 1 && ticks >= counter - 1) {
+							// to go high. A counter of 0 acts as 65536.
+							const int count = counter ? counter : 0x1'0000;
+							if(count > 1 && ticks >= count - 1) {
 								set_output<channel>(observer, true);
-								ticks -= counter - 1;
+								ticks -= count - 1;
 								counter = 1;
 								continue;
 							}
@@ -181,7 +194,8 @@ class i8253 {
 
 							// Otherwise, just continue.
 							counter -= ticks;
-						} while(false);
+							break;
+						}
 					break;
 
 					default:
@@ -190,6 +204,28 @@ class i8253 {
 				}
 			}
 
+			/// @returns A lower bound on the number of ticks until this channel's output might change.
+			Cycles next_output_change() const {
+				if(gated || awaiting_reload) return Cycles::max();
+
+				switch(mode) {
+					case OperatingMode::InterruptOnTerminalCount:
+					case OperatingMode::HardwareRetriggerableOneShot:
+						if(output) return Cycles::max();
+					return Cycles(std::max(int(counter), 1));
+
+					case OperatingMode::SquareWaveGenerator:
+						// The counter decrements by two per tick; a counter of 0 will wrap around.
+					return Cycles(counter ? (counter + 1) >> 1 : 0x8000);
+
+					case OperatingMode::RateGenerator:
+					return Cycles(counter != 1 ? (counter ? counter : 0x1'0000) - 1 : 1);
+
+					default:
+					return Cycles::max();
+				}
+			}
+
 			template <int channel>
 			void write([[maybe_unused]] PITObserver &observer, uint8_t value) {
 				switch(latch_mode) {
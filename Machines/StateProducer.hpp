@@ -8,16 +8,68 @@
 
 #pragma once
 
+#include "../Reflection/Struct.hpp"
+
+#include <cstdint>
 #include <memory>
-#include "../Analyser/Static/StaticAnalyser.hpp"
+#include <vector>
 
 namespace MachineTypes {
 
+/*!
+	A state producer is any machine that can capture a complete snapshot of itself — processor,
+	support chips, memory and the timing relationships between them — and later be restored
+	from such a snapshot.
+
+	Inserted media is not part of the snapshot; it is the owner's responsibility to insert the
+	same media before restoring.
+*/
 struct StateProducer {
-	// TODO.
-//	virtual bool get_state(Analyser::Static::State *, [[maybe_unused]] bool advance_to_simple = false) {
-//		return false;
-//	}
-};
+	/*!
+		@returns A snapshot of the machine's current state, or @c nullptr if one cannot currently be
+			taken. The snapshot is a reflective struct, so can be serialised via @c Reflection::Struct::serialise.
+	*/
+	virtual std::unique_ptr<Reflection::Struct> get_state() = 0;
+
+	/*!
+		Captures the machine's current state into @c state, which should have been obtained from
+		@c get_state on this machine. Existing storage within @c state is reused, making this
+		the cheaper option for repeated captures.
+
+		@returns @c true if the state was captured; @c false otherwise.
+	*/
+	virtual bool get_state(Reflection::Struct &state) = 0;
 
+	/*!
+		Restores the machine to @c state, which should have been obtained from @c get_state on
+		a machine of the same type and model.
+
+		@returns @c true if the state was applied; @c false otherwise.
+	*/
+	virtual bool set_state(const Reflection::Struct &state) = 0;
+
+	/*!
+		@returns A BSON serialisation of the machine's current state, or an empty vector if
+			a snapshot cannot currently be taken.
+	*/
+	std::vector<uint8_t> serialise_state() {
+		const auto state = get_state();
+		if(!state) return {};
+		return state->serialise();
+	}
+
+	/*!
+		Restores the machine from a BSON serialisation previously obtained from @c serialise_state.
+
+		@returns @c true if the state was applied; @c false otherwise.
+	*/
+	bool deserialise_state(const std::vector<uint8_t> &bson) {
+		// Obtain a struct of the correct type by capturing current state, then overlay
+		// the serialised version.
+		auto state = get_state();
+		if(!state || !state->deserialise(bson)) return false;
+		return set_state(*state);
+	}
 };
+
+}
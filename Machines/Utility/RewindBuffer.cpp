@@ -0,0 +1,255 @@
+//
+//  RewindBuffer.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "RewindBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Machine;
+
+namespace {
+
+/*
+	Encoded states are a sequence of:
+
+		varint	number of unchanged bytes
+		varint	number of changed bytes, n
+		n bytes	the exclusive OR of each changed byte and its original
+
+	... until the whole state is accounted for. Varints are unsigned LEB128.
+*/
+
+/// The number of consecutive unchanged bytes that will end a run of changed bytes; shorter gaps
+/// are cheaper to include as changes than to describe separately.
+constexpr size_t MinimumUnchangedRun = 4;
+
+void push_varint(std::vector<uint8_t> &target, size_t value) {
+	while(value >= 0x80) {
+		target.push_back(uint8_t(value | 0x80));
+		value >>= 7;
+	}
+	target.push_back(uint8_t(value));
+}
+
+size_t read_varint(const uint8_t *&source) {
+	size_t value = 0;
+	int shift = 0;
+	uint8_t next;
+	do {
+		next = *source;
+		++source;
+		value |= size_t(next & 0x7f) << shift;
+		shift += 7;
+	} while(next & 0x80);
+	return value;
+}
+
+template <bool is_delta> void encode(std::vector<uint8_t> &target, const uint8_t *source, const uint8_t *reference, size_t size) {
+	const auto difference = [source, reference] (size_t index) -> uint8_t {
+		if constexpr (is_delta) {
+			return source[index] ^ reference[index];
+		} else {
+			return source[index];
+		}
+	};
+
+	size_t index = 0;
+	while(index < size) {
+		// Skip unchanged bytes, a word at a time where possible.
+		const size_t unchanged_start = index;
+		while(index + sizeof(uint64_t) <= size) {
+			uint64_t lhs, rhs = 0;
+			memcpy(&lhs, &source[index], sizeof(lhs));
+			if constexpr (is_delta) {
+				memcpy(&rhs, &reference[index], sizeof(rhs));
+			}
+			if(lhs != rhs) break;
+			index += sizeof(uint64_t);
+		}
+		while(index < size && !difference(index)) ++index;
+		push_varint(target, index - unchanged_start);
+
+		// Find the end of the changed bytes.
+		const size_t changed_start = index;
+		size_t changed_end = index;
+		while(index < size) {
+			if(difference(index)) {
+				changed_end = ++index;
+			} else if(++index - changed_end == MinimumUnchangedRun) {
+				break;
+			}
+		}
+		index = changed_end;
+
+		push_varint(target, changed_end - changed_start);
+		for(size_t c = changed_start; c < changed_end; c++) {
+			target.push_back(difference(c));
+		}
+	}
+}
+
+}
+
+RewindBuffer::RewindBuffer(MachineTypes::StateProducer &producer, size_t memory_limit, int frames_per_state, int states_per_keyframe) :
+	producer_(producer),
+	frames_per_state_(std::max(frames_per_state, 1)),
+	states_per_keyframe_(std::max(states_per_keyframe, 1)),
+	arena_(memory_limit) {}
+
+void RewindBuffer::advance_frame() {
+	if(frames_until_capture_) {
+		--frames_until_capture_;
+		return;
+	}
+
+	frames_until_capture_ = frames_per_state_ - 1;
+	capture();
+}
+
+bool RewindBuffer::capture() {
+	if(state_) {
+		if(!producer_.get_state(*state_)) return false;
+	} else {
+		state_ = producer_.get_state();
+		if(!state_) return false;
+	}
+	state_->serialise(serialised_);
+
+	bool is_keyframe =
+		entries_.empty() ||
+		states_since_keyframe_ >= states_per_keyframe_ ||
+		serialised_.size() != reference_.size();
+	encode(is_keyframe);
+
+	// If storing a delta caused its keyframe to be discarded, store a keyframe instead.
+	if(!store(is_keyframe)) {
+		if(is_keyframe) return false;
+
+		is_keyframe = true;
+		encode(is_keyframe);
+		if(!store(is_keyframe)) return false;
+	}
+
+	if(is_keyframe) {
+		reference_ = serialised_;
+		states_since_keyframe_ = 0;
+	} else {
+		++states_since_keyframe_;
+	}
+	return true;
+}
+
+bool RewindBuffer::rewind(size_t count) {
+	if(!count || count > entries_.size()) return false;
+
+	entries_.erase(entries_.end() - ptrdiff_t(count - 1), entries_.end());
+	const Entry target = entries_.back();
+	entries_.pop_back();
+	write_pointer_ = entries_.empty() ? 0 : entries_.back().offset + entries_.back().length;
+	frames_until_capture_ = frames_per_state_ - 1;
+
+	if(target.is_keyframe) {
+		decode(target, serialised_, reference_);
+		reference_ = serialised_;
+
+		// The keyframe itself is gone, so the next state captured will need to be a keyframe.
+		states_since_keyframe_ = states_per_keyframe_;
+	} else {
+		// The oldest entry is always a keyframe, so one will be found.
+		const auto keyframe = std::find_if(entries_.rbegin(), entries_.rend(), [] (const Entry &entry) {
+			return entry.is_keyframe;
+		});
+		decode(*keyframe, reference_, reference_);
+		decode(target, serialised_, reference_);
+		states_since_keyframe_ = int(keyframe - entries_.rbegin());
+	}
+
+	return state_->deserialise(serialised_) && producer_.set_state(*state_);
+}
+
+void RewindBuffer::clear() {
+	entries_.clear();
+	write_pointer_ = 0;
+	states_since_keyframe_ = 0;
+	frames_until_capture_ = 0;
+}
+
+size_t RewindBuffer::memory_used() const {
+	size_t total = 0;
+	for(const auto &entry: entries_) {
+		total += entry.length;
+	}
+	return total;
+}
+
+void RewindBuffer::encode(bool is_keyframe) {
+	encoded_.clear();
+	if(is_keyframe) {
+		::encode<false>(encoded_, serialised_.data(), nullptr, serialised_.size());
+	} else {
+		::encode<true>(encoded_, serialised_.data(), reference_.data(), serialised_.size());
+	}
+}
+
+void RewindBuffer::decode(const Entry &entry, std::vector<uint8_t> &target, const std::vector<uint8_t> &reference) const {
+	if(entry.is_keyframe) {
+		target.assign(entry.state_size, 0);
+	} else if(&target != &reference) {
+		target = reference;
+	}
+
+	const uint8_t *source = &arena_[entry.offset];
+	const uint8_t *const end = source + entry.length;
+	size_t index = 0;
+	while(source < end) {
+		index += read_varint(source);
+
+		const size_t changed = read_varint(source);
+		for(size_t c = 0; c < changed; c++) {
+			target[index] ^= *source;
+			++index;
+			++source;
+		}
+	}
+}
+
+bool RewindBuffer::store(bool is_keyframe) {
+	const size_t length = encoded_.size();
+	if(length > arena_.size()) return false;
+
+	// Place the new state after the newest, or at the start of the arena if it won't fit there.
+	if(entries_.empty()) write_pointer_ = 0;
+	size_t offset = write_pointer_;
+	if(offset + length > arena_.size()) {
+		// Anything after the write pointer is older than everything before it.
+		while(!entries_.empty() && entries_.front().offset >= offset) {
+			entries_.pop_front();
+		}
+		offset = 0;
+	}
+
+	// Discard the oldest states for as long as they overlap the new one, and then any that
+	// have thereby lost their keyframe.
+	while(
+		!entries_.empty() &&
+		entries_.front().offset < offset + length &&
+		entries_.front().offset + entries_.front().length > offset
+	) {
+		entries_.pop_front();
+	}
+	while(!entries_.empty() && !entries_.front().is_keyframe) {
+		entries_.pop_front();
+	}
+	if(!is_keyframe && entries_.empty()) return false;
+
+	std::copy(encoded_.begin(), encoded_.end(), arena_.begin() + ptrdiff_t(offset));
+	entries_.push_back(Entry{offset, length, serialised_.size(), is_keyframe});
+	write_pointer_ = offset + length;
+	return true;
+}
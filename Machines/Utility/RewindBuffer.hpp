@@ -0,0 +1,113 @@
+//
+//  RewindBuffer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "../StateProducer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Maintains a history of machine states within a fixed memory budget, from which the machine
+	can subsequently be rewound.
+
+	States are stored as BSON, each being the exclusive OR of itself and the most recent keyframe,
+	run-length encoded. Consecutive states tend to differ only slightly so the exclusive OR is
+	mostly zeroes and compresses well. Keyframes are stored the same way, relative to zero.
+
+	Storage is a ring: once the budget is reached the oldest states are discarded.
+*/
+class RewindBuffer {
+	public:
+		/*!
+			@param producer The machine to capture and restore.
+			@param memory_limit The maximum number of bytes to use for encoded states.
+			@param frames_per_state The number of calls to @c advance_frame between each capture.
+			@param states_per_keyframe The maximum number of states captured relative to each keyframe.
+		*/
+		RewindBuffer(
+			MachineTypes::StateProducer &producer,
+			size_t memory_limit = 8 * 1024 * 1024,
+			int frames_per_state = 5,
+			int states_per_keyframe = 60);
+
+		/// Indicates that a frame has elapsed, capturing a new state if one is due.
+		void advance_frame();
+
+		/// Captures a new state immediately.
+		/// @returns @c true if the state was captured; @c false otherwise.
+		bool capture();
+
+		/*!
+			Restores the machine to the @c count th most-recent state, discarding that state
+			and all that are newer.
+
+			@returns @c true if a state was restored; @c false otherwise.
+		*/
+		bool rewind(size_t count = 1);
+
+		/// Discards all captured states.
+		void clear();
+
+		/// @returns The number of states currently held.
+		size_t size() const {
+			return entries_.size();
+		}
+
+		/// @returns The number of bytes currently occupied by encoded states.
+		size_t memory_used() const;
+
+	private:
+		MachineTypes::StateProducer &producer_;
+		const int frames_per_state_;
+		const int states_per_keyframe_;
+		int frames_until_capture_ = 0;
+
+		// A state struct reused for every capture and restoration, and the serialisation of whatever
+		// state was most-recently captured or restored.
+		std::unique_ptr<Reflection::Struct> state_;
+		std::vector<uint8_t> serialised_;
+
+		// The serialisation of the most-recent keyframe, and the number of states captured since.
+		std::vector<uint8_t> reference_;
+		int states_since_keyframe_ = 0;
+
+		// Encoded states, held end-to-end in a circular arena.
+		struct Entry {
+			size_t offset;
+			size_t length;
+			size_t state_size;
+			bool is_keyframe;
+		};
+		std::vector<uint8_t> arena_;
+		std::deque<Entry> entries_;
+		size_t write_pointer_ = 0;
+
+		// Workspace for encoding.
+		std::vector<uint8_t> encoded_;
+
+		/// Populates @c encoded_ with @c serialised_ relative to @c reference_ if @c is_keyframe is @c false;
+		/// relative to zero otherwise.
+		void encode(bool is_keyframe);
+
+		/// Populates @c target with the state described by @c entry, relative to @c reference
+		/// if that entry is not a keyframe.
+		void decode(const Entry &entry, std::vector<uint8_t> &target, const std::vector<uint8_t> &reference) const;
+
+		/// Copies @c encoded_ into the arena, discarding old states as necessary.
+		/// @returns @c false if there was insufficient room, or if the keyframe that a delta relies upon was discarded.
+		bool store(bool is_keyframe);
+};
+
+}
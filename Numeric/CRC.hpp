@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -111,11 +113,62 @@ struct CCITT: public Generator<uint16_t, 0xffff, 0x0000, false, false> {
 	CCITT(): Generator(0x1021) {}
 };
 
+/*!
+	@returns Tables for bytewise calculation of a reflected 32-bit CRC with the reflected polynomial
+	@c polynomial, in which table @c n gives the effect of a byte followed by @c n zero bytes.
+*/
+constexpr std::array<std::array<uint32_t, 256>, 8> slicing_tables(uint32_t polynomial) {
+	std::array<std::array<uint32_t, 256>, 8> result{};
+	for(uint32_t c = 0; c < 256; c++) {
+		uint32_t value = c;
+		for(int b = 0; b < 8; b++) {
+			value = (value >> 1) ^ ((value & 1) ? polynomial : 0);
+		}
+		result[0][c] = value;
+	}
+	for(std::size_t table = 1; table < 8; table++) {
+		for(std::size_t c = 0; c < 256; c++) {
+			const uint32_t previous = result[table - 1][c];
+			result[table][c] = (previous >> 8) ^ result[0][previous & 0xff];
+		}
+	}
+	return result;
+}
+
 /*!
 	Provides a generator of "standard 32-bit" CRCs.
 */
 struct CRC32: public Generator<uint32_t, 0xffffffff, 0xffffffff, true, true> {
 	CRC32(): Generator(0x04c11db7) {}
+
+	/*!
+		@returns The CRC32 of the @c size bytes at @c data, continuing from @c crc if that is the CRC32
+		of preceding data. Equivalent to @c compute_crc but processes eight bytes per step, using
+		slicing-by-8 tables.
+	*/
+	static uint32_t compute(const uint8_t *data, std::size_t size, uint32_t crc = 0) {
+		crc = ~crc;
+		while(size >= 8) {
+			const uint32_t low = crc ^ uint32_t(data[0] | (data[1] << 8) | (data[2] << 16) | (uint32_t(data[3]) << 24));
+			crc =
+				tables[7][low & 0xff] ^ tables[6][(low >> 8) & 0xff] ^ tables[5][(low >> 16) & 0xff] ^ tables[4][low >> 24] ^
+				tables[3][data[4]] ^ tables[2][data[5]] ^ tables[1][data[6]] ^ tables[0][data[7]];
+			data += 8;
+			size -= 8;
+		}
+		while(size--) {
+			crc = (crc >> 8) ^ tables[0][(crc ^ *data) & 0xff];
+			++data;
+		}
+		return ~crc;
+	}
+
+	template <typename Collection> static uint32_t compute(const Collection &data) {
+		return compute(data.data(), data.size());
+	}
+
+	private:
+		static constexpr auto tables = slicing_tables(0xedb8'8320);
 };
 
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 
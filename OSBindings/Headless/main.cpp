@@ -0,0 +1,387 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Machines/Utility/MachineForTarget.hpp"
+
+#include "../../ClockReceiver/TimeTypes.hpp"
+
+#include "../../Machines/MachineTypes.hpp"
+
+#include "../POSIX/ROMFetcher.hpp"
+
+#include "../../Storage/Disk/Encodings/MFM/Parser.hpp"
+
+#include "../../Outputs/Software/ScanTarget.hpp"
+
+#include "../../Reflection/Struct.hpp"
+
+/*
+	A headless runner: loads media or creates a new machine exactly as the SDL binding does,
+	then runs it as quickly as possible for a fixed amount of emulated time, optionally
+	dumping frames and audio to disk. Intended for bulk compatibility sweeps and for
+	tracking performance over time.
+*/
+
+namespace {
+
+struct ParsedArguments {
+	std::vector<std::string> file_names;
+	std::map<std::string, std::string> selections;	// The empty string will be inserted for arguments without an = suffix.
+
+	void apply(Reflection::Struct *reflectable) const {
+		for(const auto &argument: selections) {
+			// Replace any dashes with underscores in the argument name.
+			std::string property;
+			std::transform(argument.first.begin(), argument.first.end(), std::back_inserter(property), [](char c) { return c == '-' ? '_' : c; });
+
+			if(argument.second.empty()) {
+				Reflection::set<bool>(*reflectable, property, true);
+			} else {
+				Reflection::fuzzy_set(*reflectable, property, argument.second);
+			}
+		}
+	}
+
+	/// @returns The value of the selection @c name parsed as a number, @c default_value if it was not
+	/// supplied, or @c default_value after printing a complaint if it could not be parsed.
+	double number(const std::string &name, double default_value) const {
+		const auto selection = selections.find(name);
+		if(selection == selections.end()) return default_value;
+
+		const char *const string = selection->second.c_str();
+		char *end;
+		const double value = strtod(string, &end);
+		if(!*string || size_t(end - string) != strlen(string)) {
+			std::cerr << "Unable to parse " << name << ": " << string << std::endl;
+			return default_value;
+		}
+		return value;
+	}
+
+	/// @returns The value of the selection @c name, or the empty string if it was not supplied.
+	std::string string(const std::string &name) const {
+		const auto selection = selections.find(name);
+		return selection == selections.end() ? "" : selection->second;
+	}
+};
+
+/*! Parses an argc/argv pair to discern program arguments. */
+ParsedArguments parse_arguments(int argc, char *argv[]) {
+	ParsedArguments arguments;
+
+	for(int index = 1; index < argc; ++index) {
+		char *arg = argv[index];
+
+		// Accepted format is:
+		//
+		//	--flag			sets a Boolean option to true.
+		//	--flag=value	sets the value for a list option.
+		//	name			sets the file name to load.
+		if(arg[0] == '-') {
+			while(*arg == '-') arg++;
+
+			std::string argument = arg;
+			std::size_t split_index = argument.find("=");
+
+			if(split_index == std::string::npos) {
+				arguments.selections[argument];
+			} else {
+				arguments.selections[argument.substr(0, split_index)] = argument.substr(split_index+1, std::string::npos);
+			}
+		} else {
+			arguments.file_names.push_back(arg);
+		}
+	}
+
+	return arguments;
+}
+
+std::string final_path_component(const std::string &path) {
+	if(path.empty()) {
+		return "";
+	}
+
+	const auto final_slash = path.find_last_of("/\\");
+	if(final_slash == std::string::npos) {
+		return path;
+	}
+	if(final_slash == path.size() - 1) {
+		return final_path_component(path.substr(0, path.size() - 1));
+	}
+	return path.substr(final_slash+1, path.size() - final_slash - 1);
+}
+
+/*!
+	Writes everything the speaker produces to a file as raw, native-endian 16-bit PCM.
+*/
+struct SpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
+	FILE *file = nullptr;
+	size_t samples = 0;
+
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+		samples += buffer.size();
+		if(file) {
+			std::fwrite(buffer.data(), sizeof(int16_t), buffer.size(), file);
+		}
+	}
+};
+
+/*!
+	Writes the current contents of @c scan_target to @c file_name as a binary PPM.
+
+	@returns @c true on success; @c false otherwise.
+*/
+bool write_frame(const Outputs::Display::Software::ScanTarget &scan_target, const std::string &file_name) {
+	FILE *const file = std::fopen(file_name.c_str(), "wb");
+	if(!file) return false;
+
+	std::fprintf(file, "P6\n%d %d\n255\n", scan_target.width(), scan_target.height());
+
+	const uint8_t *source = scan_target.framebuffer();
+	std::vector<uint8_t> row(size_t(scan_target.width()) * 3);
+	bool success = true;
+	for(int y = 0; y < scan_target.height(); y++) {
+		for(size_t x = 0; x < size_t(scan_target.width()); x++) {
+			row[x*3 + 0] = source[0];
+			row[x*3 + 1] = source[1];
+			row[x*3 + 2] = source[2];
+			source += 4;
+		}
+		success &= std::fwrite(row.data(), 1, row.size(), file) == row.size();
+	}
+
+	std::fclose(file);
+	return success;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	const ParsedArguments arguments = parse_arguments(argc, argv);
+
+	const std::string usage_suffix =
+		" [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--seconds={emulated seconds, default 10}]"
+		" [--frames={output path prefix}] [--frame-interval={emulated seconds}] [--audio={output file}] [--audio-rate={Hz, default 44100}]"
+		" [--width={pixels}] [--height={pixels}] [--threads={count}] [--mfm-cache={cache file}]";
+
+	if(arguments.selections.find("help") != arguments.selections.end() || arguments.selections.find("h") != arguments.selections.end()) {
+		std::cout << "Usage: " << final_path_component(argv[0]) << usage_suffix << std::endl;
+		std::cout << "Runs the machine unthrottled for the requested emulated time, then reports emulated seconds per wall-clock second." << std::endl;
+		std::cout << "Frames are written as <prefix>-<number>.ppm; audio is written as raw, native-endian, signed 16-bit PCM." << std::endl;
+		std::cout << "Machine options are as for the SDL build. Mass storage images are never modified." << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	// Mass storage images are always opened copy-on-write, so that repeated runs start from the same media.
+	constexpr bool copy_on_write = true;
+
+	// Reuse the results of disk decoding from earlier runs, if a cache was nominated.
+	const std::string mfm_cache = arguments.string("mfm-cache");
+	if(!mfm_cache.empty()) {
+		Storage::Encodings::MFM::Parser::load_cache(mfm_cache);
+	}
+
+	// Determine the machine for the supplied file, if any, or from --new.
+	Analyser::Static::TargetList targets;
+
+	const std::string new_machine = arguments.string("new");
+	if(!new_machine.empty()) {
+		// Perform for a case-insensitive search against short names.
+		const auto short_names = Machine::AllMachines(Machine::Type::DoesntRequireMedia, false);
+		const auto short_name = std::find_if(short_names.begin(), short_names.end(), [&new_machine](const std::string &name) {
+			return std::equal(
+				name.begin(), name.end(),
+				new_machine.begin(), new_machine.end(),
+				[](char a, char b) { return tolower(b) == tolower(a); });
+		});
+
+		if(short_name != short_names.end()) {
+			const auto long_name = Machine::AllMachines(Machine::Type::DoesntRequireMedia, true)[size_t(short_name - short_names.begin())];
+			auto targets_by_machine = Machine::TargetsByMachineName(false);
+			targets.push_back(std::move(targets_by_machine[long_name]));
+		}
+	} else {
+		// Take the first file name that actually implies a machine.
+		auto file_name = arguments.file_names.begin();
+		while(file_name != arguments.file_names.end() && targets.empty()) {
+			targets = Analyser::Static::GetTargets(*file_name, copy_on_write);
+			++file_name;
+		}
+	}
+
+	if(!mfm_cache.empty() && !Storage::Encodings::MFM::Parser::save_cache(mfm_cache)) {
+		std::cerr << "Unable to write " << mfm_cache << std::endl;
+	}
+
+	if(targets.empty()) {
+		if(!new_machine.empty()) {
+			std::cerr << "Unknown machine: " << new_machine << std::endl;
+		} else if(!arguments.file_names.empty()) {
+			std::cerr << "Cannot open " << arguments.file_names.front() << "; no target machine found" << std::endl;
+		} else {
+			std::cerr << "Usage: " << final_path_component(argv[0]) << usage_suffix << std::endl;
+		}
+		return EXIT_FAILURE;
+	}
+
+	// Look for ROMs in the same places as the SDL build.
+	POSIX::ROMFetcher rom_fetcher_implementation(arguments.string("rompath"));
+	const ROMMachine::ROMFetcher rom_fetcher = rom_fetcher_implementation.function();
+
+	// Apply all command-line options to the targets.
+	for(auto &target: targets) {
+		auto reflectable_target = dynamic_cast<Reflection::Struct *>(target.get());
+		if(!reflectable_target) continue;
+		arguments.apply(reflectable_target);
+	}
+
+	// Create and configure a machine.
+	::Machine::Error error;
+	std::unique_ptr<::Machine::DynamicMachine> machine(::Machine::MachineForTargets(targets, rom_fetcher, error));
+	if(!machine) {
+		if(error == ::Machine::Error::MissingROM) {
+			std::cerr << "Could not find system ROMs; please install to /usr/local/share/CLK/ or /usr/share/CLK/, or provide a --rompath." << std::endl;
+			std::cerr << "Needed but didn't find";
+
+			using DescriptionFlag = ROM::Description::DescriptionFlag;
+			std::wcerr << rom_fetcher_implementation.missing_roms().description(DescriptionFlag::Filename | DescriptionFlag::CRC, L'*');
+			std::cerr << std::endl;
+		}
+		return EXIT_FAILURE;
+	}
+
+	auto configurable = machine->configurable_device();
+	if(configurable) {
+		const auto options = configurable->get_options();
+		arguments.apply(options.get());
+		configurable->set_options(options);
+	}
+
+	{
+		auto media_target = machine->media_target();
+		if(media_target) {
+			Analyser::Static::Media media;
+			for(const auto &file_name: arguments.file_names) {
+				media += Analyser::Static::GetMedia(file_name, copy_on_write);
+			}
+			media_target->insert_media(media);
+		}
+	}
+
+	// Determine running parameters.
+	const Time::Seconds duration = arguments.number("seconds", 10.0);
+	const Time::Seconds frame_interval = arguments.number("frame-interval", 0.0);
+	const std::string frame_prefix = arguments.string("frames");
+	const std::string audio_file_name = arguments.string("audio");
+	const int audio_rate = int(arguments.number("audio-rate", 44100.0));
+
+	// Attach video output.
+	Outputs::Display::Software::ScanTarget scan_target(
+		std::max(int(arguments.number("width", 640.0)), 1),
+		std::max(int(arguments.number("height", 480.0)), 1),
+		size_t(std::max(arguments.number("threads", 0.0), 0.0)));
+
+	const auto scan_producer = machine->scan_producer();
+	if(scan_producer) {
+		scan_producer->set_scan_target(&scan_target);
+	}
+
+	// Attach audio output; samples are always collected so that they can be counted.
+	SpeakerDelegate speaker_delegate;
+	bool is_stereo = false;
+	const auto audio_producer = machine->audio_producer();
+	if(audio_producer) {
+		auto speaker = audio_producer->get_speaker();
+		if(speaker) {
+			if(!audio_file_name.empty()) {
+				speaker_delegate.file = std::fopen(audio_file_name.c_str(), "wb");
+				if(!speaker_delegate.file) {
+					std::cerr << "Unable to open " << audio_file_name << " for writing" << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+
+			is_stereo = speaker->get_is_stereo();
+			speaker->set_output_rate(float(audio_rate), 1024, is_stereo);
+			speaker->set_delegate(&speaker_delegate);
+		}
+	}
+
+	// Run, in slices short enough that the scan target's buffers can't overflow.
+	constexpr Time::Seconds slice = 1.0 / 200.0;
+	const auto timed_machine = machine->timed_machine();
+
+	Time::Seconds emulated_time = 0.0;
+	Time::Seconds next_frame_time = frame_interval;
+	Time::Nanos machine_time = 0;
+	size_t frames_written = 0;
+
+	const auto dump_frame = [&] {
+		if(frame_prefix.empty()) return;
+
+		char suffix[16];
+		std::snprintf(suffix, sizeof(suffix), "-%05zu.ppm", frames_written);
+		if(!write_frame(scan_target, frame_prefix + suffix)) {
+			std::cerr << "Unable to write " << frame_prefix << suffix << std::endl;
+		}
+		++frames_written;
+	};
+
+	const Time::Nanos start_time = Time::nanos_now();
+	while(emulated_time < duration) {
+		const Time::Seconds step = std::min(slice, duration - emulated_time);
+
+		const Time::Nanos slice_start = Time::nanos_now();
+		timed_machine->run_for(step);
+		timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+		machine_time += Time::nanos_now() - slice_start;
+
+		emulated_time += step;
+		scan_target.update();
+
+		if(frame_interval > 0.0 && emulated_time >= next_frame_time) {
+			dump_frame();
+			next_frame_time += frame_interval;
+		}
+	}
+	timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+	scan_target.update();
+	const Time::Nanos end_time = Time::nanos_now();
+
+	// Always capture the final state if frames were requested.
+	dump_frame();
+
+	if(speaker_delegate.file) {
+		std::fclose(speaker_delegate.file);
+	}
+
+	// Report.
+	const Time::Seconds wall_time = Time::seconds(end_time - start_time);
+	const Time::Seconds machine_wall_time = Time::seconds(machine_time);
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "Emulated " << emulated_time << "s in " << wall_time << "s: " << (emulated_time / wall_time) << " emulated seconds per second" << std::endl;
+	std::cout << "Machine alone: " << machine_wall_time << "s, " << (emulated_time / machine_wall_time) << " emulated seconds per second" << std::endl;
+	std::cout << "Video: " << scan_target.frames() << " frames output, " << frames_written << " written" << std::endl;
+	if(audio_producer && audio_producer->get_speaker()) {
+		std::cout << "Audio: " << (speaker_delegate.samples / (is_stereo ? 2 : 1)) << " samples at " << audio_rate << "Hz, " << (is_stereo ? "stereo" : "mono") << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+//
+//  6522JustInTimeTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/6522/6522.hpp"
+#include "../../../ClockReceiver/JustInTime.hpp"
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// Records the outputs a 6522 announces, the number of times they change and the total time it has supplied.
+struct RecordingPortHandler: public MOS::MOS6522::PortHandler {
+	uint8_t port_input[2] = {0xff, 0xff};
+
+	bool interrupt_line = false;
+	uint8_t port_output[2] = {0xff, 0xff};
+	bool control_line_output[2][2]{};
+	int changes = 0;
+	HalfCycles time;
+
+	uint8_t get_port_input(MOS::MOS6522::Port port) {
+		return port_input[port];
+	}
+
+	void set_port_output(MOS::MOS6522::Port port, uint8_t value, uint8_t direction_mask) {
+		record(port_output[port], uint8_t(value | ~direction_mask));
+	}
+
+	void set_control_line_output(MOS::MOS6522::Port port, MOS::MOS6522::Line line, bool value) {
+		record(control_line_output[port][line], value);
+	}
+
+	void set_interrupt_status(bool status) {
+		record(interrupt_line, status);
+	}
+
+	void run_for(HalfCycles duration) {
+		time += duration;
+	}
+
+	/// Stores @c value to @c target, counting it as a change if it differs; a 6522 may
+	/// announce an unchanged output more or less often depending on how it is clocked.
+	template <typename T> void record(T &target, T value) {
+		changes += target != value;
+		target = value;
+	}
+
+	/// @returns @c true if every output of @c rhs matches those of this handler; @c false otherwise.
+	bool outputs_match(const RecordingPortHandler &rhs) const {
+		return
+			interrupt_line == rhs.interrupt_line &&
+			port_output[0] == rhs.port_output[0] && port_output[1] == rhs.port_output[1] &&
+			!memcmp(control_line_output, rhs.control_line_output, sizeof(control_line_output));
+	}
+};
+
+using VIA = MOS::MOS6522::MOS6522<RecordingPortHandler>;
+
+/// A 6522 plus its port handler.
+struct Subject {
+	RecordingPortHandler handler;
+	VIA via;
+	Subject() : via(handler) {}
+};
+
+/// A 6522 held in a JustInTimeActor plus its port handler.
+struct ActorSubject {
+	RecordingPortHandler handler;
+	JustInTimeActor<VIA> via;
+	ActorSubject() : via(handler) {}
+};
+
+/// @returns The serialised state of @c via.
+std::vector<uint8_t> state(VIA &via) {
+	return MOS::MOS6522::State(via).serialise();
+}
+
+}
+
+@interface MOS6522JustInTimeTests : XCTestCase
+@end
+
+@implementation MOS6522JustInTimeTests
+
+/// Applies a random sequence of register accesses, control inputs, port inputs and idle periods to
+/// four 6522s, checking that they remain identical:
+///
+///	* a reference, which is run a single half-cycle at a time and therefore never skips ahead;
+///	* one in a JustInTimeActor, which is supplied a cycle at a time and is otherwise flushed only
+///		upon access, and whose outputs are compared with the reference's after every cycle;
+///	* one that is run for whole idle periods as Cycles; and
+///	* one that is run for idle periods split into random numbers of HalfCycles.
+- (void)testRandomisedAgainstSteppedReference {
+	for(unsigned int seed = 0; seed < 8; seed++) {
+		std::mt19937 random(seed);
+		const auto uniform = [&](int max) {
+			return int(random() % unsigned(max + 1));
+		};
+
+		Subject reference, cycles, half_cycles;
+		ActorSubject actor;
+
+		const auto all = [&](auto &&action) {
+			action(reference.via, reference.handler);
+			action(*actor.via.last_valid(), actor.handler);
+			action(cycles.via, cycles.handler);
+			action(half_cycles.via, half_cycles.handler);
+		};
+
+		for(int event = 0; event < 1500; event++) {
+			// Pick an idle period: usually short, sometimes long enough for timers to wrap.
+			int period;
+			switch(uniform(49)) {
+				default:	period = uniform(40);		break;
+				case 0:		period = uniform(140000);	break;
+				case 1:	case 2:	case 3:	case 4:
+				case 5:	case 6:	case 7:	case 8:
+							period = uniform(600);		break;
+			}
+
+			for(int cycle = 0; cycle < period; cycle++) {
+				reference.via.run_for(HalfCycles(1));
+				reference.via.run_for(HalfCycles(1));
+				actor.via += Cycles(1);
+
+				if(!actor.handler.outputs_match(reference.handler)) {
+					XCTFail(@"Actor outputs differ from reference at seed %u, event %d, cycle %d", seed, event, cycle);
+					return;
+				}
+			}
+
+			cycles.via.run_for(Cycles(period));
+
+			int remaining = period * 2;
+			while(remaining) {
+				const int step = std::min(remaining, uniform(3) ? uniform(7) + 1 : uniform(remaining));
+				half_cycles.via.run_for(HalfCycles(std::max(step, 1)));
+				remaining -= std::max(step, 1);
+			}
+
+			// Bring the actor up to date, then compare complete states.
+			actor.via.flush();
+			all([](VIA &via, RecordingPortHandler &) { via.flush(); });
+
+			const auto reference_state = state(reference.via);
+			const bool states_match =
+				state(*actor.via.last_valid()) == reference_state &&
+				state(cycles.via) == reference_state &&
+				state(half_cycles.via) == reference_state;
+			const bool handlers_match =
+				actor.handler.outputs_match(reference.handler) &&
+				cycles.handler.outputs_match(reference.handler) &&
+				half_cycles.handler.outputs_match(reference.handler) &&
+				actor.handler.changes == reference.handler.changes &&
+				cycles.handler.changes == reference.handler.changes &&
+				half_cycles.handler.changes == reference.handler.changes &&
+				actor.handler.time == reference.handler.time &&
+				cycles.handler.time == reference.handler.time &&
+				half_cycles.handler.time == reference.handler.time;
+			if(!states_match || !handlers_match) {
+				XCTFail(@"State differs from reference at seed %u, event %d", seed, event);
+				return;
+			}
+
+			// Perform an event.
+			switch(uniform(9)) {
+				default: {
+					// Write a register, favouring those that affect timing and using small timer values
+					// so that underflows are frequent.
+					static constexpr int registers[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xa, 0xb, 0xb, 0xc, 0xd, 0xe, 0xe, 0xf};
+					const int address = registers[uniform(int(std::size(registers)) - 1)];
+					uint8_t value = uint8_t(random());
+					if((address == 0x5 || address == 0x7 || address == 0x9) && uniform(3)) {
+						value &= 0x01;
+					}
+					if((address == 0x4 || address == 0x6 || address == 0x8) && uniform(1)) {
+						value &= 0x1f;
+					}
+
+					reference.via.write(address, value);
+					actor.via->write(address, value);
+					cycles.via.write(address, value);
+					half_cycles.via.write(address, value);
+				} break;
+
+				case 0: case 1: case 2: {
+					const int address = uniform(15);
+					const uint8_t expected = reference.via.read(address);
+					const uint8_t actor_value = actor.via->read(address);
+					const uint8_t cycles_value = cycles.via.read(address);
+					const uint8_t half_cycles_value = half_cycles.via.read(address);
+					if(actor_value != expected || cycles_value != expected || half_cycles_value != expected) {
+						XCTFail(@"Read of register %d differs from reference at seed %u, event %d", address, seed, event);
+						return;
+					}
+				} break;
+
+				case 3: {
+					const auto port = MOS::MOS6522::Port(uniform(1));
+					const auto line = MOS::MOS6522::Line(uniform(1));
+					const bool value = uniform(1);
+
+					reference.via.set_control_line_input(port, line, value);
+					actor.via->set_control_line_input(port, line, value);
+					cycles.via.set_control_line_input(port, line, value);
+					half_cycles.via.set_control_line_input(port, line, value);
+				} break;
+
+				case 4: {
+					const int port = uniform(1);
+					const uint8_t value = uint8_t(random());
+					all([port, value](VIA &, RecordingPortHandler &handler) { handler.port_input[port] = value; });
+				} break;
+			}
+		}
+	}
+}
+
+@end
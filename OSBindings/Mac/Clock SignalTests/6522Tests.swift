@@ -101,6 +101,31 @@ class MOS6522Tests: XCTestCase {
 	}
 
 
+	func testTimerSequencePoints() {
+		// set timer 1 to a value of 16, enable repeating mode and its interrupt
+		m6522.setValue(16, forRegister: 4)
+		m6522.setValue(0, forRegister: 5)
+		m6522.setValue(0x40, forRegister: 11)
+		m6522.setValue(0x40 | 0x80, forRegister: 14)
+
+		// complete the cycle to set initial values
+		m6522.run(forHalfCycles: 2)
+
+		// the next sequence point should be the half-cycle upon which the IRQ triggers, as per testTimerReload
+		XCTAssertEqual(m6522.halfCyclesUntilSequencePoint, 35)
+
+		// check that the IRQ triggers upon that half-cycle, even if the run up to it isn't broken up
+		m6522.run(forHalfCycles: 34)
+		XCTAssert(!m6522.irqLine, "IRQ should not yet be active")
+		m6522.run(forHalfCycles: 1)
+		XCTAssert(m6522.irqLine, "IRQ should be active")
+
+		// disable the interrupt and check that, once the reload is done, no further sequence point is pending
+		m6522.setValue(0x40, forRegister: 14)
+		m6522.run(forHalfCycles: 2)
+		XCTAssertEqual(m6522.halfCyclesUntilSequencePoint, Int.max)
+	}
+
 	// MARK: PB7 timer 1 tests
 	// These follow the same logic and check for the same results as the VICE VIC-20 via_pb7 tests.
 
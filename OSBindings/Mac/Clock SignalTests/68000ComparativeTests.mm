@@ -9,12 +9,14 @@
 #import <XCTest/XCTest.h>
 
 #include "../../../Processors/68000/68000.hpp"
+#include "../../../Processors/68000/FastProcessor.hpp"
 #include "../../../InstructionSets/M68k/Executor.hpp"
 #include "../../../InstructionSets/M68k/Decoder.hpp"
 
 #include <array>
 #include <memory>
 #include <functional>
+#include <vector>
 
 //#define USE_EXECUTOR
 //#define MAKE_SUGGESTIONS
@@ -79,8 +81,12 @@ struct TestExecutor {
 
 	void reset() {}
 	int acknowlege_interrupt(int) {
+		if(will_acknowledge) will_acknowledge();
 		return -1;
 	}
+
+	/// Called upon every interrupt acknowledgement; all interrupts are autovectored.
+	std::function<void(void)> will_acknowledge;
 };
 
 /// Binds a bus-accurate 68000 to 16mb of RAM.
@@ -89,15 +95,27 @@ struct TestProcessor: public CPU::MC68000::BusHandler {
 	CPU::MC68000::Processor<TestProcessor, true, true, true> processor;
 	std::function<void(void)> comparitor;
 
+	/// Called upon every interrupt acknowledgement; all interrupts are autovectored.
+	std::function<void(void)> will_acknowledge;
+	int instructions_performed = 0;
+
 	TestProcessor(uint8_t *ram) : ram(ram), processor(*this) {}
 
 	void will_perform(uint32_t, uint16_t) {
+		++instructions_performed;
 		--instructions_remaining_;
 		if(!instructions_remaining_) comparitor();
 	}
 
 
 	template <typename Microcycle> HalfCycles perform_bus_operation(const Microcycle &cycle, int) {
+		if(cycle.operation & CPU::MC68000::Operation::InterruptAcknowledge) {
+			processor.set_is_peripheral_address(true);
+			if(cycle.data_select_active() && will_acknowledge) will_acknowledge();
+			return HalfCycles(0);
+		}
+		processor.set_is_peripheral_address(false);
+
 		if(cycle.data_select_active()) {
 			cycle.apply(&ram[cycle.host_endian_byte_address()]);
 		}
@@ -113,9 +131,65 @@ struct TestProcessor: public CPU::MC68000::BusHandler {
 	}
 
 	private:
-		int instructions_remaining_;
+		int instructions_remaining_ = 0;
+};
+
+/// Binds an instruction-granularity 68000 to 16mb of RAM.
+struct TestFastProcessor: public CPU::MC68000::BusHandler {
+	uint8_t *const ram;
+	CPU::MC68000::FastProcessor<TestFastProcessor> processor;
+
+	TestFastProcessor(uint8_t *ram) : ram(ram), processor(*this) {}
+
+	template <typename Microcycle> HalfCycles perform_bus_operation(const Microcycle &cycle, int) {
+		if(cycle.data_select_active()) {
+			cycle.apply(&ram[cycle.host_endian_byte_address()]);
+		}
+		return HalfCycles(0);
+	}
+};
+
+/// Provides matching memory contents for a @c TestExecutor, which expects big-endian byte order,
+/// and a @c TestProcessor or @c TestFastProcessor, which expect host-endian words.
+struct PairedRAM {
+	std::vector<uint8_t> executor = std::vector<uint8_t>(16*1024*1024, 0xce);
+	std::vector<uint8_t> processor = std::vector<uint8_t>(16*1024*1024, 0xce);
+
+	void set16(uint32_t address, uint16_t value) {
+		executor[address] = processor[address ^ 1] = uint8_t(value >> 8);
+		executor[address + 1] = processor[(address + 1) ^ 1] = uint8_t(value);
+	}
+
+	void set32(uint32_t address, uint32_t value) {
+		set16(address, uint16_t(value >> 16));
+		set16(address + 2, uint16_t(value));
+	}
+
+	uint16_t executor16(uint32_t address) const {
+		return uint16_t((executor[address] << 8) | executor[address + 1]);
+	}
+
+	uint16_t processor16(uint32_t address) const {
+		return uint16_t((processor[address ^ 1] << 8) | processor[(address + 1) ^ 1]);
+	}
 };
 
+/// Sets up @c ram and @c registers for a test of STOP #$2300 at 0x100, with the level 4 autovector pointing to a run of NOPs at 0x400.
+void set_stop_test(PairedRAM &ram, InstructionSet::M68k::RegisterSet &registers) {
+	ram.set16(0x100, 0x4e72);	// STOP #$2300
+	ram.set16(0x102, 0x2300);
+	ram.set16(0x104, 0x4e71);	// NOP
+	ram.set32(0x70, 0x400);		// Level 4 autovector.
+	for(uint32_t address = 0x400; address < 0x410; address += 2) {
+		ram.set16(address, 0x4e71);
+	}
+
+	registers = InstructionSet::M68k::RegisterSet();
+	registers.status = 0x2700;
+	registers.program_counter = 0x100;
+	registers.supervisor_stack_pointer = 0x800;
+}
+
 }
 
 @interface M68000ComparativeTests : XCTestCase
@@ -217,6 +291,108 @@ struct TestProcessor: public CPU::MC68000::BusHandler {
 #endif
 }
 
+- (void)testSTOP {
+	PairedRAM ram;
+	InstructionSet::M68k::RegisterSet registers;
+	set_stop_test(ram, registers);
+
+	// The executor should load the status register and then make no further progress.
+	auto executor = std::make_unique<TestExecutor>(ram.executor.data());
+	executor->processor.set_state(registers);
+	executor->run_for_instructions(1);
+	XCTAssertEqual(executor->processor.get_state().status, 0x2300);
+	XCTAssertEqual(executor->processor.get_state().program_counter, 0x104);
+	executor->run_for_instructions(10);
+	XCTAssertEqual(executor->processor.get_state().program_counter, 0x104);
+
+	// The bus-accurate processor should agree.
+	auto processor = std::make_unique<TestProcessor>(ram.processor.data());
+	processor->processor.decode_from_state(registers);
+	processor->processor.run_for(HalfCycles(800));
+	XCTAssertEqual(processor->instructions_performed, 1);
+	XCTAssertEqual(processor->processor.get_state().registers.status, 0x2300);
+	XCTAssertEqual(processor->processor.get_state().registers.program_counter, 0x104);
+}
+
+- (void)testInterruptLoweredDuringAcknowledge {
+	PairedRAM ram;
+	InstructionSet::M68k::RegisterSet registers;
+	set_stop_test(ram, registers);
+
+	// Wake each processor from STOP with a level 4 interrupt that is withdrawn during acknowledgement;
+	// it should nevertheless be taken at level 4.
+	auto executor = std::make_unique<TestExecutor>(ram.executor.data());
+	executor->processor.set_state(registers);
+	executor->run_for_instructions(1);
+	executor->will_acknowledge = [&executor] {
+		executor->processor.set_interrupt_level(0);
+	};
+	executor->processor.set_interrupt_level(4);
+	executor->run_for_instructions(1);	// i.e. the exception plus the first NOP.
+
+	const auto executor_state = executor->processor.get_state();
+	XCTAssertEqual(executor_state.status, 0x2400);
+	XCTAssertEqual(executor_state.program_counter, 0x402);
+	XCTAssertEqual(executor_state.supervisor_stack_pointer, 0x7fa);
+	XCTAssertEqual(ram.executor16(0x7fa), 0x2300);
+	XCTAssertEqual(ram.executor16(0x7fe), 0x104);
+
+	struct TerminateMarker {};
+	auto processor = std::make_unique<TestProcessor>(ram.processor.data());
+	processor->processor.decode_from_state(registers);
+	processor->processor.run_for(HalfCycles(800));
+	processor->will_acknowledge = [&processor] {
+		processor->processor.set_interrupt_level(0);
+	};
+	processor->processor.set_interrupt_level(4);
+	try {
+		processor->run_for_instructions(1, [&] {
+			const auto processor_state = processor->processor.get_state().registers;
+			XCTAssertEqual(processor_state.status, executor_state.status);
+			XCTAssertEqual(processor_state.program_counter - 4, executor_state.program_counter);
+			XCTAssertEqual(processor_state.supervisor_stack_pointer, executor_state.supervisor_stack_pointer);
+			XCTAssertEqual(ram.processor16(0x7fa), 0x2300);
+			XCTAssertEqual(ram.processor16(0x7fe), 0x104);
+			throw TerminateMarker();
+		});
+	} catch(TerminateMarker) {}
+}
+
+- (void)testFastProcessor {
+	// Reset to 0x1000 with the stack at 0x800, then:
+	//
+	//	MOVE.l #$12345678, D0
+	//	ADDQ.l #1, D0
+	//	MOVE.l D0, ($2000).w
+	//	STOP #$2700
+	PairedRAM ram;
+	ram.set32(0, 0x800);
+	ram.set32(4, 0x1000);
+	const uint16_t program[] = {0x203c, 0x1234, 0x5678, 0x5280, 0x21c0, 0x2000, 0x4e72, 0x2700};
+	for(size_t c = 0; c < sizeof(program) / sizeof(*program); c++) {
+		ram.set16(0x1000 + uint32_t(c * 2), program[c]);
+	}
+	auto reference_ram = ram.processor;
+
+	auto fast = std::make_unique<TestFastProcessor>(ram.processor.data());
+	fast->processor.run_for(HalfCycles(2000));
+	const auto fast_state = fast->processor.get_state().registers;
+	XCTAssertEqual(fast_state.data[0], 0x1234'5679);
+	XCTAssertEqual(fast_state.program_counter, 0x1010);
+	XCTAssertEqual(fast_state.status, 0x2700);
+	XCTAssertEqual(ram.processor16(0x2000), 0x1234);
+	XCTAssertEqual(ram.processor16(0x2002), 0x5679);
+
+	// Compare with the bus-accurate processor.
+	auto processor = std::make_unique<TestProcessor>(reference_ram.data());
+	processor->processor.run_for(HalfCycles(2000));
+	const auto processor_state = processor->processor.get_state().registers;
+	XCTAssertEqual(processor_state.data[0], fast_state.data[0]);
+	XCTAssertEqual(processor_state.program_counter, fast_state.program_counter);
+	XCTAssertEqual(processor_state.status, fast_state.status);
+	XCTAssert(std::equal(reference_ram.begin(), reference_ram.begin() + 0x4000, ram.processor.begin()));
+}
+
 - (void)testJSONAtURL:(NSURL *)url {
 	// Read the nominated file and parse it as JSON.
 	NSData *const data = [NSData dataWithContentsOfURL:url];
@@ -0,0 +1,261 @@
+//
+//  ArchiveTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Archive.hpp"
+#include "../../../Storage/FileHolder.hpp"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <zlib.h>
+
+namespace {
+
+/// @returns @c size bytes of somewhat-compressible data, varying with @c seed.
+std::vector<uint8_t> contents(size_t size, int seed) {
+	std::vector<uint8_t> result(size);
+	for(size_t c = 0; c < size; c++) {
+		result[c] = uint8_t((c / 7) ^ (c * size_t(seed)) ^ (c >> 9));
+	}
+	return result;
+}
+
+uint32_t crc_of(const std::vector<uint8_t> &data) {
+	return uint32_t(crc32(crc32(0, nullptr, 0), data.data(), uInt(data.size())));
+}
+
+/// @returns @c source deflated with the given zlib @c window_bits, and naming it @c name if this is a gzip member.
+std::vector<uint8_t> deflated(const std::vector<uint8_t> &source, int window_bits, const char *name = nullptr) {
+	z_stream stream{};
+	deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY);
+
+	gz_header header{};
+	if(name) {
+		header.name = reinterpret_cast<Bytef *>(const_cast<char *>(name));
+		deflateSetHeader(&stream, &header);
+	}
+
+	std::vector<uint8_t> result(deflateBound(&stream, uLong(source.size())) + 64);
+	stream.next_in = const_cast<Bytef *>(source.data());
+	stream.avail_in = uInt(source.size());
+	stream.next_out = result.data();
+	stream.avail_out = uInt(result.size());
+	deflate(&stream, Z_FINISH);
+	result.resize(stream.total_out);
+	deflateEnd(&stream);
+	return result;
+}
+
+void put16(std::vector<uint8_t> &target, uint16_t value) {
+	target.push_back(uint8_t(value));
+	target.push_back(uint8_t(value >> 8));
+}
+
+void put32(std::vector<uint8_t> &target, uint32_t value) {
+	put16(target, uint16_t(value));
+	put16(target, uint16_t(value >> 16));
+}
+
+struct ZipEntry {
+	std::string name;
+	std::vector<uint8_t> contents;
+	bool is_deflated;
+	uint32_t declared_size = 0;	// If non-zero, overrides the true size in the headers.
+};
+
+/// @returns A zip archive containing @c entries.
+std::vector<uint8_t> zip(const std::vector<ZipEntry> &entries) {
+	std::vector<uint8_t> archive, directory;
+
+	for(const auto &entry: entries) {
+		const auto data = entry.is_deflated ? deflated(entry.contents, -MAX_WBITS) : entry.contents;
+		const uint32_t offset = uint32_t(archive.size());
+
+		// Both headers share most fields.
+		const auto put_fields = [&](std::vector<uint8_t> &target) {
+			put16(target, 20);								// Version needed to extract.
+			put16(target, 0);								// Flags.
+			put16(target, entry.is_deflated ? 8 : 0);		// Compression method.
+			put32(target, 0);								// Modification time and date.
+			put32(target, crc_of(entry.contents));
+			put32(target, uint32_t(data.size()));
+			put32(target, entry.declared_size ? entry.declared_size : uint32_t(entry.contents.size()));
+			put16(target, uint16_t(entry.name.size()));
+			put16(target, 0);								// Extra field length.
+		};
+
+		put32(archive, 0x0403'4b50);
+		put_fields(archive);
+		archive.insert(archive.end(), entry.name.begin(), entry.name.end());
+		archive.insert(archive.end(), data.begin(), data.end());
+
+		put32(directory, 0x0201'4b50);
+		put16(directory, 20);								// Version made by.
+		put_fields(directory);
+		put16(directory, 0);								// Comment length.
+		put16(directory, 0);								// Disk number.
+		put16(directory, 0);								// Internal attributes.
+		put32(directory, 0);								// External attributes.
+		put32(directory, offset);
+		directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+	}
+
+	const uint32_t directory_offset = uint32_t(archive.size());
+	archive.insert(archive.end(), directory.begin(), directory.end());
+
+	put32(archive, 0x0605'4b50);
+	put16(archive, 0);										// Disk number.
+	put16(archive, 0);										// Disk with the central directory.
+	put16(archive, uint16_t(entries.size()));
+	put16(archive, uint16_t(entries.size()));
+	put32(archive, uint32_t(directory.size()));
+	put32(archive, directory_offset);
+	put16(archive, 0);										// Comment length.
+	return archive;
+}
+
+/// Owns a temporary file with the extension @c extension, which is removed upon destruction.
+struct TemporaryFile {
+	std::string name;
+
+	TemporaryFile(const std::vector<uint8_t> &contents, const std::string &extension) {
+		char stem[] = P_tmpdir "/ArchiveTestsXXXXXX";
+		close(mkstemp(stem));
+		std::remove(stem);
+
+		name = std::string(stem) + "." + extension;
+		FILE *const file = std::fopen(name.c_str(), "wb");
+		std::fwrite(contents.data(), 1, contents.size(), file);
+		std::fclose(file);
+	}
+
+	~TemporaryFile() {
+		std::remove(name.c_str());
+	}
+};
+
+/// @returns The entire contents of the file named @c name, as read via a FileHolder.
+std::vector<uint8_t> read(const std::string &name) {
+	Storage::FileHolder file(name, Storage::FileHolder::FileMode::Read);
+	return file.read(size_t(file.stats().st_size));
+}
+
+bool can_open(const std::string &name) {
+	try {
+		Storage::FileHolder file(name, Storage::FileHolder::FileMode::Read);
+		return true;
+	} catch(Storage::FileHolder::Error) {
+		return false;
+	}
+}
+
+}
+
+@interface ArchiveTests : XCTestCase
+@end
+
+@implementation ArchiveTests
+
+- (void)testZip {
+	const auto stored = contents(1000, 3);
+	const auto compressed = contents(70000, 5);
+	TemporaryFile file(zip({
+		{"DISKS/", {}, false},
+		{"stored.ssd", stored, false},
+		{"DISKS/compressed.dsk", compressed, true},
+	}), "zip");
+
+	const auto names = Storage::Archive::expand(file.name);
+	XCTAssertEqual(names.size(), 2);
+	if(names.size() != 2) return;
+	XCTAssertEqual(names[0], file.name + "/stored.ssd");
+	XCTAssertEqual(names[1], file.name + "/DISKS/compressed.dsk");
+
+	XCTAssert(read(names[0]) == stored);
+	XCTAssert(read(names[1]) == compressed);
+
+	// A file already open should outlast release; no further files should be openable.
+	Storage::FileHolder open_file(names[1], Storage::FileHolder::FileMode::Read);
+	Storage::Archive::release(file.name);
+	XCTAssertFalse(can_open(names[0]));
+	XCTAssertFalse(can_open(names[1]));
+	XCTAssert(open_file.read(compressed.size()) == compressed);
+}
+
+- (void)testMisdeclaredZipSizes {
+	const auto valid = contents(2000, 19);
+	TemporaryFile file(zip({
+		{"huge.dsk", contents(1000, 23), true, 0xffff'fff0},
+		{"short.dsk", contents(1000, 29), true, 999},
+		{"long.dsk", contents(1000, 31), true, 1001},
+		{"valid.dsk", valid, true},
+	}), "zip");
+
+	// Only the entry that inflates to its declared size should be found.
+	const auto names = Storage::Archive::expand(file.name);
+	XCTAssertEqual(names.size(), 1);
+	if(names.empty()) return;
+	XCTAssertEqual(names[0], file.name + "/valid.dsk");
+	XCTAssert(read(names[0]) == valid);
+
+	Storage::Archive::release(file.name);
+}
+
+- (void)testMultiMemberGzip {
+	const auto first = contents(5000, 7);
+	const auto second = contents(12000, 11);
+
+	auto archive = deflated(first, MAX_WBITS + 16, "inner.adf");
+	const auto second_member = deflated(second, MAX_WBITS + 16);
+	archive.insert(archive.end(), second_member.begin(), second_member.end());
+	TemporaryFile file(archive, "gz");
+
+	const auto names = Storage::Archive::expand(file.name);
+	XCTAssertEqual(names.size(), 1);
+	if(names.empty()) return;
+	XCTAssertEqual(names[0], file.name + "/inner.adf");
+
+	auto expected = first;
+	expected.insert(expected.end(), second.begin(), second.end());
+	XCTAssert(read(names[0]) == expected);
+
+	Storage::Archive::release(file.name);
+	XCTAssertFalse(can_open(names[0]));
+}
+
+- (void)testPaddedGzip {
+	const auto original = contents(30000, 13);
+	auto archive = deflated(original, MAX_WBITS + 16);
+	archive.resize(archive.size() + 512);
+	TemporaryFile file(archive, "adz");
+
+	// With no name recorded, the inner file should be named for the archive.
+	const auto names = Storage::Archive::expand(file.name);
+	XCTAssertEqual(names.size(), 1);
+	if(names.empty()) return;
+
+	const std::string stem = file.name.substr(file.name.find_last_of('/') + 1);
+	XCTAssertEqual(names[0], file.name + "/" + stem.substr(0, stem.size() - 3) + "adf");
+	XCTAssert(read(names[0]) == original);
+
+	Storage::Archive::release(file.name);
+}
+
+- (void)testCorruptGzip {
+	auto archive = deflated(contents(30000, 17), MAX_WBITS + 16);
+	archive[archive.size() - 6] ^= 0xff;	// Corrupt the CRC.
+	TemporaryFile file(archive, "gz");
+
+	XCTAssert(Storage::Archive::expand(file.name).empty());
+}
+
+@end
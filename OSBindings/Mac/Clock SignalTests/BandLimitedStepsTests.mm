@@ -0,0 +1,281 @@
+//
+//  BandLimitedStepsTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/AY38910/AY38910.hpp"
+#include "../../../Components/SN76489/SN76489.hpp"
+#include "../../../Outputs/Speaker/Implementation/CompoundSource.hpp"
+#include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr float InputRate = 1'000'000.0f;
+constexpr float OutputRate = 44'100.0f;
+
+/// A square wave of irregular period, which can be read either as samples or as steps.
+class SquareWave: public Outputs::Speaker::SampleSource {
+	public:
+		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+			for(std::size_t c = 0; c < number_of_samples; c++) {
+				target[c] = level();
+				advance();
+			}
+		}
+
+		template <typename TargetT> void get_steps(std::size_t number_of_samples, TargetT &target) {
+			for(std::size_t c = 0; c < number_of_samples; c++) {
+				const int16_t output = level();
+				target.add_step(c, int16_t(output - posted_level_));
+				posted_level_ = output;
+				advance();
+			}
+		}
+
+		void set_sample_volume_range(std::int16_t range) {
+			// Leave headroom for overshoot.
+			volume_ = range / 2;
+		}
+
+		static constexpr bool get_supports_steps() { return true; }
+
+	private:
+		int16_t volume_ = 0;
+		int16_t posted_level_ = 0;
+		int counter_ = 0;
+		int period_ = 400;
+		bool is_high_ = false;
+
+		int16_t level() const {
+			return is_high_ ? volume_ : 0;
+		}
+
+		void advance() {
+			if(++counter_ < period_) return;
+
+			counter_ = 0;
+			is_high_ ^= true;
+			period_ = 300 + ((period_ * 7) % 601);
+		}
+};
+
+/// A square wave of irregular period that swings by more than the range of an int16_t, and
+/// which can be read only as samples.
+class FullRangeSquareWave: public Outputs::Speaker::SampleSource {
+	public:
+		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+			for(std::size_t c = 0; c < number_of_samples; c++) {
+				target[c] = is_high_ ? 20000 : -20000;
+				if(++counter_ == period_) {
+					counter_ = 0;
+					is_high_ ^= true;
+					period_ = 350 + ((period_ * 5) % 431);
+				}
+			}
+		}
+
+	private:
+		int counter_ = 0;
+		int period_ = 500;
+		bool is_high_ = false;
+};
+
+/// A source of steps that never changes level.
+class Silence: public Outputs::Speaker::SampleSource {
+	public:
+		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+			std::fill(target, target + number_of_samples, 0);
+		}
+
+		template <typename TargetT> void get_steps(std::size_t, TargetT &) {}
+
+		bool is_zero_level() const {
+			return true;
+		}
+
+		static constexpr bool get_supports_steps() { return true; }
+};
+
+struct Recorder: public Outputs::Speaker::Speaker::Delegate {
+	std::vector<int16_t> samples;
+
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+		samples.insert(samples.end(), buffer.begin(), buffer.end());
+	}
+};
+
+/// @returns All output from feeding one second of @c source, clocked at @c input_rate, through a low-pass speaker.
+template <typename SourceT> std::vector<int16_t> output(
+	SourceT &source,
+	bool uses_band_limited_steps,
+	Concurrency::AsyncTaskQueue<false> &queue,
+	float input_rate = InputRate
+) {
+	Outputs::Speaker::PullLowpass<SourceT> speaker(source);
+	Recorder recorder;
+
+	speaker.set_input_rate(input_rate);
+	speaker.set_uses_band_limited_steps(uses_band_limited_steps);
+	speaker.set_output_rate(OutputRate, 512, false);
+	speaker.set_delegate(&recorder);
+
+	// Run in irregular chunks, to exercise state carried between calls.
+	const int chunk = int(input_rate / 1000.0f);
+	for(int c = 0; c < 1000; c++) {
+		speaker.run_for(queue, Cycles(chunk + ((c * 37) % (chunk / 5)) - chunk / 10));
+	}
+	queue.flush();
+
+	return recorder.samples;
+}
+
+template <typename SourceT> std::vector<int16_t> output(SourceT &source, bool uses_band_limited_steps) {
+	Concurrency::AsyncTaskQueue<false> queue;
+	return output(source, uses_band_limited_steps, queue);
+}
+
+/// @returns The root-mean-square difference between @c lhs and @c rhs, ignoring the initial @c settle samples,
+/// with @c rhs shifted by @c offset samples.
+double rms_difference(const std::vector<int16_t> &lhs, const std::vector<int16_t> &rhs, std::size_t settle, int offset) {
+	const std::size_t length = std::min(lhs.size(), rhs.size()) - std::size_t(std::abs(offset));
+	double total = 0.0;
+	for(std::size_t c = settle; c < length; c++) {
+		const double difference = double(lhs[c + std::size_t(std::max(-offset, 0))]) - double(rhs[c + std::size_t(std::max(offset, 0))]);
+		total += difference * difference;
+	}
+	return std::sqrt(total / double(length - settle));
+}
+
+/// @returns The smallest root-mean-square difference between @c lhs and @c rhs over all plausible alignments;
+/// the two conversion paths differ in latency by a small number of output samples.
+double rms_difference(const std::vector<int16_t> &lhs, const std::vector<int16_t> &rhs) {
+	double minimum = std::numeric_limits<double>::max();
+	for(int offset = -8; offset <= 8; offset++) {
+		minimum = std::min(minimum, rms_difference(lhs, rhs, 64, offset));
+	}
+	return minimum;
+}
+
+/// @returns The ratio, in decibels, of the root-mean-square level of @c signal to its root-mean-square difference from @c rhs.
+double signal_to_noise(const std::vector<int16_t> &signal, const std::vector<int16_t> &rhs) {
+	double total = 0.0;
+	for(std::size_t c = 64; c < signal.size(); c++) {
+		total += double(signal[c]) * double(signal[c]);
+	}
+	const double level = std::sqrt(total / double(signal.size() - 64));
+	return 20.0 * std::log10(level / rms_difference(signal, rhs));
+}
+
+/// Programs @c ay with two tones, one under the envelope generator, and a third channel of noise.
+template <typename AY> void program(AY &ay) {
+	const uint8_t registers[] = {
+		0x3c, 0x01,		// Channel A: tone period 0x13c.
+		0x7b, 0x00,		// Channel B: tone period 0x07b.
+		0x00, 0x00,		// Channel C: unused tone.
+		0x0b,			// Noise period.
+		0b00'011'100,	// Tone on A and B, noise on C only.
+		0x0f,			// A: maximum fixed volume.
+		0x10,			// B: envelope volume.
+		0x0c,			// C: fixed volume.
+		0x40, 0x00,		// Envelope period.
+		0x0e,			// Envelope shape: repeating triangle.
+	};
+	for(uint8_t c = 0; c < sizeof(registers); c++) {
+		GI::AY38910::Utility::select_register(ay, c);
+		GI::AY38910::Utility::write_data(ay, registers[c]);
+	}
+}
+
+/// Programs @c sn with three tones at distinct volumes, and periodic noise.
+void program(TI::SN76489 &sn) {
+	const uint8_t writes[] = {
+		0x8c, 0x0a,		// Channel 0: period 0x0ac.
+		0x90,			// Channel 0: maximum volume.
+		0xa3, 0x05,		// Channel 1: period 0x053.
+		0xb4,			// Channel 1: lesser volume.
+		0xce, 0x13,		// Channel 2: period 0x13e.
+		0xd2,			// Channel 2: volume.
+		0xe5,			// Noise: white, clocked at a fixed rate.
+		0xf6,			// Noise volume.
+	};
+	for(const auto value: writes) {
+		sn.write(value);
+	}
+}
+
+}
+
+@interface BandLimitedStepsTests : XCTestCase
+@end
+
+@implementation BandLimitedStepsTests
+
+/// Checks that band-limited step synthesis closely matches the FIR filtering path for the same input.
+- (void)testMatchesFIRFilter {
+	SquareWave filtered_source, stepped_source;
+	const auto filtered = output(filtered_source, false);
+	const auto stepped = output(stepped_source, true);
+
+	XCTAssertGreaterThan(filtered.size(), 40'000);
+	XCTAssertGreaterThan(stepped.size(), 40'000);
+	XCTAssertLessThan(rms_difference(filtered, stepped), 16383.0 * 0.03);
+}
+
+/// Checks that steps synthesised from a source that swings across the full range of an int16_t are posted
+/// in full, despite exceeding the range of an individual step.
+/// Checks that an AY's steps match its FIR-filtered samples as closely as the two paths can when its
+/// clock rate is an exact multiple of the output rate, allowing the paths to be aligned exactly.
+- (void)testAYMatchesFIRFilter {
+	Concurrency::AsyncTaskQueue<false> filtered_queue, stepped_queue;
+	GI::AY38910::AY38910<false> filtered_ay(GI::AY38910::Personality::AY38910, filtered_queue);
+	GI::AY38910::AY38910<false> stepped_ay(GI::AY38910::Personality::AY38910, stepped_queue);
+	program(filtered_ay);
+	program(stepped_ay);
+
+	const auto filtered = output(filtered_ay, false, filtered_queue, OutputRate * 2.0f);
+	const auto stepped = output(stepped_ay, true, stepped_queue, OutputRate * 2.0f);
+
+	XCTAssertGreaterThan(filtered.size(), 40'000);
+	XCTAssertGreaterThan(signal_to_noise(filtered, stepped), 75.0);
+}
+
+/// As per @c testAYMatchesFIRFilter, for an SN76489.
+- (void)testSN76489MatchesFIRFilter {
+	Concurrency::AsyncTaskQueue<false> filtered_queue, stepped_queue;
+	TI::SN76489 filtered_sn(TI::SN76489::Personality::SN76489, filtered_queue);
+	TI::SN76489 stepped_sn(TI::SN76489::Personality::SN76489, stepped_queue);
+	program(filtered_sn);
+	program(stepped_sn);
+
+	const auto filtered = output(filtered_sn, false, filtered_queue, OutputRate * 2.0f);
+	const auto stepped = output(stepped_sn, true, stepped_queue, OutputRate * 2.0f);
+
+	XCTAssertGreaterThan(filtered.size(), 40'000);
+	XCTAssertGreaterThan(signal_to_noise(filtered, stepped), 75.0);
+}
+
+- (void)testFullRangeSynthesisedSteps {
+	using Compound = Outputs::Speaker::CompoundSource<Silence, FullRangeSquareWave>;
+
+	Silence filtered_silence, stepped_silence;
+	FullRangeSquareWave filtered_wave, stepped_wave;
+	Compound filtered_source(filtered_silence, filtered_wave);
+	Compound stepped_source(stepped_silence, stepped_wave);
+
+	const auto filtered = output(filtered_source, false);
+	const auto stepped = output(stepped_source, true);
+
+	XCTAssertGreaterThan(filtered.size(), 40'000);
+	XCTAssertLessThan(rms_difference(filtered, stepped), 40000.0 * 0.03);
+}
+
+@end
@@ -19,6 +19,7 @@ typedef NS_ENUM(NSInteger, MOS6522BridgeLine) {
 @interface MOS6522Bridge : NSObject
 
 @property (nonatomic, readonly) BOOL irqLine;
+@property (nonatomic, readonly) NSInteger halfCyclesUntilSequencePoint;
 @property (nonatomic) uint8_t portBInput;
 @property (nonatomic) uint8_t portAInput;
 
@@ -68,6 +68,10 @@ class VanillaVIAPortHandler: public MOS::MOS6522::PortHandler {
 	return _viaPortHandler.irq_line;
 }
 
+- (NSInteger)halfCyclesUntilSequencePoint {
+	return (NSInteger)_via->next_sequence_point().as_integral();
+}
+
 - (void)setPortAInput:(uint8_t)portAInput {
 	_viaPortHandler.port_a_value = portAInput;
 }
@@ -76,4 +76,13 @@
 	XCTAssertEqual(crcGenerator.get_value(), 0xcbf43926);
 }
 
+- (void)testCRC32Compute {
+	const std::string check("123456789");
+	const auto data = reinterpret_cast<const uint8_t *>(check.data());
+	XCTAssertEqual(CRC::CRC32::compute(data, check.size()), 0xcbf43926);
+
+	// Test also that the CRC can be computed piecemeal.
+	XCTAssertEqual(CRC::CRC32::compute(data + 3, check.size() - 3, CRC::CRC32::compute(data, 3)), 0xcbf43926);
+}
+
 @end
@@ -0,0 +1,206 @@
+//
+//  CachingExecutorTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../InstructionSets/CachingExecutor.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace {
+
+class TestExecutor;
+using TestCachingExecutor = InstructionSet::CachingExecutor<TestExecutor, 0xfff, 3, uint8_t, false>;
+
+/*!
+	Executes a minimal instruction set, with a 4kb address space:
+
+		00			INC: increments the counter;
+		01 nn nn	JMP: jumps to nnnn;
+		02 nn nn vv	POKE: writes vv to nnnn; and
+		03			DEC: decrements the counter.
+*/
+class TestExecutor: public TestCachingExecutor {
+	public:
+		enum Opcode: uint8_t {
+			INC = 0, JMP = 1, POKE = 2, DEC = 3,
+		};
+
+		TestExecutor() {
+			performers_[INC] = &TestExecutor::inc;
+			performers_[JMP] = &TestExecutor::jmp;
+			performers_[POKE] = &TestExecutor::poke;
+			performers_[DEC] = &TestExecutor::dec;
+		}
+
+		std::array<uint8_t, 0x1000> memory{};
+		int counter = 0;
+
+		/// Writes @c value to @c address as if from some source other than the executor itself.
+		void write(uint16_t address, uint8_t value) {
+			memory[address] = value;
+			invalidate(address);
+		}
+
+		void jump(uint16_t address) {
+			set_program_counter(address);
+		}
+
+		uint16_t program_counter() const {
+			return program_counter_;
+		}
+
+		using TestCachingExecutor::run_to_branch;
+
+	private:
+		friend TestCachingExecutor;
+
+		PerformerIndex action_for(uint8_t instruction) {
+			return instruction;
+		}
+
+		void parse(uint16_t start, uint16_t closing_bound) {
+			while(start <= closing_bound) {
+				const int length = memory[start] == JMP ? 3 : (memory[start] == POKE ? 4 : 1);
+				if(start + length - 1 > closing_bound) break;
+
+				announce_instruction(start, memory[start]);
+				if(memory[start] == JMP) return;
+				start += length;
+			}
+			announce_overflow(start);
+		}
+
+		uint16_t operand(int offset) const {
+			return uint16_t(memory[(program_counter_ + offset) & 0xfff] | (memory[(program_counter_ + offset + 1) & 0xfff] << 8));
+		}
+
+		void inc() {
+			++counter;
+			++program_counter_;
+		}
+
+		void dec() {
+			--counter;
+			++program_counter_;
+		}
+
+		void jmp() {
+			set_program_counter(operand(1) & 0xfff);
+		}
+
+		void poke() {
+			const uint16_t address = operand(1) & 0xfff;
+			const uint8_t value = memory[(program_counter_ + 3) & 0xfff];
+			program_counter_ += 4;
+			write(address, value);
+		}
+};
+
+}
+
+@interface CachingExecutorTests : XCTestCase
+@end
+
+@implementation CachingExecutorTests
+
+- (void)testSelfModifyingCode {
+	TestExecutor executor;
+
+	// 000: POKE 010, INC
+	// 004: JMP 010
+	// 010: DEC
+	// 011: JMP 000
+	executor.memory = {
+		TestExecutor::POKE, 0x10, 0x00, TestExecutor::INC,
+		TestExecutor::JMP, 0x10, 0x00,
+	};
+	executor.memory[0x10] = TestExecutor::DEC;
+	executor.memory[0x11] = TestExecutor::JMP;
+
+	// Run the original code at 010 so that it's cached.
+	executor.jump(0x010);
+	executor.run_to_branch();
+	XCTAssertEqual(executor.counter, -1);
+	XCTAssertEqual(executor.program_counter(), 0x000);
+
+	// Overwrite it from within the same page, and run it again; the POKE should end the
+	// current run, and execution should resume with the following instruction.
+	executor.run_to_branch();
+	XCTAssertEqual(executor.program_counter(), 0x004);
+	executor.run_to_branch();
+	XCTAssertEqual(executor.program_counter(), 0x010);
+	executor.run_to_branch();
+	XCTAssertEqual(executor.counter, 0, @"Modified code should have been retranslated");
+}
+
+- (void)testPageBoundaryRetranslation {
+	TestExecutor executor;
+
+	// 3fe: INC
+	// 3ff: INC
+	// 400: INC
+	// 401: JMP 3fe
+	executor.memory[0x3fe] = executor.memory[0x3ff] = executor.memory[0x400] = TestExecutor::INC;
+	executor.memory[0x401] = TestExecutor::JMP;
+	executor.memory[0x402] = 0xfe;
+	executor.memory[0x403] = 0x03;
+
+	executor.jump(0x3fe);
+	executor.run_to_branch();
+	XCTAssertEqual(executor.counter, 3);
+
+	// Modify the part of the translation that lies in the following page, from outside of the
+	// executor; the translation that began in the previous page should be discarded.
+	executor.write(0x400, TestExecutor::DEC);
+	executor.run_to_branch();
+	XCTAssertEqual(executor.counter, 4, @"Code in the following page should have been retranslated");
+
+	// Also check an instruction that straddles the boundary.
+	// 3fd: POKE 500, INC
+	// 401: JMP 3fd
+	executor.memory[0x3fd] = TestExecutor::POKE;
+	executor.memory[0x3fe] = 0x00;
+	executor.memory[0x3ff] = 0x05;
+	executor.memory[0x400] = TestExecutor::INC;
+	executor.memory[0x402] = 0xfd;
+	executor.memory[0x500] = TestExecutor::DEC;
+	executor.jump(0x3fd);
+	executor.run_to_branch();
+	XCTAssertEqual(executor.memory[0x500], TestExecutor::INC);
+	XCTAssertEqual(executor.program_counter(), 0x401);
+	executor.run_to_branch();
+	XCTAssertEqual(executor.program_counter(), 0x3fd);
+	XCTAssertEqual(executor.counter, 4);
+}
+
+- (void)testEndOfAddressSpace {
+	TestExecutor executor;
+
+	// ffe: INC
+	// fff: INC
+	// 000: INC
+	// 001: JMP ffe
+	executor.memory[0xffe] = executor.memory[0xfff] = executor.memory[0x000] = TestExecutor::INC;
+	executor.memory[0x001] = TestExecutor::JMP;
+	executor.memory[0x002] = 0xfe;
+	executor.memory[0x003] = 0x0f;
+
+	// Running off the end of the address space should wrap around to the start.
+	executor.jump(0xffe);
+	executor.run_to_branch();
+	XCTAssertEqual(executor.counter, 2);
+	XCTAssertEqual(executor.program_counter(), 0x000);
+
+	executor.run_to_branch();
+	XCTAssertEqual(executor.counter, 3);
+	XCTAssertEqual(executor.program_counter(), 0xffe);
+}
+
+@end
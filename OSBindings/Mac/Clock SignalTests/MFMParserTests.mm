@@ -0,0 +1,235 @@
+//
+//  MFMParserTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Disk/Disk.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Constants.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Encoder.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Parser.hpp"
+#include "../../../Storage/Disk/Track/PCMTrack.hpp"
+#include "../../../Storage/Disk/Track/TrackSerialiser.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr int NumberOfTracks = 10;
+constexpr int SectorsPerTrack = 9;
+constexpr char Marker[] = "MFMParserTests";
+
+/// @returns The contents of sector @c sector on track @c track; sector 5 of track 3 begins with @c Marker.
+std::vector<uint8_t> contents(int track, int sector) {
+	std::vector<uint8_t> result(512);
+	for(size_t c = 0; c < result.size(); c++) {
+		result[c] = uint8_t(track * 7 + sector * 13 + int(c));
+	}
+	if(track == 3 && sector == 5) {
+		std::copy(Marker, Marker + sizeof(Marker) - 1, result.begin());
+	}
+	return result;
+}
+
+/// @returns Track @c track, in which the first byte of every sector is @c first_byte.
+std::shared_ptr<Storage::Disk::Track> make_track(int track, std::optional<uint8_t> first_byte = std::nullopt) {
+	std::vector<Storage::Encodings::MFM::Sector> sectors(SectorsPerTrack);
+	for(int c = 0; c < SectorsPerTrack; c++) {
+		sectors[size_t(c)].address.track = uint8_t(track);
+		sectors[size_t(c)].address.sector = uint8_t(c + 1);
+		sectors[size_t(c)].size = 2;
+		sectors[size_t(c)].samples.push_back(contents(track, c + 1));
+		if(first_byte) sectors[size_t(c)].samples.back()[0] = *first_byte;
+	}
+	return Storage::Encodings::MFM::TrackWithSectors(Storage::Encodings::MFM::Density::Double, sectors);
+}
+
+/// A single-sided, double-density disk that constructs a new track object upon every request,
+/// as would a distinct disk with the same contents.
+class TestDisk: public Storage::Disk::Disk {
+	public:
+		Storage::Disk::HeadPosition get_maximum_head_position() final {
+			return Storage::Disk::HeadPosition(NumberOfTracks);
+		}
+
+		int get_head_count() final {
+			return 1;
+		}
+
+		std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address address) final {
+			const int track = address.position.as_int();
+			if(address.head || track >= NumberOfTracks) return nullptr;
+			return make_track(track);
+		}
+
+		void set_track_at_position(Storage::Disk::Track::Address, const std::shared_ptr<Storage::Disk::Track> &) final {}
+		void flush_tracks() final {}
+		bool get_is_read_only() final { return true; }
+		bool tracks_differ(Storage::Disk::Track::Address, Storage::Disk::Track::Address) final { return true; }
+};
+
+/// A disk consisting of a single track, which is retained as would be a track that had been written to.
+class WritableTrackDisk: public Storage::Disk::Disk {
+	public:
+		std::shared_ptr<Storage::Disk::PCMTrack> track{Storage::Disk::PCMTrack::resampled_clone(make_track(0).get(), 3'200'000)};
+
+		Storage::Disk::HeadPosition get_maximum_head_position() final {
+			return Storage::Disk::HeadPosition(1);
+		}
+
+		int get_head_count() final {
+			return 1;
+		}
+
+		std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address address) final {
+			if(address.head || address.position.as_int()) return nullptr;
+			return track;
+		}
+
+		void set_track_at_position(Storage::Disk::Track::Address, const std::shared_ptr<Storage::Disk::Track> &) final {}
+		void flush_tracks() final {}
+		bool get_is_read_only() final { return false; }
+		bool tracks_differ(Storage::Disk::Track::Address, Storage::Disk::Track::Address) final { return true; }
+};
+
+/// @returns The name of a new, empty temporary file.
+std::string temporary_file() {
+	std::string name = std::string(P_tmpdir) + "/MFMParserTestsXXXXXX";
+	close(mkstemp(name.data()));
+	return name;
+}
+
+std::vector<uint8_t> file_contents(const std::string &name) {
+	std::vector<uint8_t> result;
+	FILE *const file = std::fopen(name.c_str(), "rb");
+	int next;
+	while((next = std::fgetc(file)) != EOF) {
+		result.push_back(uint8_t(next));
+	}
+	std::fclose(file);
+	return result;
+}
+
+void set_file_contents(const std::string &name, const std::vector<uint8_t> &contents) {
+	FILE *const file = std::fopen(name.c_str(), "wb");
+	std::fwrite(contents.data(), 1, contents.size(), file);
+	std::fclose(file);
+}
+
+}
+
+@interface MFMParserTests : XCTestCase
+@end
+
+@implementation MFMParserTests
+
+- (void)testDecodeAllTracks {
+	using namespace Storage::Encodings::MFM;
+	Parser::clear_cache();
+
+	Parser parser(Density::Double, std::make_shared<TestDisk>());
+	parser.decode_all_tracks();
+
+	for(int track = 0; track < NumberOfTracks; track++) {
+		for(int sector = 1; sector <= SectorsPerTrack; sector++) {
+			const auto found = parser.sector(0, track, uint8_t(sector));
+			XCTAssert(found != nullptr);
+			if(!found) continue;
+
+			XCTAssertEqual(found->samples.size(), 1);
+			XCTAssert(found->samples[0] == contents(track, sector));
+		}
+	}
+}
+
+- (void)testModifiedTrack {
+	using namespace Storage::Encodings::MFM;
+	Parser::clear_cache();
+
+	const auto disk = std::make_shared<WritableTrackDisk>();
+	{
+		Parser parser(Density::Double, disk);
+		XCTAssert(parser.sector(0, 0, 1)->samples[0] == contents(0, 1));
+	}
+
+	// Overwrite the whole track in place, as a drive would, and parse it again.
+	const auto replacement = make_track(0, 0xa5);
+	disk->track->add_segment(
+		Storage::Time(0),
+		Storage::Disk::track_serialisation(*replacement, bit_length(Density::Double)),
+		true);
+
+	Parser parser(Density::Double, disk);
+	for(int sector = 1; sector <= SectorsPerTrack; sector++) {
+		const auto found = parser.sector(0, 0, uint8_t(sector));
+		XCTAssert(found != nullptr);
+		if(!found) continue;
+
+		auto expected = contents(0, sector);
+		expected[0] = 0xa5;
+		XCTAssert(found->samples[0] == expected);
+	}
+
+	Parser::clear_cache();
+}
+
+- (void)testCacheRoundTrip {
+	using namespace Storage::Encodings::MFM;
+
+	const std::string name = temporary_file();
+	XCTAssertFalse(Parser::load_cache(name), @"An empty file should not be a valid cache");
+	Parser::clear_cache();
+
+	// Decode an entire disk and save the results.
+	{
+		Parser parser(Density::Double, std::make_shared<TestDisk>());
+		parser.decode_all_tracks();
+		XCTAssert(parser.sector(0, 3, 5)->samples[0] == contents(3, 5));
+	}
+	XCTAssert(Parser::save_cache(name));
+
+	// Amend the saved copy of the marked sector, so that results taken from the file can be distinguished.
+	auto saved = file_contents(name);
+	const auto marker = std::search(saved.begin(), saved.end(), Marker, Marker + sizeof(Marker) - 1);
+	XCTAssert(marker != saved.end());
+	if(marker == saved.end()) return;
+	*marker = 'm';
+	set_file_contents(name, saved);
+
+	// Reload; a parser of a disk with the same contents should find the amended sector.
+	Parser::clear_cache();
+	XCTAssert(Parser::load_cache(name));
+	{
+		Parser parser(Density::Double, std::make_shared<TestDisk>());
+		auto expected = contents(3, 5);
+		expected[0] = 'm';
+		XCTAssert(parser.sector(0, 3, 5)->samples[0] == expected);
+		XCTAssert(parser.sector(0, 3, 4)->samples[0] == contents(3, 4));
+		XCTAssert(parser.sector(0, 9, 9)->samples[0] == contents(9, 9));
+	}
+
+	// Saving again should reproduce the file that was loaded.
+	const std::string resaved_name = temporary_file();
+	XCTAssert(Parser::save_cache(resaved_name));
+	XCTAssert(file_contents(resaved_name) == saved);
+
+	// A truncated file should be rejected.
+	saved.resize(saved.size() - 100);
+	set_file_contents(name, saved);
+	XCTAssertFalse(Parser::load_cache(name));
+
+	Parser::clear_cache();
+	std::remove(name.c_str());
+	std::remove(resaved_name.c_str());
+}
+
+@end
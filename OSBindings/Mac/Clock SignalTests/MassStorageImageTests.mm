@@ -0,0 +1,145 @@
+//
+//  MassStorageImageTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/MassStorage/Formats/RawSectorDump.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using Image = Storage::MassStorage::RawSectorDump<256>;
+constexpr size_t NumberOfBlocks = 16;
+
+/// @returns Sixteen 256-byte blocks, each filled with a pattern derived from its index.
+std::vector<uint8_t> original_contents() {
+	std::vector<uint8_t> contents(NumberOfBlocks * 256);
+	for(size_t c = 0; c < contents.size(); c++) {
+		contents[c] = uint8_t((c >> 8) ^ (c * 3));
+	}
+	return contents;
+}
+
+/// @returns A 256-byte block with every byte set to @c value.
+std::vector<uint8_t> block_of(uint8_t value) {
+	return std::vector<uint8_t>(256, value);
+}
+
+/// @returns The contents of block @c address of @c contents.
+std::vector<uint8_t> block_at(const std::vector<uint8_t> &contents, size_t address) {
+	return std::vector<uint8_t>(contents.begin() + long(address * 256), contents.begin() + long((address + 1) * 256));
+}
+
+/// Owns a temporary file, which is removed upon destruction.
+struct TemporaryFile {
+	std::string name = std::string(P_tmpdir) + "/MassStorageImageTestsXXXXXX";
+
+	TemporaryFile(const std::vector<uint8_t> &contents) {
+		const int fd = mkstemp(name.data());
+		::write(fd, contents.data(), contents.size());
+		close(fd);
+	}
+
+	~TemporaryFile() {
+		std::remove(name.c_str());
+	}
+
+	std::vector<uint8_t> contents() const {
+		std::vector<uint8_t> result(NumberOfBlocks * 256);
+		FILE *const file = std::fopen(name.c_str(), "rb");
+		result.resize(std::fread(result.data(), 1, result.size(), file));
+		std::fclose(file);
+		return result;
+	}
+};
+
+}
+
+@interface MassStorageImageTests : XCTestCase
+@end
+
+@implementation MassStorageImageTests
+
+- (void)testReadWrite {
+	const auto original = original_contents();
+	TemporaryFile file(original);
+
+	{
+		Image image(file.name);
+		XCTAssertEqual(image.get_number_of_blocks(), NumberOfBlocks);
+		XCTAssert(image.get_block(5) == block_at(original, 5));
+
+		image.set_block(5, block_of(0xa5));
+		XCTAssert(image.get_block(5) == block_of(0xa5));
+		XCTAssert(image.get_block(6) == block_at(original, 6));
+
+		// Once flushed, the write should be in the file.
+		image.flush();
+		XCTAssert(block_at(file.contents(), 5) == block_of(0xa5));
+	}
+
+	// It should also be visible to subsequent users of the file.
+	Image image(file.name);
+	XCTAssert(image.get_block(5) == block_of(0xa5));
+	XCTAssert(image.get_block(4) == block_at(original, 4));
+}
+
+- (void)testCopyOnWrite {
+	const auto original = original_contents();
+	TemporaryFile file(original);
+
+	{
+		Image image(file.name, 0, -1, true);
+		image.set_block(0, block_of(0x11));
+		image.set_block(15, block_of(0x22));
+		image.flush();
+
+		// Writes should be visible through the image...
+		XCTAssert(image.get_block(0) == block_of(0x11));
+		XCTAssert(image.get_block(15) == block_of(0x22));
+		XCTAssert(image.get_block(1) == block_at(original, 1));
+
+		// ... but not in the file.
+		XCTAssert(file.contents() == original);
+	}
+
+	XCTAssert(file.contents() == original);
+	Image image(file.name);
+	XCTAssert(image.get_block(0) == block_at(original, 0));
+}
+
+- (void)testReadOnlyFallback {
+	// In-memory files can be opened only for reading, and can't be mapped.
+	const std::string name = "MassStorageImageTests.dat";
+	const auto original = std::make_shared<const std::vector<uint8_t>>(original_contents());
+	Storage::FileHolder::add_in_memory_file(name, original);
+
+	{
+		Image image(name);
+		XCTAssertEqual(image.get_number_of_blocks(), NumberOfBlocks);
+
+		image.set_block(3, block_of(0x33));
+		image.flush();
+		XCTAssert(image.get_block(3) == block_of(0x33));
+		XCTAssert(image.get_block(2) == block_at(*original, 2));
+		XCTAssert(*original == original_contents());
+	}
+
+	Image image(name);
+	XCTAssert(image.get_block(3) == block_at(*original, 3));
+
+	Storage::FileHolder::remove_in_memory_file(name);
+}
+
+@end
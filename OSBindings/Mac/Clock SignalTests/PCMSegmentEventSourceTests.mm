@@ -11,6 +11,27 @@
 #include "PCMSegment.hpp"
 
 @interface PCMSegmentEventSourceTests : XCTestCase
+- (void)testWordBoundaries {
+	Storage::Disk::PCMSegment segment;
+	segment.length_of_a_bit = Storage::Time(1, 10);
+	segment.data.resize(256);
+	segment.data[63] = true;
+	segment.data[64] = true;
+	segment.data[200] = true;
+
+	Storage::Disk::PCMSegmentEventSource segmentSource(segment);
+	const unsigned expected_lengths[] = {127, 2, 272, 111};
+	for(const auto expected_length: expected_lengths) {
+		Storage::Disk::Track::Event event = segmentSource.get_next_event();
+		XCTAssertEqual(event.type, expected_length == 111 ? Storage::Disk::Track::Event::IndexHole : Storage::Disk::Track::Event::FluxTransition);
+
+		event.length.simplify();
+		Storage::Time expected(expected_length, 20);
+		expected.simplify();
+		XCTAssertTrue(event.length == expected, @"Events should be found across word boundaries");
+	}
+}
+
 @end
 
 @implementation PCMSegmentEventSourceTests
@@ -93,4 +114,25 @@
 	XCTAssertTrue(next_event.type == Storage::Disk::Track::Event::IndexHole, @"End should have been reached");
 }
 
+- (void)testWordBoundaries {
+	Storage::Disk::PCMSegment segment;
+	segment.length_of_a_bit = Storage::Time(1, 10);
+	segment.data.resize(256);
+	segment.data[63] = true;
+	segment.data[64] = true;
+	segment.data[200] = true;
+
+	Storage::Disk::PCMSegmentEventSource segmentSource(segment);
+	const unsigned expected_lengths[] = {127, 2, 272, 111};
+	for(const auto expected_length: expected_lengths) {
+		Storage::Disk::Track::Event event = segmentSource.get_next_event();
+		XCTAssertEqual(event.type, expected_length == 111 ? Storage::Disk::Track::Event::IndexHole : Storage::Disk::Track::Event::FluxTransition);
+
+		event.length.simplify();
+		Storage::Time expected(expected_length, 20);
+		expected.simplify();
+		XCTAssertTrue(event.length == expected, @"Events should be found across word boundaries");
+	}
+}
+
 @end
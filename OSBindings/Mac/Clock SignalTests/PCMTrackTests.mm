@@ -53,16 +53,13 @@
 	std::vector<Storage::Disk::PCMSegment> segments;
 
 	Storage::Disk::PCMSegment sync_segment;
-	sync_segment.data.resize(10*8);
-	std::fill(sync_segment.data.begin(), sync_segment.data.end(), true);
+	sync_segment.data.resize(10*8, true);
 
 	Storage::Disk::PCMSegment header_segment;
-	header_segment.data.resize(14*8);
-	std::fill(header_segment.data.begin(), header_segment.data.end(), true);
+	header_segment.data.resize(14*8, true);
 
 	Storage::Disk::PCMSegment data_segment;
-	data_segment.data.resize(349*8);
-	std::fill(data_segment.data.begin(), data_segment.data.end(), true);
+	data_segment.data.resize(349*8, true);
 
 	for(std::size_t c = 0; c < 16; ++c) {
 		segments.push_back(sync_segment);
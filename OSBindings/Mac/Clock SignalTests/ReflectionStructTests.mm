@@ -0,0 +1,274 @@
+//
+//  ReflectionStructTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Reflection/Struct.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+ReflectableEnum(Colour, Red, Green, Blue);
+
+struct Inner: public Reflection::StructImpl<Inner> {
+	int32_t value = 0;
+	std::string label;
+
+	Inner() {
+		if(needs_declare()) {
+			DeclareField(value);
+			DeclareField(label);
+		}
+	}
+};
+
+/// Contains at least one field of every kind that can be serialised, including arrays.
+struct Everything: public Reflection::StructImpl<Everything> {
+	bool flag = false;
+	Colour colour = Colour::Red;
+	int8_t int8 = 0;
+	uint8_t uint8 = 0;
+	int16_t int16 = 0;
+	uint16_t uint16 = 0;
+	int32_t int32 = 0;
+	uint32_t uint32 = 0;
+	int64_t int64 = 0;
+	float float32 = 0.0f;
+	double float64 = 0.0;
+	std::string text;
+	std::vector<uint8_t> binary;
+	uint16_t words[4]{};
+	Colour colours[3]{};
+	Inner inner;
+
+	Everything() {
+		if(needs_declare()) {
+			AnnounceEnum(Colour);
+
+			DeclareField(flag);
+			DeclareField(colour);
+			DeclareField(int8);
+			DeclareField(uint8);
+			DeclareField(int16);
+			DeclareField(uint16);
+			DeclareField(int32);
+			DeclareField(uint32);
+			DeclareField(int64);
+			DeclareField(float32);
+			DeclareField(float64);
+			DeclareField(text);
+			DeclareField(binary);
+			DeclareField(words);
+			DeclareField(colours);
+			DeclareField(inner);
+		}
+	}
+
+	/// Populates every field with a value other than its default.
+	void populate() {
+		flag = true;
+		colour = Colour::Blue;
+		int8 = -100;
+		uint8 = 200;
+		int16 = -30000;
+		uint16 = 60000;
+		int32 = -2'000'000'000;
+		uint32 = 4'000'000'000;
+		int64 = -9'000'000'000'000;
+		float32 = 1.5f;
+		float64 = -3.25e10;
+		text = "Clock Signal";
+		binary = {0x00, 0xff, 0x12, 0x34};
+		words[0] = 1;	words[1] = 0xffff;	words[2] = 0x1234;	words[3] = 9;
+		colours[0] = Colour::Green;	colours[1] = Colour::Blue;	colours[2] = Colour::Red;
+		inner.value = 42;
+		inner.label = "inner";
+	}
+
+	bool operator ==(const Everything &rhs) const {
+		return
+			flag == rhs.flag && colour == rhs.colour &&
+			int8 == rhs.int8 && uint8 == rhs.uint8 && int16 == rhs.int16 && uint16 == rhs.uint16 &&
+			int32 == rhs.int32 && uint32 == rhs.uint32 && int64 == rhs.int64 &&
+			float32 == rhs.float32 && float64 == rhs.float64 &&
+			text == rhs.text && binary == rhs.binary &&
+			!memcmp(words, rhs.words, sizeof(words)) && !memcmp(colours, rhs.colours, sizeof(colours)) &&
+			inner.value == rhs.inner.value && inner.label == rhs.inner.label;
+	}
+};
+
+/// Exposes the fields of an @c Everything without offering a plan, so that it is serialised by name.
+struct ByName: public Reflection::Struct {
+	Everything &target;
+	ByName(Everything &target) : target(target) {}
+
+	std::vector<std::string> all_keys() const final { return target.all_keys(); }
+	const std::type_info *type_of(const std::string &name) const final { return target.type_of(name); }
+	size_t count_of(const std::string &name) const final { return target.count_of(name); }
+	void set(const std::string &name, const void *value, size_t offset) final { target.set(name, value, offset); }
+	void *get(const std::string &name) final { return target.get(name); }
+	std::vector<std::string> values_for(const std::string &name) const final { return target.values_for(name); }
+};
+
+/// Builds BSON documents by hand, permitting orders and contents that @c serialise wouldn't produce.
+struct BSONWriter {
+	std::vector<uint8_t> data;
+
+	size_t open() {
+		data.insert(data.end(), 4, 0);
+		return data.size() - 4;
+	}
+
+	void close(size_t start) {
+		data.push_back(0);
+		const auto size = uint32_t(data.size() - start);
+		memcpy(&data[start], &size, 4);	// BSON is little endian, as is every host this test runs on.
+	}
+
+	void name(uint8_t type, const std::string &key) {
+		data.push_back(type);
+		data.insert(data.end(), key.begin(), key.end());
+		data.push_back(0);
+	}
+
+	void int32(const std::string &key, int32_t value) {
+		name(0x10, key);
+		const auto bytes = reinterpret_cast<const uint8_t *>(&value);
+		data.insert(data.end(), bytes, bytes + 4);
+	}
+
+	void string(const std::string &key, const std::string &value) {
+		name(0x02, key);
+		const auto length = uint32_t(value.size() + 1);
+		const auto bytes = reinterpret_cast<const uint8_t *>(&length);
+		data.insert(data.end(), bytes, bytes + 4);
+		data.insert(data.end(), value.begin(), value.end());
+		data.push_back(0);
+	}
+
+	size_t open(uint8_t type, const std::string &key) {
+		name(type, key);
+		return open();
+	}
+};
+
+/// @returns BSON that sets fields of an @c Everything in an order other than that of its plan, interspersed
+/// with keys it doesn't declare and with array elements beyond the ends of its arrays.
+std::vector<uint8_t> disordered_bson() {
+	BSONWriter writer;
+	const auto document = writer.open();
+
+	writer.string("text", "disordered");
+	writer.int32("unknown", 7);
+
+	const auto colours = writer.open(0x04, "colours");
+	writer.string("2", "Green");
+	writer.string("3", "Blue");			// Out of range.
+	writer.string("0", "Blue");
+	writer.close(colours);
+
+	writer.int32("uint8", 99);
+
+	const auto unknown_array = writer.open(0x04, "unknown_array");
+	writer.int32("0", 1);
+	writer.int32("1", 2);
+	writer.close(unknown_array);
+
+	const auto words = writer.open(0x04, "words");
+	writer.int32("1", 0x4321);
+	writer.int32("4", 0x5555);			// Out of range.
+	writer.int32("99", 0x6666);			// Out of range.
+	writer.int32("3", 0x7777);
+	writer.close(words);
+
+	const auto inner = writer.open(0x03, "inner");
+	writer.string("label", "reordered");
+	writer.int32("extra", 3);
+	writer.int32("value", -5);
+	writer.close(inner);
+
+	const auto unknown_document = writer.open(0x03, "unknown_document");
+	writer.int32("uint8", 1);
+	writer.close(unknown_document);
+
+	writer.string("colour", "Green");
+	writer.int32("int8", -3);
+
+	writer.close(document);
+	return writer.data;
+}
+
+}
+
+@interface ReflectionStructTests : XCTestCase
+@end
+
+@implementation ReflectionStructTests
+
+- (void)testPlannedSerialisationMatchesByName {
+	Everything everything;
+	everything.populate();
+
+	const auto planned = everything.serialise();
+	const auto by_name = ByName(everything).serialise();
+	XCTAssertFalse(planned.empty());
+	XCTAssert(planned == by_name);
+
+	// The size of the document should be as declared.
+	uint32_t size;
+	memcpy(&size, planned.data(), 4);
+	XCTAssertEqual(size, planned.size());
+}
+
+- (void)testRoundTrip {
+	Everything original;
+	original.populate();
+	const auto bson = original.serialise();
+
+	Everything planned;
+	XCTAssert(planned.deserialise(bson));
+	XCTAssert(planned == original);
+
+	Everything by_name_target;
+	ByName by_name(by_name_target);
+	XCTAssert(by_name.deserialise(bson));
+	XCTAssert(by_name_target == original);
+}
+
+- (void)testDisorderedDeserialisation {
+	const auto bson = disordered_bson();
+
+	Everything expected;
+	expected.populate();
+	expected.text = "disordered";
+	expected.colours[2] = Colour::Green;
+	expected.colours[0] = Colour::Blue;
+	expected.uint8 = 99;
+	expected.words[1] = 0x4321;
+	expected.words[3] = 0x7777;
+	expected.inner.label = "reordered";
+	expected.inner.value = -5;
+	expected.colour = Colour::Green;
+	expected.int8 = -3;
+
+	Everything planned;
+	planned.populate();
+	XCTAssert(planned.deserialise(bson));
+	XCTAssert(planned == expected);
+
+	Everything by_name_target;
+	by_name_target.populate();
+	ByName by_name(by_name_target);
+	XCTAssert(by_name.deserialise(bson));
+	XCTAssert(by_name_target == expected);
+}
+
+@end
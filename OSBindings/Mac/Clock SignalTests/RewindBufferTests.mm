@@ -0,0 +1,131 @@
+//
+//  RewindBufferTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Utility/RewindBuffer.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct TestState: public Reflection::StructImpl<TestState> {
+	std::vector<uint8_t> ram;
+	int counter = 0;
+
+	TestState() {
+		if(needs_declare()) {
+			DeclareField(ram);
+			DeclareField(counter);
+		}
+	}
+};
+
+/// A 'machine' that consists of some RAM and a counter, neither of which does anything by itself.
+struct TestMachine: public MachineTypes::StateProducer {
+	std::vector<uint8_t> ram = std::vector<uint8_t>(16 * 1024);
+	int counter = 0;
+
+	/// Increments the counter and scribbles on a little of RAM.
+	void advance() {
+		++counter;
+		for(size_t c = 0; c < 16; c++) {
+			ram[(size_t(counter) * 97 + c * 13) % ram.size()] = uint8_t(counter + c);
+		}
+	}
+
+	std::unique_ptr<Reflection::Struct> get_state() final {
+		auto state = std::make_unique<TestState>();
+		get_state(*state);
+		return state;
+	}
+
+	bool get_state(Reflection::Struct &state) final {
+		auto *const test_state = dynamic_cast<TestState *>(&state);
+		if(!test_state) return false;
+		test_state->ram = ram;
+		test_state->counter = counter;
+		return true;
+	}
+
+	bool set_state(const Reflection::Struct &state) final {
+		const auto *const test_state = dynamic_cast<const TestState *>(&state);
+		if(!test_state) return false;
+		ram = test_state->ram;
+		counter = test_state->counter;
+		return true;
+	}
+};
+
+}
+
+@interface RewindBufferTests : XCTestCase
+@end
+
+@implementation RewindBufferTests
+
+- (void)testRewind {
+	TestMachine machine;
+	Machine::RewindBuffer buffer(machine, 1024 * 1024, 1, 4);
+
+	// Capture ten states, keeping copies of the originals, to cover keyframes and deltas.
+	std::vector<std::vector<uint8_t>> rams;
+	for(int c = 0; c < 10; c++) {
+		machine.advance();
+		rams.push_back(machine.ram);
+		XCTAssert(buffer.capture());
+	}
+	XCTAssertEqual(buffer.size(), 10);
+	XCTAssertLessThan(buffer.memory_used(), machine.ram.size() * 4, @"Deltas should be smaller than complete states");
+
+	// Mutate further, then step back to the most recent state.
+	machine.advance();
+	machine.advance();
+	XCTAssert(buffer.rewind());
+	XCTAssertEqual(machine.counter, 10);
+	XCTAssert(machine.ram == rams[9]);
+	XCTAssertEqual(buffer.size(), 9);
+
+	// Step back by several states at once, to a delta.
+	XCTAssert(buffer.rewind(3));
+	XCTAssertEqual(machine.counter, 7);
+	XCTAssert(machine.ram == rams[6]);
+
+	// Capturing after a rewind should continue from the restored state.
+	machine.advance();
+	XCTAssert(buffer.capture());
+	XCTAssert(buffer.rewind(1));
+	XCTAssertEqual(machine.counter, 8);
+
+	// Rewind all the way back to the initial keyframe.
+	XCTAssert(buffer.rewind(buffer.size()));
+	XCTAssertEqual(machine.counter, 1);
+	XCTAssert(machine.ram == rams[0]);
+	XCTAssertEqual(buffer.size(), 0);
+	XCTAssertFalse(buffer.rewind());
+}
+
+- (void)testMemoryLimit {
+	TestMachine machine;
+	Machine::RewindBuffer buffer(machine, 16 * 1024, 1, 8);
+
+	for(int c = 0; c < 200; c++) {
+		machine.advance();
+		XCTAssert(buffer.capture());
+		XCTAssertLessThanOrEqual(buffer.memory_used(), 16 * 1024);
+	}
+	XCTAssertLessThan(buffer.size(), 200, @"Old states should have been discarded");
+
+	// The oldest state retained should still be restorable.
+	const size_t size = buffer.size();
+	XCTAssert(buffer.rewind(size));
+	XCTAssertEqual(machine.counter, 200 - int(size) + 1);
+}
+
+@end
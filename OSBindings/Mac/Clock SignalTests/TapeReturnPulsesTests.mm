@@ -0,0 +1,111 @@
+//
+//  TapeReturnPulsesTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Tape/Tape.hpp"
+
+namespace {
+
+/// An endless tape of pulses that are numbered by their lengths: the nth pulse is n+1 units long.
+class CountingTape: public Storage::Tape::Tape {
+	private:
+		unsigned int next_ = 0;
+
+		Pulse virtual_get_next_pulse() final {
+			++next_;
+			return Pulse(Pulse::High, Storage::Time(next_, 1000u));
+		}
+
+		void virtual_reset() final {
+			next_ = 0;
+		}
+
+		bool virtual_is_at_end() final {
+			return false;
+		}
+};
+
+/// @returns The index of @c pulse as provided by a @c CountingTape.
+unsigned int index(const Storage::Tape::Tape::Pulse &pulse) {
+	return pulse.length.length - 1;
+}
+
+}
+
+@interface TapeReturnPulsesTests : XCTestCase
+@end
+
+@implementation TapeReturnPulsesTests {
+	CountingTape _tape;
+	Storage::Tape::Tape::Pulse _pulses[10];
+}
+
+- (void)testReturn {
+	XCTAssertEqual(_tape.get_next_pulses(_pulses, 10), 10);
+	_tape.return_pulses(4);
+
+	XCTAssertEqual(_tape.get_offset(), 6);
+	XCTAssertEqual(index(_tape.get_next_pulse()), 6);
+}
+
+- (void)testReturnMoreThanSupplied {
+	_tape.get_next_pulse();
+	XCTAssertEqual(_tape.get_next_pulses(_pulses, 10), 10);
+	_tape.return_pulses(20);
+
+	XCTAssertEqual(_tape.get_offset(), 1);
+	XCTAssertEqual(index(_tape.get_next_pulse()), 1);
+}
+
+- (void)testReturnAfterReset {
+	_tape.get_next_pulses(_pulses, 10);
+	_tape.reset();
+	_tape.return_pulses(4);
+
+	XCTAssertEqual(_tape.get_offset(), 0);
+	XCTAssertEqual(index(_tape.get_next_pulse()), 0);
+}
+
+- (void)testReturnAfterSetOffset {
+	_tape.get_next_pulses(_pulses, 10);
+	_tape.set_offset(3);
+	_tape.return_pulses(4);
+
+	XCTAssertEqual(_tape.get_offset(), 3);
+	XCTAssertEqual(index(_tape.get_next_pulse()), 3);
+}
+
+- (void)testReturnAfterSeek {
+	_tape.get_next_pulses(_pulses, 10);
+
+	// Pulses 0–3 have a total length of 10/1000ths, so this seeks into pulse 4.
+	Storage::Time time(11, 1000);
+	_tape.seek(time);
+	const auto offset = _tape.get_offset();
+	_tape.return_pulses(10);
+
+	XCTAssertEqual(_tape.get_offset(), offset);
+}
+
+- (void)testReturnAfterNextBatch {
+	// Consume the first batch, which get_next_pulses will cut short at its end, then fetch a single pulse from the next.
+	uint64_t supplied = 0;
+	while(true) {
+		const auto count = _tape.get_next_pulses(_pulses, 10);
+		supplied += count;
+		if(count < 10) break;
+	}
+	const auto next = _tape.get_next_pulse();
+	_tape.return_pulses(10);
+
+	XCTAssertEqual(index(next), supplied);
+	XCTAssertEqual(_tape.get_offset(), supplied + 1);
+}
+
+@end
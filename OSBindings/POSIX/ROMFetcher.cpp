@@ -0,0 +1,221 @@
+//
+//  ROMFetcher.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include "ROMFetcher.hpp"
+
+#include "../../Numeric/CRC.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <sys/stat.h>
+
+using namespace POSIX;
+
+namespace {
+
+// Nothing larger than this is considered to be a ROM.
+constexpr off_t MaxROMSize = 8 * 1024 * 1024;
+
+/// @returns The file in which to store the ROM index, creating its directory if necessary.
+std::string rom_index_file_name() {
+	const char *const cache_home = getenv("XDG_CACHE_HOME");
+	std::string directory;
+	if(cache_home && *cache_home) {
+		directory = cache_home;
+	} else {
+		const char *const home = getenv("HOME");
+		if(!home) return "";
+		directory = std::string(home) + "/.cache";
+	}
+	mkdir(directory.c_str(), 0755);
+
+	directory += "/CLK";
+	mkdir(directory.c_str(), 0755);
+	return directory + "/rom-index";
+}
+
+}
+
+std::optional<std::vector<uint8_t>> POSIX::contents_of_file(const std::string &path) {
+	FILE *const file = std::fopen(path.c_str(), "rb");
+	if(!file) return std::nullopt;
+
+	std::vector<uint8_t> data;
+	std::fseek(file, 0, SEEK_END);
+	data.resize(size_t(std::ftell(file)));
+	std::fseek(file, 0, SEEK_SET);
+	const std::size_t read = std::fread(data.data(), 1, data.size(), file);
+	std::fclose(file);
+
+	if(read != data.size()) return std::nullopt;
+	return data;
+}
+
+// MARK: - ROMIndex.
+
+ROMIndex::ROMIndex(const std::string &index_file_name, const std::vector<std::string> &directories) {
+	load(index_file_name);
+
+	std::map<std::string, Entry> previous_entries;
+	std::swap(previous_entries, entries_);
+	for(const auto &directory: directories) {
+		scan(directory, 1, previous_entries);
+	}
+
+	if(has_changed_ || !previous_entries.empty()) {
+		save(index_file_name);
+	}
+
+	for(const auto &entry: entries_) {
+		paths_.emplace(std::make_pair(entry.second.size, entry.second.crc32), entry.first);
+	}
+}
+
+std::optional<std::string> ROMIndex::find(std::size_t size, uint32_t crc32) const {
+	const auto path = paths_.find(std::make_pair(size, crc32));
+	if(path == paths_.end()) return std::nullopt;
+	return path->second;
+}
+
+void ROMIndex::scan(const std::string &directory, int depth, std::map<std::string, Entry> &previous_entries) {
+	DIR *const listing = opendir(directory.c_str());
+	if(!listing) return;
+
+	while(const dirent *const item = readdir(listing)) {
+		if(item->d_name[0] == '.') continue;
+
+		const std::string path = directory + item->d_name;
+		if(entries_.find(path) != entries_.end()) continue;
+
+		struct stat stats;
+		if(stat(path.c_str(), &stats)) continue;
+
+		if(S_ISDIR(stats.st_mode)) {
+			if(depth) scan(path + "/", depth - 1, previous_entries);
+			continue;
+		}
+		if(!S_ISREG(stats.st_mode) || !stats.st_size || stats.st_size > MaxROMSize) continue;
+
+		// Reuse the previous CRC if this file appears to be unchanged.
+		const auto previous = previous_entries.find(path);
+		if(
+			previous != previous_entries.end() &&
+			previous->second.size == std::size_t(stats.st_size) &&
+			previous->second.modification_time == int64_t(stats.st_mtime)
+		) {
+			entries_.insert(previous_entries.extract(previous));
+			continue;
+		}
+
+		const auto contents = contents_of_file(path);
+		if(!contents) continue;
+		entries_[path] = Entry{contents->size(), int64_t(stats.st_mtime), CRC::CRC32::compute(*contents)};
+		has_changed_ = true;
+	}
+
+	closedir(listing);
+}
+
+void ROMIndex::load(const std::string &index_file_name) {
+	std::ifstream file(index_file_name);
+	std::string line;
+	while(std::getline(file, line)) {
+		std::istringstream fields(line);
+		Entry entry;
+		std::string path;
+		fields >> std::hex >> entry.crc32 >> std::dec >> entry.size >> entry.modification_time;
+		fields.get();
+		std::getline(fields, path);
+		if(fields.fail() || path.empty()) continue;
+		entries_[path] = entry;
+	}
+}
+
+void ROMIndex::save(const std::string &index_file_name) {
+	std::ofstream file(index_file_name, std::ios::trunc);
+	for(const auto &entry: entries_) {
+		file <<
+			std::hex << std::setw(8) << std::setfill('0') << entry.second.crc32 << std::dec << ' ' <<
+			entry.second.size << ' ' << entry.second.modification_time << ' ' << entry.first << '\n';
+	}
+}
+
+// MARK: - ROMFetcher.
+
+ROMFetcher::ROMFetcher(const std::string &rompath) :
+	paths_{
+		"/usr/local/share/CLK/",
+		"/usr/share/CLK/"
+	} {
+	if(rompath.empty()) return;
+	std::string path = rompath;
+
+	// Ensure the path ends in a slash.
+	if(path.back() != '/') {
+		path += '/';
+	}
+
+	// If ~ is present, expand it to %HOME%.
+	const size_t tilde_position = path.find("~");
+	const char *const home = getenv("HOME");
+	if(tilde_position != std::string::npos && home) {
+		path.replace(tilde_position, 1, home);
+	}
+
+	paths_.push_back(path);
+}
+
+ROM::Map ROMFetcher::operator()(const ROM::Request &roms) {
+	// Index everything in the search paths upon first use.
+	if(!index_) {
+		index_.emplace(rom_index_file_name(), paths_);
+	}
+
+	ROM::Map results;
+	for(const auto &description: roms.all_descriptions()) {
+		for(const auto &file_name: description.file_names) {
+			std::optional<std::vector<uint8_t>> contents;
+			std::vector<std::string> rom_checked_paths;
+			for(const auto &path: paths_) {
+				std::string local_path = path + description.machine_name + "/" + file_name;
+				contents = contents_of_file(local_path);
+				rom_checked_paths.push_back(local_path);
+				if(contents) break;
+			}
+
+			if(!contents) {
+				std::copy(rom_checked_paths.begin(), rom_checked_paths.end(), std::back_inserter(checked_paths_));
+				continue;
+			}
+
+			results[description.name] = std::move(*contents);
+		}
+
+		// If no file was found by name, look for any that is known to be a good copy.
+		if(results.find(description.name) != results.end()) continue;
+		for(const auto crc32: description.crc32s) {
+			const auto path = index_->find(description.size, crc32);
+			if(!path) continue;
+
+			auto contents = contents_of_file(*path);
+			if(contents) {
+				results[description.name] = std::move(*contents);
+				break;
+			}
+		}
+	}
+
+	missing_roms_ = roms.subtract(results);
+	return results;
+}
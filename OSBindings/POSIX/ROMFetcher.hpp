@@ -0,0 +1,94 @@
+//
+//  ROMFetcher.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 17/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "../../Machines/ROMMachine.hpp"
+#include "../../Machines/Utility/ROMCatalogue.hpp"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace POSIX {
+
+/// @returns The entire contents of the file at @c path, if it could be read.
+std::optional<std::vector<uint8_t>> contents_of_file(const std::string &path);
+
+/*!
+	Records the size and CRC32 of every plausible ROM file in a set of directories, and in
+	the directories immediately within them, so that ROMs can be found regardless of their names.
+
+	The index persists between runs; files are rehashed only if their size or modification
+	time has changed since they were last indexed.
+*/
+class ROMIndex {
+	public:
+		ROMIndex(const std::string &index_file_name, const std::vector<std::string> &directories);
+
+		/// @returns The path of an indexed file of @c size bytes with a CRC32 of @c crc32, if any.
+		std::optional<std::string> find(std::size_t size, uint32_t crc32) const;
+
+	private:
+		struct Entry {
+			std::size_t size;
+			int64_t modification_time;
+			uint32_t crc32;
+		};
+		std::map<std::string, Entry> entries_;
+		std::map<std::pair<std::size_t, uint32_t>, std::string> paths_;
+		bool has_changed_ = false;
+
+		void scan(const std::string &directory, int depth, std::map<std::string, Entry> &previous_entries);
+		void load(const std::string &index_file_name);
+		void save(const std::string &index_file_name);
+};
+
+/*!
+	Finds system ROMs in the places that the POSIX command-line front ends look for them:
+
+		/usr/local/share/CLK/[system];
+		/usr/share/CLK/[system]; or
+		[user-supplied path]/[system].
+
+	ROMs are first sought by file name; if none is found then any file in those directories
+	with a matching size and CRC is used.
+*/
+class ROMFetcher {
+	public:
+		/// Constructs a fetcher that will additionally search @c rompath, if it is non-empty.
+		ROMFetcher(const std::string &rompath);
+
+		ROM::Map operator()(const ROM::Request &roms);
+
+		/// @returns Whatever was requested but not found by the most recent fetch.
+		ROM::Request missing_roms() const {
+			return missing_roms_;
+		}
+
+		/// @returns All paths that were checked unsuccessfully by name.
+		const std::vector<std::string> &checked_paths() const {
+			return checked_paths_;
+		}
+
+		/// @returns A @c ROMMachine::ROMFetcher that calls through to this fetcher, which must outlive it.
+		ROMMachine::ROMFetcher function() {
+			return [this](const ROM::Request &roms) { return (*this)(roms); };
+		}
+
+	private:
+		std::vector<std::string> paths_;
+		std::optional<ROMIndex> index_;
+
+		ROM::Request missing_roms_;
+		std::vector<std::string> checked_paths_;
+};
+
+}
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <mutex>
 #include <vector>
 
 #include <QIODevice>
 
+#include "../../Concurrency/SPSCRing.hpp"
+
 /*!
  * \brief An intermediate recepticle for audio data.
  *
@@ -19,44 +22,39 @@
  *    permanent disadvantage after startup; and
  * 2. that such QAudioOutputs empirically seem to introduce a minimum
  *    16384-byte latency.
+ *
+ * Data is passed between the emulation and audio threads via a wait-free
+ * ring, so neither ever blocks the other.
  */
 struct AudioBuffer: public QIODevice {
-	AudioBuffer() {
+	AudioBuffer() : buffer(MaximumDepth / sizeof(int16_t)) {
 		open(QIODevice::ReadOnly | QIODevice::Unbuffered);
 	}
 
 	void setDepth(size_t depth) {
-		std::lock_guard lock(mutex);
-		buffer.resize(depth);
+		this->depth = std::min(depth, MaximumDepth) / sizeof(int16_t);
 	}
 
 	// AudioBuffer-specific behaviour: always provide the latest data,
 	// even if that means skipping some.
 	qint64 readData(char *data, const qint64 maxlen) override {
-		if(!maxlen) {
+		const size_t samples = size_t(maxlen) / sizeof(int16_t);
+		if(!samples || !depth) {
 			return 0;
 		}
 
-		std::lock_guard lock(mutex);
-		if(readPointer == writePointer || buffer.empty()) return 0;
-
-		const size_t dataAvailable = std::min(writePointer - readPointer, size_t(maxlen));
-		size_t bytesToCopy = dataAvailable;
-		while(bytesToCopy) {
-			const size_t nextLength = std::min(buffer.size() - (readPointer % buffer.size()), bytesToCopy);
-			memcpy(data, &buffer[readPointer % buffer.size()], nextLength);
-
-			bytesToCopy -= nextLength;
-			data += nextLength;
-			readPointer += nextLength;
+		// Discard anything beyond the permitted depth, keeping stereo pairs intact.
+		const size_t buffered = buffer.size();
+		if(buffered > depth) {
+			buffer.discard((buffered - depth) & ~size_t(1));
 		}
 
-		return qint64(dataAvailable);
+		const size_t available = std::min(buffer.size(), samples);
+		return qint64(buffer.read(reinterpret_cast<int16_t *>(data), available) * sizeof(int16_t));
 	}
 
 	qint64 bytesAvailable() const override {
-		std::lock_guard lock(mutex);
-		return qint64(writePointer - readPointer);
+		return qint64(std::min(buffer.size(), depth.load()) * sizeof(int16_t));
 	}
 
 	// Required to make QIODevice concrete; not used.
@@ -65,30 +63,15 @@ struct AudioBuffer: public QIODevice {
 	}
 
 	// Posts a new set of source data. This buffer permits only the amount of data
-	// specified by @c setDepth to be enqueued into the future. Additional writes
-	// after the buffer is full will overwrite the newest data.
+	// specified by @c setDepth to be enqueued into the future; the oldest data is
+	// discarded upon the next read if that amount is exceeded.
 	void write(const std::vector<int16_t> &source) {
-		std::lock_guard lock(mutex);
-		if(buffer.empty()) return;
-		const size_t sourceSize = source.size() * sizeof(int16_t);
-
-		size_t bytesToCopy = sourceSize;
-		auto data = reinterpret_cast<const uint8_t *>(source.data());
-		while(bytesToCopy) {
-			size_t nextLength = std::min(buffer.size() - (writePointer % buffer.size()), bytesToCopy);
-			memcpy(&buffer[writePointer % buffer.size()], data, nextLength);
-
-			bytesToCopy -= nextLength;
-			data += nextLength;
-			writePointer += nextLength;
-		}
-
-		readPointer = std::max(readPointer, writePointer - buffer.size());
+		if(!depth) return;
+		buffer.write(source.data(), source.size());
 	}
 
 	private:
-		mutable std::mutex mutex;
-		std::vector<uint8_t> buffer;
-		mutable size_t readPointer = 0;
-		size_t writePointer = 0;
+		static constexpr size_t MaximumDepth = 65536;
+		Concurrency::SPSCRing<int16_t> buffer;
+		std::atomic<size_t> depth = 0;
 };
@@ -111,6 +111,7 @@ SOURCES += \
 	$$SRC/Outputs/*.cpp \
 	$$SRC/Outputs/CRT/*.cpp \
 	$$SRC/Outputs/ScanTargets/*.cpp \
+	$$SRC/Outputs/Software/*.cpp \
 	$$SRC/Outputs/OpenGL/*.cpp \
 	$$SRC/Outputs/OpenGL/Primitives/*.cpp \
 \
@@ -250,6 +251,7 @@ HEADERS += \
 	$$SRC/Outputs/CRT/*.hpp \
 	$$SRC/Outputs/CRT/Internals/*.hpp \
 	$$SRC/Outputs/ScanTargets/*.hpp \
+	$$SRC/Outputs/Software/*.hpp \
 	$$SRC/Outputs/OpenGL/*.hpp \
 	$$SRC/Outputs/OpenGL/Primitives/*.hpp \
 	$$SRC/Outputs/Speaker/*.hpp \
@@ -792,8 +792,7 @@ void MainWindow::dropEvent(QDropEvent* event) {
 				if(!contents) continue;
 
 
-				CRC::CRC32 generator;
-				const uint32_t crc = generator.compute_crc(*contents);
+				const uint32_t crc = CRC::CRC32::compute(*contents);
 
 				std::optional<ROM::Description> target_rom = ROM::Description::from_crc(crc);
 				if(target_rom) {
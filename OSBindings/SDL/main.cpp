@@ -13,10 +13,10 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <iomanip>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <sys/stat.h>
 
 #include <SDL.h>
@@ -27,8 +27,12 @@
 #include "../../ClockReceiver/TimeTypes.hpp"
 #include "../../ClockReceiver/ScanSynchroniser.hpp"
 
+#include "../../Concurrency/SPSCRing.hpp"
+
 #include "../../Machines/MachineTypes.hpp"
 
+#include "../POSIX/ROMFetcher.hpp"
+
 #include "../../Activity/Observer.hpp"
 #include "../../Outputs/OpenGL/Primitives/Rectangle.hpp"
 #include "../../Outputs/OpenGL/ScanTarget.hpp"
@@ -177,40 +181,32 @@ struct MachineRunner {
 struct SpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
 	// This is empirically the best that I can seem to do with SDL's timer precision.
 	static constexpr size_t buffered_samples = 1024;
-	bool is_stereo = false;
+
+	/// Prepares to receive audio with the number of channels given; must not be called while audio is being produced or consumed.
+	void set_channels(int channels) {
+		audio_buffer_ = std::make_unique<Concurrency::AdaptiveLatencyRing<int16_t>>(
+			buffered_samples * size_t(channels) * 16,
+			buffered_samples * size_t(channels),
+			size_t(channels)
+		);
+	}
 
 	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
-		std::lock_guard lock_guard(audio_buffer_mutex_);
-		const size_t buffer_size = buffered_samples * (is_stereo ? 2 : 1);
-		if(audio_buffer_.size() > buffer_size) {
-			audio_buffer_.erase(audio_buffer_.begin(), audio_buffer_.end() - buffer_size);
-		}
-		audio_buffer_.insert(audio_buffer_.end(), buffer.begin(), buffer.end());
+		audio_buffer_->write(buffer.data(), buffer.size());
 	}
 
 	void audio_callback(Uint8 *stream, int len) {
-		std::lock_guard lock_guard(audio_buffer_mutex_);
-
 		// SDL buffer length is in bytes, so there's no need to adjust for stereo/mono in here.
-		const std::size_t sample_length = size_t(len) / sizeof(int16_t);
-		const std::size_t copy_length = std::min(sample_length, audio_buffer_.size());
-		int16_t *const target = static_cast<int16_t *>(static_cast<void *>(stream));
-
-		std::memcpy(stream, audio_buffer_.data(), copy_length * sizeof(int16_t));
-		if(copy_length < sample_length) {
-			std::memset(&target[copy_length], 0, (sample_length - copy_length) * sizeof(int16_t));
-		}
-		audio_buffer_.erase(audio_buffer_.begin(), audio_buffer_.begin() + copy_length);
+		audio_buffer_->read_all(reinterpret_cast<int16_t *>(stream), size_t(len) / sizeof(int16_t));
 	}
 
 	static void SDL_audio_callback(void *userdata, Uint8 *stream, int len) {
 		reinterpret_cast<SpeakerDelegate *>(userdata)->audio_callback(stream, len);
 	}
 
-	SDL_AudioDeviceID audio_device;
+	SDL_AudioDeviceID audio_device = 0;
 
-	std::mutex audio_buffer_mutex_;
-	std::vector<int16_t> audio_buffer_;
+	std::unique_ptr<Concurrency::AdaptiveLatencyRing<int16_t>> audio_buffer_;
 };
 
 class ActivityObserver: public Activity::Observer {
@@ -534,7 +530,7 @@ int main(int argc, char *argv[]) {
 	const ParsedArguments arguments = parse_arguments(argc, argv);
 
 	// This may be printed either as
-	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}] [--logical-keyboard] [--volume={0.0 to 1.0}]";
+	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}] [--logical-keyboard] [--volume={0.0 to 1.0}] [--copy-on-write]";
 
 	// Print a help message if requested.
 	if(arguments.selections.find("help") != arguments.selections.end() || arguments.selections.find("h") != arguments.selections.end()) {
@@ -630,6 +626,9 @@ int main(int argc, char *argv[]) {
 		return EXIT_SUCCESS;
 	}
 
+	// Determine whether mass storage images should be protected from modification.
+	const bool copy_on_write = arguments.selections.find("copy-on-write") != arguments.selections.end();
+
 	// Determine the machine for the supplied file, if any, or from --new.
 	Analyser::Static::TargetList targets;
 
@@ -661,7 +660,7 @@ int main(int argc, char *argv[]) {
 		// Take the first file name that actually implies a machine.
 		auto file_name = arguments.file_names.begin();
 		while(file_name != arguments.file_names.end() && targets.empty()) {
-			targets = Analyser::Static::GetTargets(*file_name);
+			targets = Analyser::Static::GetTargets(*file_name, copy_on_write);
 			++file_name;
 		}
 	}
@@ -692,74 +691,10 @@ int main(int argc, char *argv[]) {
 	MachineRunner machine_runner;
 	SpeakerDelegate speaker_delegate;
 
-	// For vanilla SDL purposes, assume system ROMs can be found in one of:
-	//
-	//	/usr/local/share/CLK/[system];
-	//	/usr/share/CLK/[system]; or
-	//	[user-supplied path]/[system]
-	ROM::Request missing_roms;
-	std::vector<std::string> checked_paths;
-	ROMMachine::ROMFetcher rom_fetcher = [&missing_roms, &arguments, &checked_paths]
-		(const ROM::Request &roms) -> ROM::Map {
-			std::vector<std::string> paths = {
-				"/usr/local/share/CLK/",
-				"/usr/share/CLK/"
-			};
-
-			const auto rompath = arguments.selections.find("rompath");
-			if(rompath != arguments.selections.end()) {
-				std::string path = rompath->second;
-
-				// Ensure the path ends in a slash.
-				if(path.back() != '/') {
-					path += '/';
-				}
-
-				// If ~ is present, expand it to %HOME%.
-				const size_t tilde_position = path.find("~");
-				if(tilde_position != std::string::npos) {
-					path.replace(tilde_position, 1, getenv("HOME"));
-				}
-
-				paths.push_back(path);
-			}
-
-			ROM::Map results;
-			for(const auto &description: roms.all_descriptions()) {
-				for(const auto &file_name: description.file_names) {
-					FILE *file = nullptr;
-					std::vector<std::string> rom_checked_paths;
-					for(const auto &path: paths) {
-						std::string local_path = path + description.machine_name + "/" + file_name;
-						file = std::fopen(local_path.c_str(), "rb");
-						rom_checked_paths.push_back(local_path);
-						if(file) break;
-					}
-
-					if(!file) {
-						std::copy(rom_checked_paths.begin(), rom_checked_paths.end(), std::back_inserter(checked_paths));
-						continue;
-					}
-
-					std::vector<uint8_t> data;
-
-					std::fseek(file, 0, SEEK_END);
-					data.resize(std::ftell(file));
-					std::fseek(file, 0, SEEK_SET);
-					std::size_t read = fread(data.data(), 1, data.size(), file);
-					std::fclose(file);
-
-					if(read == data.size()) {
-						results[description.name] = std::move(data);
-					} else {
-						std::copy(rom_checked_paths.begin(), rom_checked_paths.end(), std::back_inserter(checked_paths));
-					}
-				}
-			}
-
-			missing_roms = roms.subtract(results);
-			return results;
-		};
+	// Look for system ROMs in the standard locations, and wherever the user has specified.
+	const auto rompath = arguments.selections.find("rompath");
+	POSIX::ROMFetcher rom_fetcher_implementation(rompath != arguments.selections.end() ? rompath->second : "");
+	const ROMMachine::ROMFetcher rom_fetcher = rom_fetcher_implementation.function();
 
 	// Apply all command-line options to the targets.
 	for(auto &target: targets) {
@@ -780,11 +715,11 @@ int main(int argc, char *argv[]) {
 				std::cerr << "Needed but didn't find";
 
 				using DescriptionFlag = ROM::Description::DescriptionFlag;
-				std::wcerr << missing_roms.description(DescriptionFlag::Filename | DescriptionFlag::CRC, L'*');
+				std::wcerr << rom_fetcher_implementation.missing_roms().description(DescriptionFlag::Filename | DescriptionFlag::CRC, L'*');
 
 				std::cerr << std::endl << std::endl << "Searched unsuccessfully: ";
 				bool is_first = true;
-				for(const auto &path: checked_paths) {
+				for(const auto &path: rom_fetcher_implementation.checked_paths()) {
 					if(!is_first) std::cerr << "; ";
 					std::cerr << path;
 					is_first = false;
@@ -858,7 +793,7 @@ int main(int argc, char *argv[]) {
 		if(media_target) {
 			Analyser::Static::Media media;
 			for(const auto &file_name: arguments.file_names) {
-				media += Analyser::Static::GetMedia(file_name);
+				media += Analyser::Static::GetMedia(file_name, copy_on_write);
 			}
 			media_target->insert_media(media);
 		}
@@ -929,10 +864,14 @@ int main(int argc, char *argv[]) {
 				desired_audio_spec.callback = SpeakerDelegate::SDL_audio_callback;
 				desired_audio_spec.userdata = &speaker_delegate;
 
+				// Close any previous device, so that nothing else is consuming audio as the buffer is replaced.
+				if(speaker_delegate.audio_device) {
+					SDL_CloseAudioDevice(speaker_delegate.audio_device);
+				}
 				speaker_delegate.audio_device = SDL_OpenAudioDevice(nullptr, 0, &desired_audio_spec, &obtained_audio_spec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
 
 				speaker->set_output_rate(obtained_audio_spec.freq, desired_audio_spec.samples, obtained_audio_spec.channels == 2);
-				speaker_delegate.is_stereo = obtained_audio_spec.channels == 2;
+				speaker_delegate.set_channels(obtained_audio_spec.channels);
 				speaker->set_delegate(&speaker_delegate);
 				SDL_PauseAudioDevice(speaker_delegate.audio_device, 0);
 			}
@@ -1027,7 +966,7 @@ int main(int argc, char *argv[]) {
 				break;
 
 				case SDL_DROPFILE: {
-					const Analyser::Static::Media media = Analyser::Static::GetMedia(event.drop.file);
+					const Analyser::Static::Media media = Analyser::Static::GetMedia(event.drop.file, copy_on_write);
 
 					// If the new file is only media, insert it; if it is a state snapshot then
 					// tear down the entire machine and replace it.
@@ -1036,7 +975,7 @@ int main(int argc, char *argv[]) {
 						break;
 					}
 
-					targets = Analyser::Static::GetTargets(event.drop.file);
+					targets = Analyser::Static::GetTargets(event.drop.file, copy_on_write);
 					if(targets.empty()) break;
 
 					::Machine::Error error;
@@ -0,0 +1,818 @@
+//
+//  ScanTarget.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "ScanTarget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define USE_SSE2
+#elif defined(__ARM_NEON) && defined(__LITTLE_ENDIAN__)
+#include <arm_neon.h>
+#define USE_NEON
+#endif
+
+#ifndef M_PI
+#define M_PI 3.1415926f
+#endif
+
+using namespace Outputs::Display::Software;
+
+namespace {
+
+/// @returns An opaque black pixel, in this scan target's RGBA byte order.
+uint32_t opaque_black() {
+	const uint8_t bytes[4] = {0, 0, 0, 0xff};
+	uint32_t result;
+	memcpy(&result, bytes, sizeof(result));
+	return result;
+}
+
+/// Writes to @c destination the average of the @c window samples from @c source centred upon each of its @c length
+/// samples, treating the ends of @c source as extending indefinitely. @c source and @c destination must be distinct.
+void box_filter(const float *source, float *destination, int length, int window) {
+	if(window <= 1) {
+		std::copy(source, source + length, destination);
+		return;
+	}
+
+	const int before = window >> 1;
+	const int after = window - before;
+	const float scale = 1.0f / float(window);
+
+	const auto clamped = [&](int c) {
+		float total = 0.0f;
+		for(int tap = c - before; tap < c + after; tap++) {
+			total += source[std::clamp(tap, 0, length - 1)];
+		}
+		return total * scale;
+	};
+
+	// Sum directly wherever no bounds checks are required; windows are a single colour cycle
+	// so are short, and this avoids a serial dependency on a running total.
+	const int safe_begin = std::min(before, length);
+	const int safe_end = std::max(length - after + 1, safe_begin);
+	int c = 0;
+	for(; c < safe_begin; c++) {
+		destination[c] = clamped(c);
+	}
+
+#if defined(USE_SSE2)
+	const __m128 multiplier = _mm_set1_ps(scale);
+	for(; c + 4 <= safe_end; c += 4) {
+		__m128 total = _mm_loadu_ps(&source[c - before]);
+		for(int tap = 1 - before; tap < after; tap++) {
+			total = _mm_add_ps(total, _mm_loadu_ps(&source[c + tap]));
+		}
+		_mm_storeu_ps(&destination[c], _mm_mul_ps(total, multiplier));
+	}
+#elif defined(USE_NEON)
+	for(; c + 4 <= safe_end; c += 4) {
+		float32x4_t total = vld1q_f32(&source[c - before]);
+		for(int tap = 1 - before; tap < after; tap++) {
+			total = vaddq_f32(total, vld1q_f32(&source[c + tap]));
+		}
+		vst1q_f32(&destination[c], vmulq_n_f32(total, scale));
+	}
+#endif
+
+	for(; c < safe_end; c++) {
+		float total = 0.0f;
+		for(int tap = -before; tap < after; tap++) {
+			total += source[c + tap];
+		}
+		destination[c] = total * scale;
+	}
+	for(; c < length; c++) {
+		destination[c] = clamped(c);
+	}
+}
+
+/// Clamps each of @c length samples from @c red, @c green and @c blue to the range [0, 1] and stores them
+/// to @c destination as opaque RGBA8 pixels.
+void pack_rgba(const float *red, const float *green, const float *blue, uint32_t *destination, size_t length) {
+	size_t c = 0;
+
+#if defined(USE_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 multiplier = _mm_set1_ps(255.0f);
+	const __m128i alpha = _mm_set1_epi32(int(0xff000000));
+
+	const auto channel = [&](const float *source) {
+		const __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source), zero), one);
+		return _mm_cvtps_epi32(_mm_mul_ps(value, multiplier));
+	};
+
+	for(; c + 4 <= length; c += 4) {
+		const __m128i pixels = _mm_or_si128(
+			_mm_or_si128(channel(&red[c]), _mm_slli_epi32(channel(&green[c]), 8)),
+			_mm_or_si128(_mm_slli_epi32(channel(&blue[c]), 16), alpha)
+		);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&destination[c]), pixels);
+	}
+#elif defined(USE_NEON)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t half = vdupq_n_f32(0.5f);
+	const uint32x4_t alpha = vdupq_n_u32(0xff000000);
+
+	const auto channel = [&](const float *source) {
+		const float32x4_t value = vminq_f32(vmaxq_f32(vld1q_f32(source), zero), one);
+		return vcvtq_u32_f32(vmlaq_n_f32(half, value, 255.0f));
+	};
+
+	for(; c + 4 <= length; c += 4) {
+		const uint32x4_t pixels = vorrq_u32(
+			vorrq_u32(channel(&red[c]), vshlq_n_u32(channel(&green[c]), 8)),
+			vorrq_u32(vshlq_n_u32(channel(&blue[c]), 16), alpha)
+		);
+		vst1q_u32(&destination[c], pixels);
+	}
+#endif
+
+	// Scalar fallback, which also handles any tail.
+	const auto channel_value = [](float value) {
+		return uint8_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	};
+	for(; c < length; c++) {
+		uint8_t *const pixel = reinterpret_cast<uint8_t *>(&destination[c]);
+		pixel[0] = channel_value(red[c]);
+		pixel[1] = channel_value(green[c]);
+		pixel[2] = channel_value(blue[c]);
+		pixel[3] = 0xff;
+	}
+}
+
+/// Applies the 3x3 column-major matrix @c matrix to each of the @c length vectors formed from
+/// corresponding elements of @c channels, in place.
+void apply_matrix(const std::array<float, 9> &matrix, float *channels[3], size_t length) {
+	float *const a = channels[0];
+	float *const b = channels[1];
+	float *const c = channels[2];
+	size_t index = 0;
+
+#if defined(USE_SSE2)
+	__m128 m[9];
+	for(size_t e = 0; e < 9; e++) m[e] = _mm_set1_ps(matrix[e]);
+
+	const auto product = [](__m128 x, __m128 y, __m128 z, __m128 mx, __m128 my, __m128 mz) {
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, mx), _mm_mul_ps(y, my)), _mm_mul_ps(z, mz));
+	};
+	for(; index + 4 <= length; index += 4) {
+		const __m128 x = _mm_loadu_ps(&a[index]);
+		const __m128 y = _mm_loadu_ps(&b[index]);
+		const __m128 z = _mm_loadu_ps(&c[index]);
+		_mm_storeu_ps(&a[index], product(x, y, z, m[0], m[3], m[6]));
+		_mm_storeu_ps(&b[index], product(x, y, z, m[1], m[4], m[7]));
+		_mm_storeu_ps(&c[index], product(x, y, z, m[2], m[5], m[8]));
+	}
+#elif defined(USE_NEON)
+	for(; index + 4 <= length; index += 4) {
+		const float32x4_t x = vld1q_f32(&a[index]);
+		const float32x4_t y = vld1q_f32(&b[index]);
+		const float32x4_t z = vld1q_f32(&c[index]);
+		vst1q_f32(&a[index], vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(x, matrix[0]), y, matrix[3]), z, matrix[6]));
+		vst1q_f32(&b[index], vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(x, matrix[1]), y, matrix[4]), z, matrix[7]));
+		vst1q_f32(&c[index], vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(x, matrix[2]), y, matrix[5]), z, matrix[8]));
+	}
+#endif
+
+	for(; index < length; index++) {
+		const float x = a[index], y = b[index], z = c[index];
+		a[index] = matrix[0]*x + matrix[3]*y + matrix[6]*z;
+		b[index] = matrix[1]*x + matrix[4]*y + matrix[7]*z;
+		c[index] = matrix[2]*x + matrix[5]*y + matrix[8]*z;
+	}
+}
+
+/// Writes to @c destination the result of applying a four-tap filter with the whole-sample, ascending @c offsets
+/// and @c weights to each of the @c length samples of @c source, treating the ends of @c source as extending indefinitely.
+void sampling_filter(const float *source, float *destination, int length, const std::array<int, 4> &offsets, const float *weights) {
+	const auto clamped = [&](int c) {
+		float total = 0.0f;
+		for(size_t tap = 0; tap < 4; tap++) {
+			total += source[std::clamp(c + offsets[tap], 0, length - 1)] * weights[tap];
+		}
+		return total;
+	};
+
+	// Filter without bounds checks wherever that's safe.
+	const int safe_begin = std::clamp(-offsets[0], 0, length);
+	const int safe_end = std::clamp(length - offsets[3], safe_begin, length);
+	for(int c = 0; c < safe_begin; c++) {
+		destination[c] = clamped(c);
+	}
+	const float *const sources[4] = {
+		&source[offsets[0]], &source[offsets[1]], &source[offsets[2]], &source[offsets[3]]
+	};
+	int c = safe_begin;
+
+#if defined(USE_SSE2)
+	const __m128 w0 = _mm_set1_ps(weights[0]), w1 = _mm_set1_ps(weights[1]);
+	const __m128 w2 = _mm_set1_ps(weights[2]), w3 = _mm_set1_ps(weights[3]);
+	for(; c + 4 <= safe_end; c += 4) {
+		const __m128 total = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&sources[0][c]), w0), _mm_mul_ps(_mm_loadu_ps(&sources[1][c]), w1)),
+			_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&sources[2][c]), w2), _mm_mul_ps(_mm_loadu_ps(&sources[3][c]), w3))
+		);
+		_mm_storeu_ps(&destination[c], total);
+	}
+#elif defined(USE_NEON)
+	for(; c + 4 <= safe_end; c += 4) {
+		float32x4_t total = vmulq_n_f32(vld1q_f32(&sources[0][c]), weights[0]);
+		total = vmlaq_n_f32(total, vld1q_f32(&sources[1][c]), weights[1]);
+		total = vmlaq_n_f32(total, vld1q_f32(&sources[2][c]), weights[2]);
+		total = vmlaq_n_f32(total, vld1q_f32(&sources[3][c]), weights[3]);
+		vst1q_f32(&destination[c], total);
+	}
+#endif
+
+	for(; c < safe_end; c++) {
+		destination[c] =
+			sources[0][c] * weights[0] + sources[1][c] * weights[1] +
+			sources[2][c] * weights[2] + sources[3][c] * weights[3];
+	}
+	for(int c = safe_end; c < length; c++) {
+		destination[c] = clamped(c);
+	}
+}
+
+/// Maps from 8-bit samples to the range [0, 1].
+constexpr float Normalise = 1.0f / 255.0f;
+
+using Texel = std::array<uint8_t, 4>;
+using InputDataType = Outputs::Display::InputDataType;
+
+/// Maps a single input sample of type @c type to its normalised form, as per the OpenGL composition shader.
+template <InputDataType type> Texel normalise(const uint8_t *source) {
+	switch(type) {
+		case InputDataType::Luminance1: {
+			const uint8_t value = source[0] ? 0xff : 0x00;
+			return Texel{value, value, value, value};
+		}
+
+		case InputDataType::Luminance8:
+			return Texel{source[0], source[0], source[0], source[0]};
+
+		case InputDataType::Luminance8Phase8:
+			return Texel{source[0], source[1], 0x00, 0xff};
+
+		case InputDataType::PhaseLinkedLuminance8:
+		case InputDataType::Red8Green8Blue8:
+			return Texel{source[0], source[1], source[2], source[3]};
+
+		case InputDataType::Red1Green1Blue1:
+			return Texel{
+				uint8_t((source[0] & 4) ? 0xff : 0x00),
+				uint8_t((source[0] & 2) ? 0xff : 0x00),
+				uint8_t((source[0] & 1) ? 0xff : 0x00),
+				0xff
+			};
+
+		case InputDataType::Red2Green2Blue2:
+			return Texel{
+				uint8_t(((source[0] >> 4) & 3) * 0x55),
+				uint8_t(((source[0] >> 2) & 3) * 0x55),
+				uint8_t((source[0] & 3) * 0x55),
+				0xff
+			};
+
+		case InputDataType::Red4Green4Blue4:
+			return Texel{
+				uint8_t((source[0] & 15) * 0x11),
+				uint8_t((source[1] >> 4) * 0x11),
+				uint8_t((source[1] & 15) * 0x11),
+				0xff
+			};
+	}
+
+	return Texel{};
+}
+
+/// Composes a single scan, which runs from @c data_start to @c data_end in @c row across the
+/// output clocks [@c scan_start, @c scan_end), into those of @c target that are in the range [@c first, @c last).
+template <InputDataType type> void compose_scan(
+	Texel *target, int first, int last,
+	const uint8_t *row, int data_start, int data_end,
+	int scan_start, int scan_end
+) {
+	constexpr auto data_size = int(Outputs::Display::size_for_data_type(type));
+	const float data_step = float(data_end - data_start) / float(scan_end - scan_start);
+
+	for(int clock = first; clock < last; clock++) {
+		// Sample at the centre of each output clock; the samples either side of each data run are
+		// bookends, so anything that falls just outside of the run is safe.
+		const int x = std::clamp(
+			data_start + int((float(clock - scan_start) + 0.5f) * data_step),
+			data_start - 1,
+			data_end);
+		target[clock] = normalise<type>(&row[x * data_size]);
+	}
+}
+
+}
+
+ScanTarget::ScanTarget(int output_width, int output_height, size_t worker_threads, float output_gamma) :
+	output_width_(output_width),
+	output_height_(output_height),
+	output_gamma_(output_gamma),
+	framebuffer_(size_t(output_width * output_height), opaque_black()),
+	row_was_painted_(size_t(output_height)),
+	line_pixels_(size_t(output_width * LineBufferHeight)) {
+
+	set_scan_buffer(scan_buffer_.data(), scan_buffer_.size());
+	set_line_buffer(line_buffer_.data(), line_metadata_buffer_.data(), line_buffer_.size());
+
+	// Create a workspace per thread, and a queue for each thread other than the caller's.
+	if(!worker_threads) {
+		worker_threads = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+	}
+	for(size_t c = 0; c < worker_threads; c++) {
+		workspaces_.push_back(std::make_unique<LineWorkspace>());
+		workspaces_.back()->output_channels.resize(size_t(output_width * 3));
+		workspaces_.back()->output_samples.resize(size_t(output_width));
+		workspaces_.back()->output_fractions.resize(size_t(output_width));
+		if(c) {
+			workers_.push_back(std::make_unique<Concurrency::AsyncTaskQueue<true>>());
+		}
+	}
+}
+
+void ScanTarget::setup_pipeline() {
+	const auto modals = BufferingScanTarget::modals();
+	const auto data_type_size = Outputs::Display::size_for_data_type(modals.input_data_type);
+
+	// Resize the write area if required; in any case the new data size means that any existing
+	// content is now meaningless.
+	write_area_texture_.resize(WriteAreaWidth*WriteAreaHeight*data_type_size);
+	set_write_area(write_area_texture_.data());
+
+	// Establish colour space conversions.
+	rgb_to_luma_chroma_ = from_rgb_matrix(modals.composite_colour_space);
+	luma_chroma_to_rgb_ = to_rgb_matrix(modals.composite_colour_space);
+
+	// Chrominance is separated across a single colour cycle.
+	if(modals.colour_cycle_numerator) {
+		colour_cycle_length_ = std::max(
+			int(std::round(float(modals.cycles_per_line) * float(modals.colour_cycle_denominator) / float(modals.colour_cycle_numerator))),
+			1);
+	} else {
+		colour_cycle_length_ = 1;
+	}
+
+	// Output pixels are formed by sampling four times across the width of a pixel, as per the OpenGL scan target.
+	// Offsets are rounded to whole clocks so that filtering can be performed prior to resampling.
+	const float one_pixel_width = float(modals.cycles_per_line) * modals.visible_area.size.width / float(output_width_);
+	for(int c = 0; c < 4; c++) {
+		sample_offsets_[size_t(c)] = int(std::round(((one_pixel_width * float(c)) / 3.0f) - (one_pixel_width * 0.5f)));
+	}
+
+	// Establish brightness and gamma correction.
+	brightness_ = (std::fabs(modals.brightness - 1.0f) > 0.05f) ? modals.brightness : 1.0f;
+	apply_gamma_ = std::fabs(output_gamma_ - modals.intended_gamma) > 0.05f;
+	if(apply_gamma_) {
+		const float gamma_ratio = output_gamma_ / modals.intended_gamma;
+		for(size_t c = 0; c < gamma_table_.size(); c++) {
+			gamma_table_[c] = uint8_t(std::pow(float(c) / 255.0f, gamma_ratio) * 255.0f + 0.5f);
+		}
+	}
+}
+
+void ScanTarget::perform_in_parallel(const std::function<void(size_t, size_t)> &job) {
+	const size_t total = workers_.size() + 1;
+	for(size_t c = 0; c < workers_.size(); c++) {
+		workers_[c]->enqueue([&job, c, total] {
+			job(c + 1, total);
+		});
+	}
+	job(0, total);
+	for(auto &worker: workers_) {
+		worker->flush();
+	}
+}
+
+void ScanTarget::update() {
+	// Update the display metrics.
+	display_metrics_.announce_draw_status(
+		lines_submitted_,
+		std::chrono::high_resolution_clock::now() - line_submission_begin_time_,
+		true);
+
+	perform([this] {
+		const OutputArea area = get_output_area();
+
+		// Establish the pipeline if necessary.
+		if(BufferingScanTarget::new_modals()) {
+			setup_pipeline();
+		}
+
+		// Determine the start time of this submission group and the number of lines it will contain.
+		line_submission_begin_time_ = std::chrono::high_resolution_clock::now();
+		const size_t new_lines = (area.end.line - area.start.line + LineBufferHeight) % LineBufferHeight;
+		lines_submitted_ = new_lines;
+
+		if(new_lines) {
+			// Compose, decode and rasterise every line. Each is independent of all others.
+			perform_in_parallel([&](size_t worker, size_t workers) {
+				for(size_t c = worker; c < new_lines; c += workers) {
+					const size_t line = (area.start.line + c) % LineBufferHeight;
+					const size_t end_scan =
+						(c == new_lines - 1) ?
+							area.end.scan : line_metadata_buffer_[(line + 1) % LineBufferHeight].first_scan;
+					process_line(*workspaces_[worker], line, line_metadata_buffer_[line].first_scan, end_scan);
+				}
+			});
+
+			// Paint lines into the framebuffer, dividing them by which frame they're in
+			// and dividing the framebuffer into horizontal bands, one per worker.
+			auto start_line = uint16_t(area.start.line);
+			size_t remaining_lines = new_lines;
+			while(remaining_lines) {
+				auto end_line = uint16_t((start_line + 1) % LineBufferHeight);
+				size_t lines = 1;
+				while(end_line != area.end.line && !line_metadata_buffer_[end_line].is_first_in_frame) {
+					end_line = uint16_t((end_line + 1) % LineBufferHeight);
+					++lines;
+				}
+
+				// If this is start-of-frame, clear any rows that weren't painted in the previous one.
+				if(line_metadata_buffer_[start_line].is_first_in_frame) {
+					if(painted_rows_are_valid_ && line_metadata_buffer_[start_line].previous_frame_was_complete) {
+						for(size_t row = 0; row < row_was_painted_.size(); row++) {
+							if(!row_was_painted_[row]) {
+								std::fill_n(&framebuffer_[row * size_t(output_width_)], output_width_, opaque_black());
+							}
+						}
+					}
+					std::fill(row_was_painted_.begin(), row_was_painted_.end(), 0);
+					painted_rows_are_valid_ = true;
+					++frames_;
+				}
+
+				perform_in_parallel([&](size_t worker, size_t workers) {
+					paint(
+						start_line,
+						end_line,
+						int((size_t(output_height_) * worker) / workers),
+						int((size_t(output_height_) * (worker + 1)) / workers));
+				});
+
+				start_line = end_line;
+				remaining_lines -= lines;
+			}
+		}
+
+		complete_output_area(area);
+	});
+}
+
+void ScanTarget::paint(uint16_t begin_line, uint16_t end_line, int begin_row, int end_row) {
+	for(auto line = begin_line; line != end_line; line = uint16_t((line + 1) % LineBufferHeight)) {
+		const LineSpan &span = line_spans_[line];
+		const int first_row = std::max(span.y_begin, begin_row);
+		const int last_row = std::min(span.y_end, end_row);
+
+		for(int row = first_row; row < last_row; row++) {
+			std::copy(
+				&line_pixels_[size_t(line * output_width_ + span.x_begin)],
+				&line_pixels_[size_t(line * output_width_ + span.x_end)],
+				&framebuffer_[size_t(row * output_width_ + span.x_begin)]);
+			row_was_painted_[size_t(row)] = 1;
+		}
+	}
+}
+
+void ScanTarget::compose(LineWorkspace &workspace, int first_clock, int length, size_t begin_scan, size_t end_scan) {
+	const auto &modals = BufferingScanTarget::modals();
+	const size_t data_type_size = Outputs::Display::size_for_data_type(modals.input_data_type);
+
+	// Clear the composition to whatever describes black in the current input encoding.
+	const Texel black =
+		(modals.input_data_type == InputDataType::Luminance8Phase8) ?
+			Texel{0x00, 0xff, 0x00, 0x00} : Texel{0x00, 0x00, 0x00, 0x00};
+	std::fill_n(workspace.composition.begin(), length, black);
+
+	Texel *const target = workspace.composition.data() - first_clock;
+	for(size_t index = begin_scan; index != end_scan; index = (index + 1) % scan_buffer_.size()) {
+		const auto &scan = scan_buffer_[index];
+		const int scan_start = scan.scan.end_points[0].cycles_since_end_of_horizontal_retrace;
+		const int scan_end = scan.scan.end_points[1].cycles_since_end_of_horizontal_retrace;
+		const int first = std::max(scan_start, first_clock);
+		const int last = std::min(scan_end, first_clock + length);
+		if(first >= last) continue;
+
+		const uint8_t *const row = &write_area_texture_[size_t(scan.data_y) * WriteAreaWidth * data_type_size];
+		const int data_start = scan.scan.end_points[0].data_offset;
+		const int data_end = scan.scan.end_points[1].data_offset;
+
+#define Compose(x)	\
+	case InputDataType::x:	\
+		compose_scan<InputDataType::x>(target, first, last, row, data_start, data_end, scan_start, scan_end);	\
+	break;
+
+		switch(modals.input_data_type) {
+			Compose(Luminance1);
+			Compose(Luminance8);
+			Compose(PhaseLinkedLuminance8);
+			Compose(Luminance8Phase8);
+			Compose(Red1Green1Blue1);
+			Compose(Red2Green2Blue2);
+			Compose(Red4Green4Blue4);
+			Compose(Red8Green8Blue8);
+		}
+
+#undef Compose
+	}
+}
+
+void ScanTarget::process_line(LineWorkspace &workspace, size_t line_index, size_t begin_scan, size_t end_scan) {
+	const auto &modals = BufferingScanTarget::modals();
+	const Line &line = line_buffer_[line_index];
+	LineSpan &span = line_spans_[line_index];
+	span = LineSpan();
+
+	// Locate the line within the framebuffer, using the same geometry as the OpenGL scan target:
+	// lines are horizontal, starting from the start point, and slightly more than one row high.
+	const float scale_x = float(modals.output_scale.x);
+	const float scale_y = float(modals.output_scale.y) * modals.aspect_ratio * (3.0f / 4.0f);
+	const float row_height = 1.05f / float(std::max(modals.expected_vertical_lines, 1));
+
+	const float start_x =
+		((float(line.end_points[0].x) / scale_x) - modals.visible_area.origin.x) *
+		float(output_width_) / modals.visible_area.size.width;
+	const float end_x =
+		((float(line.end_points[1].x) / scale_x) - modals.visible_area.origin.x) *
+		float(output_width_) / modals.visible_area.size.width;
+	const float centre_y = float(line.end_points[0].y) / scale_y - modals.visible_area.origin.y;
+	const float start_y = (centre_y - row_height * 0.5f) * float(output_height_) / modals.visible_area.size.height;
+	const float end_y = (centre_y + row_height * 0.5f) * float(output_height_) / modals.visible_area.size.height;
+
+	// Pixels are covered if their centres are.
+	const auto first_covered = [](float position, int limit) {
+		return std::clamp(int(std::ceil(position - 0.5f)), 0, limit);
+	};
+	const int x_begin = first_covered(start_x, output_width_);
+	const int x_end = first_covered(end_x, output_width_);
+	const int y_begin = first_covered(start_y, output_height_);
+	const int y_end = first_covered(end_y, output_height_);
+
+	const int start_clock = line.end_points[0].cycles_since_end_of_horizontal_retrace;
+	const int end_clock = line.end_points[1].cycles_since_end_of_horizontal_retrace;
+	if(x_begin >= x_end || y_begin >= y_end || start_clock >= end_clock) {
+		return;
+	}
+
+	// Compose the line with sufficient margin on either side to accommodate filtering.
+	const int margin = colour_cycle_length_ + sample_offsets_[3] + 1;
+	const int first_clock = std::max(start_clock - margin, 0);
+	const int length = std::min(end_clock + margin, LineBufferWidth) - first_clock;
+	compose(workspace, first_clock, length, begin_scan, end_scan);
+
+	// Calculate the colour subcarrier phase at every clock if it might be needed.
+	const bool is_rgb = modals.display_type == DisplayType::RGB;
+	const float amplitude = float(line.composite_amplitude) * Normalise;
+	const float angle_per_clock =
+		float(line.end_points[1].composite_angle - line.end_points[0].composite_angle) / float(end_clock - start_clock);
+	const auto angle = [&](int c) {
+		return
+			(float(line.end_points[0].composite_angle) + float(first_clock + c - start_clock) * angle_per_clock) *
+			2.0f * float(M_PI) / 64.0f;
+	};
+	if(!is_rgb) {
+		// The angle advances by a constant amount per clock, so proceed by rotation; four
+		// independent rotations are run in parallel to avoid a single chain of dependencies.
+		constexpr int Lanes = 4;
+		const float step_cosine = std::cos((angle(1) - angle(0)) * float(Lanes));
+		const float step_sine = std::sin((angle(1) - angle(0)) * float(Lanes));
+		float cosines[Lanes], sines[Lanes];
+		for(int lane = 0; lane < Lanes; lane++) {
+			cosines[lane] = std::cos(angle(lane));
+			sines[lane] = std::sin(angle(lane));
+		}
+		for(int c = 0; c < length; c += Lanes) {
+			for(int lane = 0; lane < Lanes; lane++) {
+				workspace.cosines[size_t(c + lane)] = cosines[lane];
+				workspace.sines[size_t(c + lane)] = sines[lane];
+
+				const float next_cosine = cosines[lane] * step_cosine - sines[lane] * step_sine;
+				sines[lane] = sines[lane] * step_cosine + cosines[lane] * step_sine;
+				cosines[lane] = next_cosine;
+			}
+		}
+	}
+
+	auto &channels = workspace.channels;
+	auto &signal = workspace.signal;
+	auto &chroma = workspace.chroma;
+	const auto &composition = workspace.composition;
+	const bool is_svideo = modals.display_type == DisplayType::SVideo;
+
+	if(is_rgb) {
+		// Produce RGB directly; for anything other than RGB input this amounts to luminance only.
+		switch(modals.input_data_type) {
+			case InputDataType::Red1Green1Blue1:
+			case InputDataType::Red2Green2Blue2:
+			case InputDataType::Red4Green4Blue4:
+			case InputDataType::Red8Green8Blue8:
+				for(int c = 0; c < length; c++) {
+					channels[0][size_t(c)] = float(composition[size_t(c)][0]) * Normalise;
+					channels[1][size_t(c)] = float(composition[size_t(c)][1]) * Normalise;
+					channels[2][size_t(c)] = float(composition[size_t(c)][2]) * Normalise;
+				}
+			break;
+
+			case InputDataType::PhaseLinkedLuminance8:
+				for(int c = 0; c < length; c++) {
+					const auto &texel = composition[size_t(c)];
+					channels[0][size_t(c)] = channels[1][size_t(c)] = channels[2][size_t(c)] =
+						float(texel[0] + texel[1] + texel[2] + texel[3]) / 1020.0f;
+				}
+			break;
+
+			default:
+				for(int c = 0; c < length; c++) {
+					channels[0][size_t(c)] = channels[1][size_t(c)] = channels[2][size_t(c)] =
+						float(composition[size_t(c)][0]) * Normalise;
+				}
+			break;
+		}
+	} else {
+		// Produce either a composite signal or separate luminance and chrominance signals.
+		const float composite_amplitude = is_svideo ? 0.0f : amplitude;
+		switch(modals.input_data_type) {
+			case InputDataType::Luminance1:
+			case InputDataType::Luminance8:
+				for(int c = 0; c < length; c++) {
+					signal[size_t(c)] = float(composition[size_t(c)][0]) * Normalise;
+					chroma[size_t(c)] = 0.0f;
+				}
+			break;
+
+			case InputDataType::PhaseLinkedLuminance8:
+				for(int c = 0; c < length; c++) {
+					// Pick the byte that corresponds to this quarter of the colour cycle.
+					const float phase_angle = angle(c);
+					const int quadrant = int(std::fabs(phase_angle * 2.0f / float(M_PI))) & 3;
+					const int phase = ((phase_angle <= 0.0f) ? 3 : 0) ^ quadrant;
+					signal[size_t(c)] = float(composition[size_t(c)][size_t(phase)]) * Normalise;
+					chroma[size_t(c)] = 0.0f;
+				}
+			break;
+
+			case InputDataType::Luminance8Phase8:
+				for(int c = 0; c < length; c++) {
+					const float luminance = float(composition[size_t(c)][0]) * Normalise;
+					const float phase = float(composition[size_t(c)][1]) * Normalise;
+					const float phase_offset = 2.0f * float(M_PI) * 2.0f * phase;
+					const float raw_chroma =
+						(phase <= 0.75f) ?
+							workspace.cosines[size_t(c)] * std::cos(phase_offset) -
+							workspace.sines[size_t(c)] * std::sin(phase_offset) : 0.0f;
+
+					signal[size_t(c)] = luminance + (raw_chroma - luminance) * composite_amplitude;
+					chroma[size_t(c)] = raw_chroma;
+				}
+			break;
+
+			case InputDataType::Red1Green1Blue1:
+			case InputDataType::Red2Green2Blue2:
+			case InputDataType::Red4Green4Blue4:
+			case InputDataType::Red8Green8Blue8: {
+				const auto &m = rgb_to_luma_chroma_;
+				for(int c = 0; c < length; c++) {
+					const float red = float(composition[size_t(c)][0]) * Normalise;
+					const float green = float(composition[size_t(c)][1]) * Normalise;
+					const float blue = float(composition[size_t(c)][2]) * Normalise;
+
+					const float luminance = m[0]*red + m[3]*green + m[6]*blue;
+					const float raw_chroma =
+						workspace.cosines[size_t(c)] * (m[1]*red + m[4]*green + m[7]*blue) +
+						workspace.sines[size_t(c)] * (m[2]*red + m[5]*green + m[8]*blue);
+
+					signal[size_t(c)] = luminance + (raw_chroma - luminance) * composite_amplitude;
+					chroma[size_t(c)] = raw_chroma;
+				}
+			} break;
+		}
+
+		// Separate luminance and chrominance as required by the display type.
+		auto &product = workspace.product;
+		const auto demodulate = [&](float scale) {
+			for(int c = 0; c < length; c++) {
+				product[size_t(c)] = chroma[size_t(c)] * workspace.cosines[size_t(c)] * scale;
+			}
+			box_filter(product.data(), channels[1].data(), length, colour_cycle_length_);
+			for(int c = 0; c < length; c++) {
+				product[size_t(c)] = chroma[size_t(c)] * workspace.sines[size_t(c)] * scale;
+			}
+			box_filter(product.data(), channels[2].data(), length, colour_cycle_length_);
+		};
+
+		switch(modals.display_type) {
+			default: break;
+
+			case DisplayType::CompositeMonochrome:
+				std::copy(signal.begin(), signal.begin() + length, channels[0].begin());
+				std::fill_n(channels[1].begin(), length, 0.0f);
+				std::fill_n(channels[2].begin(), length, 0.0f);
+			break;
+
+			case DisplayType::CompositeColour:
+				// Take the average across a colour cycle as luminance.
+				box_filter(signal.data(), channels[0].data(), length, colour_cycle_length_);
+
+				if(amplitude < 0.01f) {
+					std::fill_n(channels[1].begin(), length, 0.0f);
+					std::fill_n(channels[2].begin(), length, 0.0f);
+				} else {
+					// Whatever isn't luminance is chrominance; demodulate that and undo the
+					// scaling that was applied to each component. Chrominance gain is
+					// as per the OpenGL scan target.
+					for(int c = 0; c < length; c++) {
+						chroma[size_t(c)] = signal[size_t(c)] - channels[0][size_t(c)];
+					}
+					demodulate(0.7071f / amplitude);
+
+					const float luminance_scale = 1.0f / std::max(1.0f - amplitude, 0.01f);
+					for(int c = 0; c < length; c++) {
+						channels[0][size_t(c)] *= luminance_scale;
+					}
+				}
+			break;
+
+			case DisplayType::SVideo:
+				std::copy(signal.begin(), signal.begin() + length, channels[0].begin());
+				demodulate(1.0f);
+			break;
+		}
+	}
+
+	// Resample to output pixels, taking four samples across the width of each.
+	const size_t pixels = size_t(x_end - x_begin);
+	float *output[3] = {
+		&workspace.output_channels[0],
+		&workspace.output_channels[pixels],
+		&workspace.output_channels[pixels * 2],
+	};
+	const float clocks_per_pixel = float(end_clock - start_clock) / (end_x - start_x);
+	const float weights[4] = {0.15f, 0.35f, 0.35f, 0.15f};
+	float *const filtered[3] = {signal.data(), chroma.data(), workspace.product.data()};
+	for(size_t channel = 0; channel < 3; channel++) {
+		sampling_filter(channels[channel].data(), filtered[channel], length, sample_offsets_, weights);
+	}
+
+	// Interpolate between the centres of clocks; positions are relative to the start of the composed line.
+	auto &samples = workspace.output_samples;
+	auto &fractions = workspace.output_fractions;
+	const float first_position = float(start_clock - first_clock) - 0.5f + (float(x_begin) + 0.5f - start_x) * clocks_per_pixel;
+	for(size_t c = 0; c < pixels; c++) {
+		const float position = first_position + float(c) * clocks_per_pixel;
+		samples[c] = std::clamp(int(position), 0, length - 2);
+		fractions[c] = std::clamp(position - float(samples[c]), 0.0f, 1.0f);
+	}
+	for(size_t channel = 0; channel < 3; channel++) {
+		const float *const source = filtered[channel];
+		float *const destination = output[channel];
+		for(size_t c = 0; c < pixels; c++) {
+			const float *const sample = &source[samples[c]];
+			destination[c] = sample[0] + (sample[1] - sample[0]) * fractions[c];
+		}
+	}
+
+	// Convert to RGB if necessary, apply brightness and store.
+	if(!is_rgb) {
+		apply_matrix(luma_chroma_to_rgb_, output, pixels);
+	}
+	if(brightness_ != 1.0f) {
+		for(size_t c = 0; c < pixels * 3; c++) {
+			workspace.output_channels[c] *= brightness_;
+		}
+	}
+
+	uint32_t *const destination = &line_pixels_[line_index * size_t(output_width_) + size_t(x_begin)];
+	pack_rgba(output[0], output[1], output[2], destination, pixels);
+
+	if(apply_gamma_) {
+		uint8_t *const bytes = reinterpret_cast<uint8_t *>(destination);
+		for(size_t c = 0; c < pixels * 4; c += 4) {
+			bytes[c + 0] = gamma_table_[bytes[c + 0]];
+			bytes[c + 1] = gamma_table_[bytes[c + 1]];
+			bytes[c + 2] = gamma_table_[bytes[c + 2]];
+		}
+	}
+
+	span.x_begin = x_begin;
+	span.x_end = x_end;
+	span.y_begin = y_begin;
+	span.y_end = y_end;
+}
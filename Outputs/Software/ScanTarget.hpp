@@ -0,0 +1,135 @@
+//
+//  ScanTarget.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "../ScanTargets/BufferingScanTarget.hpp"
+#include "../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Outputs::Display::Software {
+
+/*!
+	Provides a ScanTarget that rasterises to an RGBA framebuffer in main memory, requiring
+	no GPU or display.
+
+	Processing follows the same two stages as the OpenGL scan target: scans are first composed
+	into lines of normalised input samples, one sample per input clock, and those lines are then
+	decoded from RGB, S-Video or composite as dictated by the display type and resampled
+	into the framebuffer. Lines are spread across a pool of worker threads.
+*/
+class ScanTarget: public Outputs::Display::BufferingScanTarget {
+	public:
+		/*!
+			@param output_width The width of the framebuffer, in pixels.
+			@param output_height The height of the framebuffer, in pixels.
+			@param worker_threads The number of threads to use for processing, including the caller's;
+				0 means one per hardware thread.
+			@param output_gamma The gamma of whatever the framebuffer is ultimately going to be shown on.
+		*/
+		ScanTarget(int output_width = 640, int output_height = 480, size_t worker_threads = 0, float output_gamma = 2.2f);
+
+		/*! Processes all the latest input, updating the framebuffer. */
+		void update();
+
+		/*!
+			@returns The framebuffer, as RGBA data in raster order, being four bytes per pixel,
+				@c width() pixels per row and @c height() rows.
+
+			The contents are stable between calls to @c update().
+		*/
+		const uint8_t *framebuffer() const {
+			return reinterpret_cast<const uint8_t *>(framebuffer_.data());
+		}
+
+		int width() const	{	return output_width_;	}
+		int height() const	{	return output_height_;	}
+
+		/*! @returns The number of frames that have begun since this scan target was created. */
+		size_t frames() const {	return frames_;	}
+
+	private:
+		static constexpr int LineBufferWidth = 2048;
+		static constexpr int LineBufferHeight = 2048;
+
+		const int output_width_, output_height_;
+		const float output_gamma_;
+
+		// Storage for the various buffers.
+		std::vector<uint8_t> write_area_texture_;
+		std::array<Scan, LineBufferHeight*5> scan_buffer_;
+		std::array<Line, LineBufferHeight> line_buffer_;
+		std::array<LineMetadata, LineBufferHeight> line_metadata_buffer_;
+
+		// The framebuffer itself, plus a record of which of its rows have been touched in the current frame.
+		std::vector<uint32_t> framebuffer_;
+		std::vector<uint8_t> row_was_painted_;
+		bool painted_rows_are_valid_ = false;
+		size_t frames_ = 0;
+
+		size_t lines_submitted_ = 0;
+		std::chrono::high_resolution_clock::time_point line_submission_begin_time_;
+
+		// Receives scan target modals.
+		void setup_pipeline();
+
+		// Values derived from the current modals.
+		std::array<float, 9> rgb_to_luma_chroma_;
+		std::array<float, 9> luma_chroma_to_rgb_;
+		std::array<int, 4> sample_offsets_;
+		std::array<uint8_t, 256> gamma_table_;
+		bool apply_gamma_ = false;
+		float brightness_ = 1.0f;
+		int colour_cycle_length_ = 1;
+
+		/// Describes where in the framebuffer a line was rasterised to; the pixels themselves are
+		/// held in @c line_pixels_, @c output_width_ per line.
+		struct LineSpan {
+			int x_begin = 0, x_end = 0;
+			int y_begin = 0, y_end = 0;
+		};
+		std::array<LineSpan, LineBufferHeight> line_spans_;
+		std::vector<uint32_t> line_pixels_;
+
+		/// Per-worker storage for line processing, all indexed by input clock.
+		using Texel = std::array<uint8_t, 4>;
+		struct LineWorkspace {
+			std::array<Texel, LineBufferWidth> composition;
+			std::array<float, LineBufferWidth> signal, chroma, product;
+			std::array<float, LineBufferWidth + 4> cosines, sines;	// Padded for a final partial vector.
+			std::array<std::array<float, LineBufferWidth>, 3> channels;
+			std::vector<float> output_channels, output_fractions;
+			std::vector<int> output_samples;
+		};
+		std::vector<std::unique_ptr<LineWorkspace>> workspaces_;
+
+		// Worker threads; work is also done on the thread that calls update().
+		std::vector<std::unique_ptr<Concurrency::AsyncTaskQueue<true>>> workers_;
+
+		/// Calls @c job once for each of the workers, as @c job(index, total), and returns once all have completed.
+		void perform_in_parallel(const std::function<void(size_t, size_t)> &job);
+
+		/// Composes, decodes and rasterises line @c line, using the scans from @c begin_scan to @c end_scan.
+		void process_line(LineWorkspace &, size_t line, size_t begin_scan, size_t end_scan);
+
+		/// Composes the scans from @c begin_scan to @c end_scan into @c workspace.composition, which
+		/// is taken to hold @c length samples starting from @c first_clock.
+		void compose(LineWorkspace &, int first_clock, int length, size_t begin_scan, size_t end_scan);
+
+		/// Copies the rows in the range [@c begin_row, @c end_row) from lines [@c begin_line, @c end_line)
+		/// into the framebuffer.
+		void paint(uint16_t begin_line, uint16_t end_line, int begin_row, int end_row);
+};
+
+}
@@ -10,12 +10,78 @@
 
 #include "SampleSource.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <atomic>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace Outputs::Speaker {
 
+namespace Mixing {
+
+/// @returns The saturating sum of @c lhs and @c rhs.
+inline int16_t add(int16_t lhs, int16_t rhs) {
+	return int16_t(std::clamp(int(lhs) + int(rhs), -32768, 32767));
+}
+
+/*!
+	Adds @c count samples from @c source to @c target, saturating.
+*/
+inline void add(std::int16_t *target, const std::int16_t *source, std::size_t count) {
+	std::size_t c = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+	for(; c + 8 <= count; c += 8) {
+		const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&target[c]));
+		const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[c]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&target[c]), _mm_adds_epi16(lhs, rhs));
+	}
+#elif defined(__ARM_NEON)
+	for(; c + 8 <= count; c += 8) {
+		vst1q_s16(&target[c], vqaddq_s16(vld1q_s16(&target[c]), vld1q_s16(&source[c])));
+	}
+#endif
+	for(; c < count; c++) {
+		target[c] = add(target[c], source[c]);
+	}
+}
+
+/*!
+	Adds @c count mono samples from @c source to @c count stereo sample pairs at @c target, saturating.
+*/
+inline void add_widened(std::int16_t *target, const std::int16_t *source, std::size_t count) {
+	std::size_t c = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+	for(; c + 8 <= count; c += 8) {
+		const __m128i mono = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[c]));
+		const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&target[c * 2]));
+		const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&target[c * 2 + 8]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&target[c * 2]), _mm_adds_epi16(low, _mm_unpacklo_epi16(mono, mono)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&target[c * 2 + 8]), _mm_adds_epi16(high, _mm_unpackhi_epi16(mono, mono)));
+	}
+#elif defined(__ARM_NEON)
+	for(; c + 8 <= count; c += 8) {
+		const int16x8_t mono = vld1q_s16(&source[c]);
+		int16x8x2_t stereo = vld2q_s16(&target[c * 2]);
+		stereo.val[0] = vqaddq_s16(stereo.val[0], mono);
+		stereo.val[1] = vqaddq_s16(stereo.val[1], mono);
+		vst2q_s16(&target[c * 2], stereo);
+	}
+#endif
+	for(; c < count; c++) {
+		target[c * 2 + 0] = add(target[c * 2 + 0], source[c]);
+		target[c * 2 + 1] = add(target[c * 2 + 1], source[c]);
+	}
+}
+
+}
+
 /*!
 	A CompoundSource adds together the sound generated by multiple individual SampleSources.
 	An owner may optionally assign relative volumes.
@@ -32,13 +98,30 @@ template <typename... T> class CompoundSource:
 		}
 
 		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-			source_holder_.template get_samples<get_is_stereo()>(number_of_samples, target);
+			if(!source_holder_.template mix_samples<get_is_stereo()>(number_of_samples, target)) {
+				std::memset(target, 0, sizeof(std::int16_t) * number_of_samples * (get_is_stereo() ? 2 : 1));
+			}
 		}
 
 		void skip_samples(const std::size_t number_of_samples) {
 			source_holder_.skip_samples(number_of_samples);
 		}
 
+		/*!
+			Obtains steps from all sources that support them, and synthesises steps from the samples
+			of any that don't.
+		*/
+		template <typename TargetT> void get_steps(std::size_t number_of_samples, TargetT &target) {
+			source_holder_.get_steps(number_of_samples, target);
+		}
+
+		/*!
+			@returns @c true if every source owned by this CompoundSource is currently silent.
+		*/
+		bool is_zero_level() const {
+			return source_holder_.is_zero_level();
+		}
+
 		/*!
 			Sets the total output volume of this CompoundSource.
 		*/
@@ -64,6 +147,11 @@ template <typename... T> class CompoundSource:
 		*/
 		static constexpr bool get_is_stereo() { return CompoundSourceHolder<T...>::get_is_stereo(); }
 
+		/*!
+			@returns true if any of the sources owned by this CompoundSource supports steps.
+		*/
+		static constexpr bool get_supports_steps() { return CompoundSourceHolder<T...>::get_supports_steps(); }
+
 		/*!
 			@returns the average output peak given the sources owned by this CompoundSource and the
 				current relative volumes.
@@ -80,8 +168,14 @@ template <typename... T> class CompoundSource:
 
 		template <typename... S> class CompoundSourceHolder: public Outputs::Speaker::SampleSource {
 			public:
-				template <bool output_stereo> void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-					std::memset(target, 0, sizeof(std::int16_t) * number_of_samples);
+				template <bool output_stereo> bool mix_samples(std::size_t, std::int16_t *) {
+					return false;
+				}
+
+				template <typename TargetT> void get_steps(std::size_t, TargetT &) {}
+
+				bool is_zero_level() const {
+					return true;
 				}
 
 				void set_scaled_volume_range(int16_t, double *, double) {}
@@ -94,6 +188,10 @@ template <typename... T> class CompoundSource:
 					return false;
 				}
 
+				static constexpr bool get_supports_steps() {
+					return false;
+				}
+
 				double total_scale(double *) const {
 					return 0.0;
 				}
@@ -103,39 +201,51 @@ template <typename... T> class CompoundSource:
 			public:
 				CompoundSourceHolder(S &source, R &...next) : source_(source), next_source_(next...) {}
 
-				template <bool output_stereo> void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+				/*!
+					Adds this source's output and that of all subsequent sources to @c target, unless all are silent.
+
+					@returns @c true if anything was written to @c target; @c false if it has been left untouched.
+				*/
+				template <bool output_stereo> bool mix_samples(std::size_t number_of_samples, std::int16_t *target) {
 					// Get the rest of the output.
-					next_source_.template get_samples<output_stereo>(number_of_samples, target);
+					const bool has_output = next_source_.template mix_samples<output_stereo>(number_of_samples, target);
 
 					if(source_.is_zero_level()) {
 						// This component is currently outputting silence; therefore don't add anything to the output
 						// audio — just pass the call onward.
 						source_.skip_samples(number_of_samples);
-						return;
+						return has_output;
+					}
+
+					// If nothing else has been output and no mapping is required, write directly to the target.
+					if constexpr (output_stereo == S::get_is_stereo()) {
+						if(!has_output) {
+							source_.get_samples(number_of_samples, target);
+							return true;
+						}
 					}
 
 					// Get this component's output.
-					auto buffer_size = number_of_samples * (output_stereo ? 2 : 1);
-					int16_t local_samples[buffer_size];
-					source_.get_samples(number_of_samples, local_samples);
+					constexpr std::size_t channels = S::get_is_stereo() ? 2 : 1;
+					if(local_samples_.size() < number_of_samples * channels) {
+						local_samples_.resize(number_of_samples * channels);
+					}
+					source_.get_samples(number_of_samples, local_samples_.data());
 
 					// Merge it in; furthermore if total output is stereo but this source isn't,
-					// map it to stereo.
+					// map it to stereo. This will happen only if mapping from mono to stereo, never
+					// in the other direction, because the compound source outputs stereo if any
+					// subcomponent does. So it outputs mono only if no stereo devices are
+					// in the mixing chain.
+					if(!has_output) {
+						std::memset(target, 0, sizeof(std::int16_t) * number_of_samples * (output_stereo ? 2 : 1));
+					}
 					if constexpr (output_stereo == S::get_is_stereo()) {
-						while(buffer_size--) {
-							target[buffer_size] += local_samples[buffer_size];
-						}
+						Mixing::add(target, local_samples_.data(), number_of_samples * channels);
 					} else {
-						// This will happen only if mapping from mono to stereo, never in the
-						// other direction, because the compound source outputs stereo if any
-						// subcomponent does. So it outputs mono only if no stereo devices are
-						// in the mixing chain.
-						while(buffer_size--) {
-							target[buffer_size] += local_samples[buffer_size >> 1];
-						}
+						Mixing::add_widened(target, local_samples_.data(), number_of_samples);
 					}
-
-					// TODO: accelerate above?
+					return true;
 				}
 
 				void skip_samples(const std::size_t number_of_samples) {
@@ -143,12 +253,40 @@ template <typename... T> class CompoundSource:
 					next_source_.skip_samples(number_of_samples);
 				}
 
+				template <typename TargetT> void get_steps(std::size_t number_of_samples, TargetT &target) {
+					next_source_.get_steps(number_of_samples, target);
+
+					if constexpr (S::get_supports_steps()) {
+						source_.get_steps(number_of_samples, target);
+					} else {
+						// Synthesise steps from the differences between samples.
+						if(source_.is_zero_level()) {
+							post_step(target, 0, 0, 0);
+							source_.skip_samples(number_of_samples);
+							return;
+						}
+
+						constexpr std::size_t channels = S::get_is_stereo() ? 2 : 1;
+						if(local_samples_.size() < number_of_samples * channels) {
+							local_samples_.resize(number_of_samples * channels);
+						}
+						source_.get_samples(number_of_samples, local_samples_.data());
+						for(std::size_t c = 0; c < number_of_samples; c++) {
+							post_step(target, c, local_samples_[c * channels], local_samples_[c * channels + channels - 1]);
+						}
+					}
+				}
+
 				void set_scaled_volume_range(int16_t range, double *volumes, double scale) {
 					const auto scaled_range = volumes[0] / double(source_.get_average_output_peak()) * double(range) / scale;
 					source_.set_sample_volume_range(int16_t(scaled_range));
 					next_source_.set_scaled_volume_range(range, &volumes[1], scale);
 				}
 
+				bool is_zero_level() const {
+					return source_.is_zero_level() && next_source_.is_zero_level();
+				}
+
 				static constexpr std::size_t size() {
 					return 1 + CompoundSourceHolder<R...>::size();
 				}
@@ -157,6 +295,10 @@ template <typename... T> class CompoundSource:
 					return S::get_is_stereo() || CompoundSourceHolder<R...>::get_is_stereo();
 				}
 
+				static constexpr bool get_supports_steps() {
+					return S::get_supports_steps() || CompoundSourceHolder<R...>::get_supports_steps();
+				}
+
 				double total_scale(double *volumes) const {
 					return (volumes[0] / source_.get_average_output_peak()) + next_source_.total_scale(&volumes[1]);
 				}
@@ -164,6 +306,31 @@ template <typename... T> class CompoundSource:
 			private:
 				S &source_;
 				CompoundSourceHolder<R...> next_source_;
+
+				// Scratch space for this source's output, prior to mixing.
+				std::vector<std::int16_t> local_samples_;
+
+				// The most recent level posted as steps on behalf of a source that doesn't support them.
+				int16_t level_[2]{};
+
+				// Steps are limited to the range of an int16_t; a larger change is posted as the largest step
+				// possible, leaving the remainder to be posted with the next sample.
+				static int16_t step(int16_t target, int16_t &level) {
+					const auto delta = int16_t(std::clamp(int(target) - int(level), -32768, 32767));
+					level = int16_t(level + delta);
+					return delta;
+				}
+
+				template <typename TargetT> void post_step(TargetT &target, std::size_t offset, int16_t left, int16_t right) {
+					if(left == level_[0] && right == level_[1]) return;
+					if constexpr (S::get_is_stereo()) {
+						const auto left_delta = step(left, level_[0]);
+						target.add_step(offset, left_delta, step(right, level_[1]));
+					} else {
+						target.add_step(offset, step(left, level_[0]));
+						level_[1] = level_[0];
+					}
+				}
 		};
 
 		CompoundSourceHolder<T...> source_holder_;
@@ -9,11 +9,13 @@
 #pragma once
 
 #include "../Speaker.hpp"
+#include "../../../SignalProcessing/BandLimitedSteps.hpp"
 #include "../../../SignalProcessing/FIRFilter.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../Concurrency/AsyncTaskQueue.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -51,6 +53,24 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 			filter_parameters_.parameters_are_dirty = true;
 		}
 
+		/*!
+			Enables or disables band-limited step synthesis. If enabled, and if the source supports steps, then
+			whenever the input rate exceeds the output rate this speaker will obtain only changes in level from the
+			source and render those directly at the output rate, rather than obtaining and filtering a sample per
+			input cycle.
+
+			That's usually substantially faster for sources that change level only occasionally relative to the
+			input rate, such as most square-wave sound chips.
+		*/
+		void set_uses_band_limited_steps(bool uses_band_limited_steps) {
+			std::lock_guard lock_guard(filter_parameters_mutex_);
+			if(filter_parameters_.uses_band_limited_steps == uses_band_limited_steps) {
+				return;
+			}
+			filter_parameters_.uses_band_limited_steps = uses_band_limited_steps;
+			filter_parameters_.parameters_are_dirty = true;
+		}
+
 	private:
 		float get_ideal_clock_rate_in_range(float minimum, float maximum) final {
 			std::lock_guard lock_guard(filter_parameters_mutex_);
@@ -93,15 +113,43 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 		std::vector<int16_t> input_buffer_;
 		std::vector<int16_t> output_buffer_;
 
+		// When resampling to a lower rate, input is de-interleaved into per-channel buffers several filter
+		// windows long. The filter window slides along those and whatever remains of it is moved back
+		// to the start only upon reaching the end.
+		static constexpr std::size_t FilterWindowsPerBuffer = 8;
+		std::array<std::vector<int16_t>, is_stereo + 1> channel_input_;
+		std::size_t filter_window_start_ = 0;
+
+		// Input from this position onwards is known to be silent, so any filter window that begins here
+		// will produce silence.
+		std::size_t silence_start_ = 0;
+
 		float step_rate_ = 0.0f;
 		float position_error_ = 0.0f;
 		std::unique_ptr<SignalProcessing::FIRFilter> filter_;
 
+		// Upsampling uses a polyphase filter: a single prototype filter at UpsamplingPhases times
+		// the input rate is split into UpsamplingPhases sets of UpsamplingTapsPerPhase coefficients,
+		// each of which produces output at a particular fractional offset between input samples.
+		static constexpr std::size_t UpsamplingPhases = 256;
+		static constexpr std::size_t UpsamplingTapsPerPhase = 16;
+		static constexpr std::size_t UpsamplingInputChunk = 256;
+		std::vector<int16_t> phase_coefficients_;
+
+		// Recent input, stored twice over so that the most recent UpsamplingTapsPerPhase samples
+		// are always contiguous.
+		std::vector<int16_t> upsampling_history_;
+		std::size_t upsampling_history_pointer_ = 0;
+
+		// Band-limited step synthesis renders directly at the output rate.
+		SignalProcessing::BandLimitedSteps<is_stereo + 1> steps_;
+
 		std::mutex filter_parameters_mutex_;
 		struct FilterParameters {
 			float input_cycles_per_second = 0.0f;
 			float output_cycles_per_second = 0.0f;
 			float high_frequency_cutoff = -1.0;
+			bool uses_band_limited_steps = false;
 
 			bool parameters_are_dirty = true;
 			bool input_rate_changed = false;
@@ -135,6 +183,12 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 				// If input and output rates exactly match, and no additional cut-off has been specified,
 				// just accumulate results and pass on.
 				conversion_ = Conversion::Copy;
+			} else if(
+				ConcreteT::get_supports_steps() && filter_parameters.uses_band_limited_steps &&
+				filter_parameters.input_cycles_per_second > filter_parameters.output_cycles_per_second
+			) {
+				// If the source can describe itself as steps and that's been requested, skip the filter.
+				conversion_ = Conversion::BandLimitedSteps;
 			} else if(	filter_parameters.input_cycles_per_second > filter_parameters.output_cycles_per_second ||
 				(filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second && filter_parameters.high_frequency_cutoff >= 0.0)) {
 				// If the output rate is less than the input rate, or an additional cut-off has been specified, use the filter.
@@ -144,84 +198,214 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 			}
 
 			// Do something sensible with any dangling input, if necessary.
-			const int scale = static_cast<ConcreteT *>(this)->get_scale();
 			switch(conversion_) {
-				// Neither direct copying nor resampling larger currently use any temporary input.
-				// Although in the latter case that's just because it's unimplemented. But, regardless,
-				// that means nothing to do.
+				// Direct copying doesn't use any temporary input.
 				default: break;
 
+				case Conversion::BandLimitedSteps:
+					steps_.set_rates(
+						filter_parameters.input_cycles_per_second,
+						filter_parameters.output_cycles_per_second,
+						high_pass_frequency,
+						number_of_taps);
+				break;
+
+				case Conversion::ResampleLarger: {
+					// Build the coefficient bank. The prototype filter has unity gain at its own sampling
+					// rate, so each phase needs to be scaled up by the number of phases.
+					//
+					// FIRFilter produces only odd-length filters, so request one tap fewer than the bank
+					// holds and treat the final tap as zero; that keeps the prototype symmetric about its
+					// centre rather than having it truncated at one end.
+					const float cutoff = std::min(high_pass_frequency, filter_parameters.input_cycles_per_second * 0.5f);
+					const auto prototype = SignalProcessing::FIRFilter::coefficients(
+						UpsamplingPhases * UpsamplingTapsPerPhase - 1,
+						filter_parameters.input_cycles_per_second * float(UpsamplingPhases),
+						0.0f,
+						cutoff,
+						SignalProcessing::FIRFilter::DefaultAttenuation);
+
+					// History is oldest sample first, so store each phase's coefficients in reverse.
+					phase_coefficients_.resize(UpsamplingPhases * UpsamplingTapsPerPhase);
+					for(std::size_t phase = 0; phase < UpsamplingPhases; phase++) {
+						for(std::size_t tap = 0; tap < UpsamplingTapsPerPhase; tap++) {
+							const std::size_t index = tap * UpsamplingPhases + phase;
+							const float coefficient =
+								(index < prototype.size() ? prototype[index] : 0.0f) * float(UpsamplingPhases) * 32767.0f;
+							phase_coefficients_[phase * UpsamplingTapsPerPhase + UpsamplingTapsPerPhase - 1 - tap] =
+								int16_t(std::clamp(coefficient, -32768.0f, 32767.0f));
+						}
+					}
+
+					// Input is read in chunks and consumed immediately, so there's nothing worth keeping.
+					input_buffer_.resize(UpsamplingInputChunk * (is_stereo + 1));
+					input_buffer_depth_ = filter_window_start_ = 0;
+					upsampling_history_.assign(2 * UpsamplingTapsPerPhase * (is_stereo + 1), 0);
+					upsampling_history_pointer_ = 0;
+				} break;
+
 				case Conversion::ResampleSmaller: {
-					// Reize the input buffer only if absolutely necessary; if sizing downward
-					// such that a sample would otherwise be lost then output it now. Keep anything
-					// currently in the input buffer that hasn't yet been processed.
-					const size_t required_buffer_size = size_t(number_of_taps) * (is_stereo + 1);
-					if(input_buffer_.size() != required_buffer_size) {
-						if(input_buffer_depth_ >= required_buffer_size) {
-							resample_input_buffer(scale);
-							input_buffer_depth_ %= required_buffer_size;
+					// Keep whatever of the input buffers hasn't yet been processed, as far as it'll fit.
+					const size_t required_buffer_size = size_t(number_of_taps) * FilterWindowsPerBuffer;
+					if(channel_input_[0].size() != required_buffer_size) {
+						compact_input_buffers();
+						input_buffer_depth_ = std::min(input_buffer_depth_, required_buffer_size);
+						silence_start_ = std::min(silence_start_, input_buffer_depth_);
+						for(auto &buffer: channel_input_) {
+							buffer.resize(required_buffer_size);
+						}
+						if constexpr (is_stereo) {
+							input_buffer_.resize(required_buffer_size * 2);
 						}
-						input_buffer_.resize(required_buffer_size);
 					}
 				} break;
 			}
 		}
 
-		inline void resample_input_buffer(int scale) {
+		/// Moves whatever remains of the current filter window to the start of the per-channel input buffers.
+		inline void compact_input_buffers() {
+			if(filter_window_start_ < input_buffer_depth_) {
+				if(filter_window_start_) {
+					for(auto &buffer: channel_input_) {
+						std::memmove(
+							buffer.data(),
+							&buffer[filter_window_start_],
+							sizeof(int16_t) * (input_buffer_depth_ - filter_window_start_));
+					}
+				}
+				input_buffer_depth_ -= filter_window_start_;
+				silence_start_ -= std::min(silence_start_, filter_window_start_);
+				filter_window_start_ = 0;
+			} else {
+				// The next window begins after everything buffered; retain the number of samples
+				// that can be skipped entirely.
+				filter_window_start_ -= input_buffer_depth_;
+				input_buffer_depth_ = silence_start_ = 0;
+			}
+		}
+
+		/// Outputs as many filtered samples as the per-channel input buffers currently allow.
+		inline void resample_input_buffers(int scale) {
+			const auto number_of_taps = filter_->get_number_of_taps();
+			while(filter_window_start_ + number_of_taps <= input_buffer_depth_) {
+				if(!output_buffer_.empty()) {
+					if(filter_window_start_ >= silence_start_) {
+						// There's no need to filter silence.
+						for(std::size_t channel = 0; channel < is_stereo + 1; channel++) {
+							output_buffer_[output_buffer_pointer_ + channel] = 0;
+						}
+					} else {
+						for(std::size_t channel = 0; channel < is_stereo + 1; channel++) {
+							int16_t &output = output_buffer_[output_buffer_pointer_ + channel];
+							output = filter_->apply(&channel_input_[channel][filter_window_start_]);
+
+							// Apply scale, if supplied, clamping appropriately.
+							if(scale != 65536) {
+								output = int16_t(std::clamp((int(output) * scale) >> 16, -32768, 32767));
+							}
+						}
+					}
+					output_buffer_pointer_ += is_stereo + 1;
+
+					// Announce to delegate if full.
+					if(output_buffer_pointer_ == output_buffer_.size()) {
+						output_buffer_pointer_ = 0;
+						did_complete_samples(this, output_buffer_, is_stereo);
+					}
+				}
+
+				// Advance the window; if it moves beyond the end of buffered input then the
+				// difference will be skipped.
+				filter_window_start_ += size_t(step_rate_ + position_error_);
+				position_error_ = fmodf(step_rate_ + position_error_, 1.0f);
+			}
+		}
+
+		inline void upsample_input_buffer(std::size_t length, int scale) {
 			if(output_buffer_.empty()) {
 				return;
 			}
 
-			if constexpr (is_stereo) {
-				output_buffer_[output_buffer_pointer_ + 0] = filter_->apply(input_buffer_.data(), 2);
-				output_buffer_[output_buffer_pointer_ + 1] = filter_->apply(input_buffer_.data() + 1, 2);
-				output_buffer_pointer_+= 2;
-			} else {
-				output_buffer_[output_buffer_pointer_] = filter_->apply(input_buffer_.data());
-				output_buffer_pointer_++;
-			}
+			constexpr std::size_t channels = is_stereo + 1;
+			for(std::size_t input = 0; input < length; input++) {
+				// Add this sample to the history.
+				for(std::size_t channel = 0; channel < channels; channel++) {
+					const auto sample = input_buffer_[input * channels + channel];
+					upsampling_history_[upsampling_history_pointer_ * channels + channel] = sample;
+					upsampling_history_[(upsampling_history_pointer_ + UpsamplingTapsPerPhase) * channels + channel] = sample;
+				}
+				upsampling_history_pointer_ = (upsampling_history_pointer_ + 1) % UpsamplingTapsPerPhase;
+				const int16_t *const history = &upsampling_history_[upsampling_history_pointer_ * channels];
+
+				// Output everything that falls between this sample and the next.
+				while(position_error_ < 1.0f) {
+					const auto phase = std::min(std::size_t(position_error_ * float(UpsamplingPhases)), UpsamplingPhases - 1);
+					const int16_t *const coefficients = &phase_coefficients_[phase * UpsamplingTapsPerPhase];
+
+					for(std::size_t channel = 0; channel < channels; channel++) {
+						int result = 0;
+						for(std::size_t tap = 0; tap < UpsamplingTapsPerPhase; tap++) {
+							result += coefficients[tap] * history[tap * channels + channel];
+						}
+						result >>= 15;
+
+						// Apply scale, if supplied, clamping appropriately.
+						if(scale != 65536) {
+							result = (result * scale) >> 16;
+						}
+						output_buffer_[output_buffer_pointer_ + channel] = int16_t(std::clamp(result, -32768, 32767));
+					}
+					output_buffer_pointer_ += channels;
 
-			// Apply scale, if supplied, clamping appropriately.
-			if(scale != 65536) {
-				#define SCALE(x) x = int16_t(std::clamp((int(x) * scale) >> 16, -32768, 32767))
-				if constexpr (is_stereo) {
-					SCALE(output_buffer_[output_buffer_pointer_ - 2]);
-					SCALE(output_buffer_[output_buffer_pointer_ - 1]);
-				} else {
-					SCALE(output_buffer_[output_buffer_pointer_ - 1]);
+					// Announce to delegate if full.
+					if(output_buffer_pointer_ == output_buffer_.size()) {
+						output_buffer_pointer_ = 0;
+						did_complete_samples(this, output_buffer_, is_stereo);
+					}
+
+					position_error_ += step_rate_;
 				}
-				#undef SCALE
+				position_error_ -= 1.0f;
 			}
+		}
 
-			// Announce to delegate if full.
-			if(output_buffer_pointer_ == output_buffer_.size()) {
-				output_buffer_pointer_ = 0;
-				did_complete_samples(this, output_buffer_, is_stereo);
-			}
+		/// Outputs everything that band-limited step synthesis has completed.
+		inline void output_steps(int scale) {
+			constexpr std::size_t channels = is_stereo + 1;
+			std::size_t available = steps_.available();
+			while(available) {
+				if(output_buffer_.empty()) {
+					steps_.read(nullptr, available);
+					return;
+				}
 
-			// If the next loop around is going to reuse some of the samples just collected, use a memmove to
-			// preserve them in the correct locations (TODO: use a longer buffer to fix that?) and don't skip
-			// anything. Otherwise skip as required to get to the next sample batch and don't expect to reuse.
-			const size_t steps = size_t(step_rate_ + position_error_) * (is_stereo + 1);
-			position_error_ = fmodf(step_rate_ + position_error_, 1.0f);
-			if(steps < input_buffer_.size()) {
-				auto *const input_buffer = input_buffer_.data();
-				std::memmove(	input_buffer,
-								&input_buffer[steps],
-								sizeof(int16_t) * (input_buffer_.size() - steps));
-				input_buffer_depth_ -= steps;
-			} else {
-				if(steps > input_buffer_.size()) {
-					static_cast<ConcreteT *>(this)->skip_samples((steps - input_buffer_.size()) / (1 + is_stereo));
+				const auto samples = std::min(available, (output_buffer_.size() - output_buffer_pointer_) / channels);
+				int16_t *const output = &output_buffer_[output_buffer_pointer_];
+				steps_.read(output, samples);
+
+				// Apply scale, if supplied, clamping appropriately.
+				if(scale != 65536) {
+					for(std::size_t c = 0; c < samples * channels; c++) {
+						output[c] = int16_t(std::clamp((int(output[c]) * scale) >> 16, -32768, 32767));
+					}
+				}
+
+				output_buffer_pointer_ += samples * channels;
+				available -= samples;
+
+				// Announce to delegate if full.
+				if(output_buffer_pointer_ == output_buffer_.size()) {
+					output_buffer_pointer_ = 0;
+					did_complete_samples(this, output_buffer_, is_stereo);
 				}
-				input_buffer_depth_ = 0;
 			}
 		}
 
 		enum class Conversion {
 			ResampleSmaller,
 			Copy,
-			ResampleLarger
+			ResampleLarger,
+			BandLimitedSteps
 		} conversion_ = Conversion::Copy;
 
 		bool recalculate_filter_if_dirty() {
@@ -251,7 +435,12 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 				case Conversion::Copy:
 					while(length) {
 						const auto samples_to_read = std::min((output_buffer_.size() - output_buffer_pointer_) / (1 + is_stereo), length);
-						static_cast<ConcreteT *>(this)->get_samples(samples_to_read, &output_buffer_[output_buffer_pointer_ ]);
+						if(static_cast<ConcreteT *>(this)->is_zero_level()) {
+							static_cast<ConcreteT *>(this)->skip_samples(samples_to_read);
+							std::fill_n(&output_buffer_[output_buffer_pointer_], samples_to_read * (1 + is_stereo), 0);
+						} else {
+							static_cast<ConcreteT *>(this)->get_samples(samples_to_read, &output_buffer_[output_buffer_pointer_ ]);
+						}
 						output_buffer_pointer_ += samples_to_read * (1 + is_stereo);
 
 						// TODO: apply scale.
@@ -268,20 +457,73 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 
 				case Conversion::ResampleSmaller:
 					while(length) {
-						const auto cycles_to_read = std::min((input_buffer_.size() - input_buffer_depth_) / (1 + is_stereo), length);
-						static_cast<ConcreteT *>(this)->get_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
-						input_buffer_depth_ += cycles_to_read * (1 + is_stereo);
+						// Make space if the input buffers are full or if the next filter window begins
+						// beyond everything buffered.
+						if(input_buffer_depth_ == channel_input_[0].size() || filter_window_start_ >= input_buffer_depth_) {
+							compact_input_buffers();
+						}
 
-						if(input_buffer_depth_ == input_buffer_.size()) {
-							resample_input_buffer(scale);
+						// Skip any input that won't contribute to output.
+						if(filter_window_start_ > input_buffer_depth_) {
+							const auto cycles_to_skip = std::min(filter_window_start_, length);
+							static_cast<ConcreteT *>(this)->skip_samples(cycles_to_skip);
+							filter_window_start_ -= cycles_to_skip;
+							length -= cycles_to_skip;
+							continue;
 						}
 
+						const auto cycles_to_read = std::min(channel_input_[0].size() - input_buffer_depth_, length);
+						if(static_cast<ConcreteT *>(this)->is_zero_level()) {
+							// Silence needs only to be recorded, not obtained, and extends whatever silence precedes it.
+							static_cast<ConcreteT *>(this)->skip_samples(cycles_to_read);
+							for(auto &buffer: channel_input_) {
+								std::fill_n(&buffer[input_buffer_depth_], cycles_to_read, 0);
+							}
+						} else if constexpr (is_stereo) {
+							// De-interleave once, so that the filter sees contiguous samples for each channel.
+							static_cast<ConcreteT *>(this)->get_samples(cycles_to_read, input_buffer_.data());
+							for(std::size_t c = 0; c < cycles_to_read; c++) {
+								channel_input_[0][input_buffer_depth_ + c] = input_buffer_[c*2 + 0];
+								channel_input_[1][input_buffer_depth_ + c] = input_buffer_[c*2 + 1];
+							}
+							silence_start_ = input_buffer_depth_ + cycles_to_read;
+						} else {
+							static_cast<ConcreteT *>(this)->get_samples(cycles_to_read, &channel_input_[0][input_buffer_depth_]);
+							silence_start_ = input_buffer_depth_ + cycles_to_read;
+						}
+						input_buffer_depth_ += cycles_to_read;
 						length -= cycles_to_read;
+
+						resample_input_buffers(scale);
 					}
 				break;
 
 				case Conversion::ResampleLarger:
-					// TODO: input rate is less than output rate.
+					while(length) {
+						const auto cycles_to_read = std::min(input_buffer_.size() / (1 + is_stereo), length);
+						if(static_cast<ConcreteT *>(this)->is_zero_level()) {
+							static_cast<ConcreteT *>(this)->skip_samples(cycles_to_read);
+							std::fill_n(input_buffer_.begin(), cycles_to_read * (1 + is_stereo), 0);
+						} else {
+							static_cast<ConcreteT *>(this)->get_samples(cycles_to_read, input_buffer_.data());
+						}
+						upsample_input_buffer(cycles_to_read, scale);
+
+						length -= cycles_to_read;
+					}
+				break;
+
+				case Conversion::BandLimitedSteps:
+					if constexpr (ConcreteT::get_supports_steps()) {
+						while(length) {
+							const auto cycles_to_read = std::min(steps_.maximum_advance(), length);
+							static_cast<ConcreteT *>(this)->get_steps(cycles_to_read, steps_);
+							steps_.advance(cycles_to_read);
+							output_steps(scale);
+
+							length -= cycles_to_read;
+						}
+					}
 				break;
 			}
 
@@ -315,6 +557,14 @@ template <bool is_stereo> class PushLowpass: public LowpassBase<PushLowpass<is_s
 			buffer_ += word_length;
 		}
 
+		static constexpr bool get_supports_steps() {
+			return false;
+		}
+
+		bool is_zero_level() const {
+			return false;
+		}
+
 	public:
 		void set_output_volume(float volume) final {
 			scale_.store(int(std::clamp(volume * 65536.0f, 0.0f, 65536.0f)));
@@ -406,6 +656,18 @@ template <typename SampleSource> class PullLowpass: public LowpassBase<PullLowpa
 		void get_samples(size_t length, int16_t *target) {
 			sample_source_.get_samples(length, target);
 		}
+
+		bool is_zero_level() const {
+			return sample_source_.is_zero_level();
+		}
+
+		static constexpr bool get_supports_steps() {
+			return SampleSource::get_supports_steps();
+		}
+
+		template <typename TargetT> void get_steps(size_t length, TargetT &target) {
+			sample_source_.get_steps(length, target);
+		}
 };
 
 }
@@ -36,6 +36,24 @@ class SampleSource {
 			get_samples(number_of_samples, scratch_pad);
 		}
 
+		/*!
+			Optionally, as an alternative to @c get_samples: should advance by @c number_of_samples, describing output
+			only as a series of changes in level. Each change should be posted as @c target.add_step(offset, delta),
+			or @c target.add_step(offset, left_delta, right_delta) if stereo, with @c offset being the number of samples
+			since the start of this call.
+
+			The target holds the sum of all changes so far as the current level, so any change that occurred
+			between calls, such as due to a register write, should be posted at offset 0.
+
+			Sources that implement this should also return @c true from @c get_supports_steps.
+		*/
+		template <typename TargetT> void get_steps([[maybe_unused]] std::size_t number_of_samples, [[maybe_unused]] TargetT &target) {}
+
+		/*!
+			Indicates whether this component implements @c get_steps.
+		*/
+		static constexpr bool get_supports_steps() { return false; }
+
 		/*!
 			@returns @c true if it is trivially true that a call to get_samples would just
 				fill the target with zeroes; @c false if a call might return all zeroes or
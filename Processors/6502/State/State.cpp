@@ -30,6 +30,7 @@ State::State(const ProcessorBase &src): State() {
 	execution_state.operand = src.operand_;
 	execution_state.address = src.address_.full;
 	execution_state.next_address = src.next_address_.full;
+	execution_state.cycles_left_to_run = src.cycles_left_to_run_.as<int>();
 	if(src.ready_is_active_) {
 		execution_state.phase = State::ExecutionState::Phase::Ready;
 	} else if(src.is_jammed_) {
@@ -50,7 +51,7 @@ State::State(const ProcessorBase &src): State() {
 	assert(&src.operations_[execution_state.micro_program][execution_state.micro_program_offset] == src.scheduled_program_counter_);
 }
 
-void State::apply(ProcessorBase &target) {
+void State::apply(ProcessorBase &target) const {
 	// Registers.
 	target.pc_.full = registers.program_counter;
 	target.s_ = registers.stack_pointer;
@@ -79,6 +80,7 @@ void State::apply(ProcessorBase &target) {
 	target.operand_ = execution_state.operand;
 	target.address_.full = execution_state.address;
 	target.next_address_.full = execution_state.next_address;
+	target.cycles_left_to_run_ = Cycles(execution_state.cycles_left_to_run);
 	target.scheduled_program_counter_ = &target.operations_[execution_state.micro_program][execution_state.micro_program_offset];
 }
 
@@ -112,6 +114,7 @@ State::ExecutionState::ExecutionState() {
 		DeclareField(operand);
 		DeclareField(address);
 		DeclareField(next_address);
+		DeclareField(cycles_left_to_run);
 	}
 }
 
@@ -74,6 +74,9 @@ struct State: public Reflection::StructImpl<State> {
 		uint8_t operation, operand;
 		uint16_t address, next_address;
 
+		/// The balance of time carried between calls to run_for; usually zero or negative.
+		int cycles_left_to_run = 0;
+
 		ExecutionState();
 	} execution_state;
 
@@ -84,7 +87,7 @@ struct State: public Reflection::StructImpl<State> {
 	State(const ProcessorBase &src);
 
 	/// Applies this state to @c target.
-	void apply(ProcessorBase &target);
+	void apply(ProcessorBase &target) const;
 };
 
 }
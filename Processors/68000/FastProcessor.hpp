@@ -0,0 +1,202 @@
+//
+//  FastProcessor.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "68000.hpp"
+#include "../../InstructionSets/M68k/Executor.hpp"
+
+#include <optional>
+
+namespace CPU::MC68000 {
+
+/*!
+	Provides the same interface as @c Processor, driving the same @c BusHandler, but is implemented
+	via the instruction-granularity @c InstructionSet::M68k::Executor rather than microcycle by microcycle.
+
+	Each access is presented to the bus handler as the same pair of address-strobe and data-strobe microcycles
+	that @c Processor would use, so bus handlers need no modification. But time is only approximated:
+	every word or byte access costs four cycles, plus any delay returned by the bus handler or a full
+	E cycle if VPA is asserted; each instruction costs a further two cycles beyond its accesses.
+
+	So this is intended for use where throughput matters more than timing fidelity.
+*/
+template <class BusHandler, InstructionSet::M68k::Model model = InstructionSet::M68k::Model::M68000>
+class FastProcessor {
+	public:
+		FastProcessor(BusHandler &bus_handler) : bus_handler_(bus_handler), bus_(*this) {}
+		FastProcessor(const FastProcessor& rhs) = delete;
+		FastProcessor& operator=(const FastProcessor& rhs) = delete;
+
+		void run_for(HalfCycles duration) {
+			// Reset upon first use rather than at construction, as the owner is unlikely yet
+			// to be in a position to respond to bus activity.
+			if(!executor_) {
+				executor_.emplace(bus_);
+				executor_->set_interrupt_level(interrupt_level_);
+				is_running_ = true;
+			}
+
+			time_remaining_ += duration;
+			while(time_remaining_ > HalfCycles(0)) {
+				// Guess at a number of instructions that will fit, allowing some slight overrun.
+				const int instructions = 1 + int(time_remaining_.as_integral() / 64);
+
+				const auto start_time = time_remaining_;
+				executor_->run_for_instructions(instructions);
+
+				if(time_remaining_ == start_time) {
+					// No bus activity means that the processor is STOPped. So just idle, giving the bus
+					// handler opportunities to signal an interrupt.
+					idle_.length = HalfCycles(40);
+				} else {
+					idle_.length = HalfCycles(4 * instructions);
+				}
+				perform(idle_, false);
+			}
+		}
+
+		/// @returns The current processor state.
+		CPU::MC68000::State get_state() {
+			CPU::MC68000::State state{};
+			if(executor_) {
+				state.registers = executor_->get_state();
+			}
+			return state;
+		}
+
+		/// Sets the VPA (valid peripheral address) line — @c true for active, @c false for inactive.
+		inline void set_is_peripheral_address(bool is_peripheral_address) {
+			vpa_ = is_peripheral_address;
+		}
+
+		/// Sets the bus error line — @c true for active, @c false for inactive.
+		inline void set_bus_error(bool bus_error) {
+			berr_ = bus_error;
+		}
+
+		/// Sets the interrupt lines, IPL0, IPL1 and IPL2.
+		inline void set_interrupt_level(int interrupt_level) {
+			interrupt_level_ = interrupt_level;
+			if(executor_) {
+				executor_->set_interrupt_level(interrupt_level);
+			}
+		}
+
+	private:
+		BusHandler &bus_handler_;
+		HalfCycles time_remaining_;
+		bool vpa_ = false, berr_ = false;
+		int interrupt_level_ = 0;
+
+		/// Adapts the executor's bus requests into microcycles.
+		struct Bus {
+			Bus(FastProcessor &processor) : processor_(processor) {}
+
+			template <typename IntT> IntT read(uint32_t address, InstructionSet::M68k::FunctionCode function) {
+				if constexpr (sizeof(IntT) == 4) {
+					const uint32_t high = read<uint16_t>(address, function);
+					return (high << 16) | read<uint16_t>(address + 2, function);
+				} else {
+					SlicedInt16 value;
+					processor_.access(address, function, Operation::Read | select<IntT>(), value);
+					if constexpr (sizeof(IntT) == 2) {
+						return value.w;
+					} else {
+						return value.b;
+					}
+				}
+			}
+
+			template <typename IntT> void write(uint32_t address, IntT value, InstructionSet::M68k::FunctionCode function) {
+				if constexpr (sizeof(IntT) == 4) {
+					write<uint16_t>(address, uint16_t(value >> 16), function);
+					write<uint16_t>(address + 2, uint16_t(value), function);
+				} else {
+					SlicedInt16 bus_value;
+					if constexpr (sizeof(IntT) == 2) {
+						bus_value.w = value;
+					} else {
+						bus_value.b = value;
+					}
+					processor_.access(address, function, select<IntT>(), bus_value);
+				}
+			}
+
+			void reset() {
+				processor_.perform(processor_.reset_cycle_, true);
+			}
+
+			int acknowlege_interrupt(int interrupt_level) {
+				return processor_.acknowledge_interrupt(interrupt_level);
+			}
+
+			private:
+				FastProcessor &processor_;
+
+				template <typename IntT> static constexpr OperationT select() {
+					return sizeof(IntT) == 1 ? Operation::SelectByte : Operation::SelectWord;
+				}
+		} bus_;
+		friend Bus;
+
+		std::optional<InstructionSet::M68k::Executor<model, Bus>> executor_;
+		bool is_running_ = false;
+
+		// Microcycles as used by Processor; see its storage.
+		Microcycle<Operation::DecodeDynamically> announce_, access_;
+		Microcycle<OperationT(0)> idle_;
+		Microcycle<Operation::Reset> reset_cycle_ { HalfCycles(248) };
+		Microcycle<Operation::InterruptAcknowledge | Operation::Read | Operation::NewAddress> interrupt_cycle0_;
+		Microcycle<Operation::InterruptAcknowledge | Operation::Read | Operation::SameAddress | Operation::SelectByte> interrupt_cycle1_;
+		uint32_t address_ = 0;
+
+		template <typename MicrocycleT> void perform(const MicrocycleT &cycle, bool is_supervisor) {
+			time_remaining_ -= cycle.length + bus_handler_.perform_bus_operation(cycle, is_supervisor);
+		}
+
+		void access(uint32_t address, InstructionSet::M68k::FunctionCode function, OperationT operation, SlicedInt16 &value) {
+			// FC0 and FC1 map directly to IsData and IsProgram; FC2 indicates supervisor mode.
+			const OperationT function_flags = OperationT(int(function) & 3) << 8;
+			const bool is_supervisor = int(function) & 4;
+
+			address_ = address;
+			announce_.address = access_.address = &address_;
+			access_.value = &value;
+
+			announce_.operation = Operation::NewAddress | (operation & Operation::Read) | function_flags;
+			announce_.length = HalfCycles(4);
+			perform(announce_, is_supervisor);
+			if(berr_ && is_running_) {
+				executor_->signal_bus_error(function, address);
+			}
+
+			access_.operation = Operation::SameAddress | operation | function_flags;
+			access_.length = vpa_ ? HalfCycles(20) : HalfCycles(4);
+			perform(access_, is_supervisor);
+			if(berr_ && is_running_) {
+				executor_->signal_bus_error(function, address);
+			}
+		}
+
+		int acknowledge_interrupt(int interrupt_level) {
+			SlicedInt16 vector;
+			address_ = 0xffff'fff1 | uint32_t(interrupt_level << 1);
+			interrupt_cycle0_.address = interrupt_cycle1_.address = &address_;
+			interrupt_cycle0_.value = interrupt_cycle1_.value = &vector;
+
+			perform(interrupt_cycle0_, true);
+			perform(interrupt_cycle1_, true);
+
+			if(vpa_) return -1;
+			if(berr_) return InstructionSet::M68k::Exception::SpuriousInterrupt;
+			return vector.b;
+		}
+};
+
+}
@@ -12,6 +12,7 @@
 #include <cmath>
 #include <iomanip>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <type_traits>
 
@@ -237,33 +238,283 @@ std::string Reflection::Struct::description() const {
 	return stream.str();
 }
 
+// MARK: - BSON
+
+namespace {
+
+template <typename IntT> void push_int(std::vector<uint8_t> &result, IntT x) {
+	for(size_t c = 0; c < sizeof(x); ++c)
+		result.push_back(uint8_t((x) >> (8 * c)));
+}
+
+void push_name(std::vector<uint8_t> &result, const std::string &name) {
+	std::copy(name.begin(), name.end(), std::back_inserter(result));
+	result.push_back(0);
+}
+
+/// Appends the name of element @c index of a BSON array, i.e. its decimal representation.
+void push_index(std::vector<uint8_t> &result, size_t index) {
+	char digits[20];
+	size_t length = 0;
+	do {
+		digits[length++] = char('0' + index % 10);
+		index /= 10;
+	} while(index);
+
+	while(length--) {
+		result.push_back(uint8_t(digits[length]));
+	}
+	result.push_back(0);
+}
+
+/// @returns The number of bytes @c push_index will append for @c index.
+size_t index_size(size_t index) {
+	size_t size = 2;
+	while(index >= 10) {
+		index /= 10;
+		++size;
+	}
+	return size;
+}
+
+void push_string(std::vector<uint8_t> &result, const std::string &text) {
+	const uint32_t string_length = uint32_t(text.size() + 1);
+	push_int(result, string_length);
+	std::copy(text.begin(), text.end(), std::back_inserter(result));
+	result.push_back(0);
+}
+
+void push_binary(std::vector<uint8_t> &result, const std::vector<uint8_t> &data) {
+	push_int(result, uint32_t(data.size()));
+	result.push_back(0x00);
+	std::copy(data.begin(), data.end(), std::back_inserter(result));
+}
+
+void push_double(std::vector<uint8_t> &result, double float64) {
+	// The following declines to assume an internal representation
+	// for doubles, constructing IEEE 708 from first principles.
+	// Which is probably absurd given how often I've assumed
+	// e.g. two's complement.
+	int exponent;
+	const double mantissa = frexp(fabs(float64), &exponent);
+	exponent += 1022;
+	const uint64_t integer_mantissa =
+		static_cast<uint64_t>(mantissa * 9007199254740992.0);
+	const uint64_t binary64 =
+		((float64 < 0) ? 0x8000'0000'0000'0000 : 0) |
+		(integer_mantissa & 0x000f'ffff'ffff'ffff) |
+		(static_cast<uint64_t>(exponent) << 52);
+	push_int(result, binary64);
+}
+
+double to_double(uint64_t value) {
+	const double mantissa = 0.5 + double(value & 0x000f'ffff'ffff'ffff) / 9007199254740992.0;
+	const int exponent = ((value >> 52) & 2047) - 1022;
+	const double double_value = ldexp(mantissa, exponent);
+	const double sign = (value & 0x8000'0000'0000'0000) ? -1 : 1;
+	return double_value * sign;
+}
+
+/*
+	document ::= int32 e_list "\x00"
+	The int32 is the total number of bytes comprising the document; documents are therefore
+	opened with a placeholder size, which is filled in upon closing.
+*/
+size_t open_object(std::vector<uint8_t> &data) {
+	const size_t start = data.size();
+	data.resize(start + 4);
+	return start;
+}
+
+void close_object(std::vector<uint8_t> &data, size_t start) {
+	data.push_back(0);
+	const uint32_t size_with_prefix = uint32_t(data.size() - start);
+	data[start + 0] = uint8_t(size_with_prefix & 0xff);
+	data[start + 1] = uint8_t(size_with_prefix >> 8);
+	data[start + 2] = uint8_t(size_with_prefix >> 16);
+	data[start + 3] = uint8_t(size_with_prefix >> 24);
+}
+
+}
+
 /* Contractually, this serialises as BSON. */
 std::vector<uint8_t> Reflection::Struct::serialise() const {
-	auto push_name = [] (std::vector<uint8_t> &result, const std::string &name) {
-		std::copy(name.begin(), name.end(), std::back_inserter(result));
-		result.push_back(0);
+	std::vector<uint8_t> result;
+	serialise(result);
+	return result;
+}
+
+void Reflection::Struct::serialise(std::vector<uint8_t> &result) const {
+	result.clear();
+
+	// If this struct has a plan then its size can be determined exactly in advance.
+	if(const auto plan = this->plan()) {
+		result.reserve(bson_size(*plan));
+	}
+	append_bson(result);
+}
+
+Reflection::Struct::PlannedField Reflection::Struct::plan_field(const std::string &key, const std::type_info &type, ssize_t offset, size_t size, size_t count) {
+	using Kind = PlannedField::Kind;
+	PlannedField field{Kind::Unsupported, 0, key, offset, size, count, nullptr, {}};
+
+	// Classify in the same order as the by-name path tests types, which is also
+	// the order of preference in BSON types.
+	const auto classify = [&field] (Kind kind, uint8_t bson_type) {
+		field.kind = kind;
+		field.bson_type = bson_type;
 	};
+	if(type == typeid(bool))									classify(Kind::Bool, 0x08);
+	else if(!Reflection::Enum::name(type).empty()) {
+		classify(Kind::Enum, 0x02);
+		field.enum_values = &Reflection::Enum::all_values(type);
+	}
+	else if(type == typeid(int8_t))								classify(Kind::Int8, 0x10);
+	else if(type == typeid(uint8_t))							classify(Kind::UInt8, 0x10);
+	else if(type == typeid(int16_t))							classify(Kind::Int16, 0x10);
+	else if(type == typeid(uint16_t))							classify(Kind::UInt16, 0x10);
+	else if(type == typeid(int32_t))							classify(Kind::Int32, 0x10);
+	else if(type == typeid(uint32_t))							classify(Kind::UInt32, 0x12);
+	else if(type == typeid(int64_t))							classify(Kind::Int64, 0x12);
+	else if(type == typeid(uint64_t))							classify(Kind::UInt64, 0);	// Can be deserialised, but not serialised.
+	else if(type == typeid(float))								classify(Kind::Float, 0x01);
+	else if(type == typeid(double))								classify(Kind::Double, 0x01);
+	else if(type == typeid(std::string))						classify(Kind::String, 0x02);
+	else if(type == typeid(std::vector<uint8_t>))				classify(Kind::Binary, 0x05);
+	else if(type == typeid(Reflection::Struct))					classify(Kind::Struct, 0x03);
+
+	if(field.bson_type) {
+		field.encoded_name.push_back(count > 1 ? 0x04 : field.bson_type);
+		push_name(field.encoded_name, key);
+	}
+	return field;
+}
 
-	auto append = [push_name, this] (std::vector<uint8_t> &result, const std::string &key, const std::string &output_name, const std::type_info *type, size_t offset) {
-		auto push_int = [&result] (auto x) {
-			for(size_t c = 0; c < sizeof(x); ++c)
-				result.push_back(uint8_t((x) >> (8 * c)));
-		};
+size_t Reflection::Struct::bson_size(const Plan &plan) const {
+	using Kind = PlannedField::Kind;
+	const auto base = reinterpret_cast<const uint8_t *>(this);
+
+	const auto value_size = [] (const PlannedField &field, const uint8_t *address) -> size_t {
+		switch(field.kind) {
+			case Kind::Bool:	return 1;
+			case Kind::Int8:	case Kind::UInt8:
+			case Kind::Int16:	case Kind::UInt16:
+			case Kind::Int32:	return 4;
+			case Kind::UInt32:	case Kind::Int64:
+			case Kind::Float:	case Kind::Double:	return 8;
+
+			case Kind::Enum:
+				return 5 + (*field.enum_values)[size_t(*reinterpret_cast<const int *>(address))].size();
+			case Kind::String:
+				return 5 + reinterpret_cast<const std::string *>(address)->size();
+			case Kind::Binary:
+				return 5 + reinterpret_cast<const std::vector<uint8_t> *>(address)->size();
+			case Kind::Struct: {
+				const auto child = reinterpret_cast<const Reflection::Struct *>(address);
+				const auto child_plan = child->plan();
+				return child_plan ? child->bson_size(*child_plan) : 0;
+			}
+
+			default:	return 0;
+		}
+	};
+
+	size_t size = 5;
+	for(const auto &field: plan) {
+		if(field.encoded_name.empty() || !should_serialise(field.key)) continue;
+		size += field.encoded_name.size();
+
+		const uint8_t *address = base + field.offset;
+		if(field.count > 1) {
+			size += 5;
+			for(size_t c = 0; c < field.count; ++c) {
+				size += 1 + index_size(c) + value_size(field, address);
+				address += field.size;
+			}
+		} else {
+			size += value_size(field, address);
+		}
+	}
+	return size;
+}
 
-		auto push_named_int = [push_int, push_name, &result, &output_name] (uint8_t type, auto x) {
+void Reflection::Struct::append_bson(std::vector<uint8_t> &result, const Plan &plan) const {
+	using Kind = PlannedField::Kind;
+	const auto base = reinterpret_cast<const uint8_t *>(this);
+
+	const auto append = [&result] (const PlannedField &field, const uint8_t *address) {
+		switch(field.kind) {
+			case Kind::Bool:	result.push_back(uint8_t(*reinterpret_cast<const bool *>(address)));		break;
+			case Kind::Int8:	push_int(result, int32_t(*reinterpret_cast<const int8_t *>(address)));		break;
+			case Kind::UInt8:	push_int(result, int32_t(*reinterpret_cast<const uint8_t *>(address)));		break;
+			case Kind::Int16:	push_int(result, int32_t(*reinterpret_cast<const int16_t *>(address)));		break;
+			case Kind::UInt16:	push_int(result, int32_t(*reinterpret_cast<const uint16_t *>(address)));	break;
+			case Kind::Int32:	push_int(result, *reinterpret_cast<const int32_t *>(address));				break;
+			case Kind::UInt32:	push_int(result, int64_t(*reinterpret_cast<const uint32_t *>(address)));	break;
+			case Kind::Int64:	push_int(result, *reinterpret_cast<const int64_t *>(address));				break;
+			case Kind::Float:	push_double(result, double(*reinterpret_cast<const float *>(address)));		break;
+			case Kind::Double:	push_double(result, *reinterpret_cast<const double *>(address));			break;
+
+			case Kind::Enum:
+				push_string(result, (*field.enum_values)[size_t(*reinterpret_cast<const int *>(address))]);
+			break;
+			case Kind::String:
+				push_string(result, *reinterpret_cast<const std::string *>(address));
+			break;
+			case Kind::Binary:
+				push_binary(result, *reinterpret_cast<const std::vector<uint8_t> *>(address));
+			break;
+			case Kind::Struct:
+				reinterpret_cast<const Reflection::Struct *>(address)->append_bson(result);
+			break;
+
+			default:	break;
+		}
+	};
+
+	const size_t document = open_object(result);
+
+	for(const auto &field: plan) {
+		if(field.encoded_name.empty() || !should_serialise(field.key)) continue;
+		std::copy(field.encoded_name.begin(), field.encoded_name.end(), std::back_inserter(result));
+
+		const uint8_t *address = base + field.offset;
+		if(field.count > 1) {
+			// In BSON, an array is a sub-document with ASCII keys '0', '1', etc.
+			const size_t array = open_object(result);
+			for(size_t c = 0; c < field.count; ++c) {
+				result.push_back(field.bson_type);
+				push_index(result, c);
+				append(field, address);
+				address += field.size;
+			}
+			close_object(result, array);
+		} else {
+			append(field, address);
+		}
+	}
+
+	close_object(result, document);
+}
+
+void Reflection::Struct::append_bson(std::vector<uint8_t> &result) const {
+	if(const auto plan = this->plan()) {
+		append_bson(result, *plan);
+		return;
+	}
+
+	// Without a plan, locate and convert each field by name.
+	auto append = [this] (std::vector<uint8_t> &result, const std::string &key, const std::string &output_name, const std::type_info *type, size_t offset) {
+		auto push_named_int = [&result, &output_name] (uint8_t type, auto x) {
 			result.push_back(type);
 			push_name(result, output_name);
-			push_int(x);
+			push_int(result, x);
 		};
 
-		auto push_string = [push_int, push_name, &result, &output_name] (const std::string &text) {
+		auto push_named_string = [&result, &output_name] (const std::string &text) {
 			result.push_back(0x02);
 			push_name(result, output_name);
-
-			const uint32_t string_length = uint32_t(text.size() + 1);
-			push_int(string_length);
-			std::copy(text.begin(), text.end(), std::back_inserter(result));
-			result.push_back(0);
+			push_string(result, text);
 		};
 
 		// Test for an exact match on Booleans.
@@ -278,8 +529,8 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		if(!Reflection::Enum::name(*type).empty()) {
 			int value;
 			Reflection::get(*this, key, value, offset);
-			const auto text = Reflection::Enum::to_string(*type, 0);
-			push_string(text);
+			const auto text = Reflection::Enum::to_string(*type, value);
+			push_named_string(text);
 			return;
 		}
 
@@ -302,22 +553,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		if(Reflection::get(*this, key, float64, offset)) {
 			result.push_back(0x01);
 			push_name(result, output_name);
-
-			// The following declines to assume an internal representation
-			// for doubles, constructing IEEE 708 from first principles.
-			// Which is probably absurd given how often I've assumed
-			// e.g. two's complement.
-			int exponent;
-			const double mantissa = frexp(fabs(float64), &exponent);
-			exponent += 1022;
-			const uint64_t integer_mantissa =
-				static_cast<uint64_t>(mantissa * 9007199254740992.0);
-			const uint64_t binary64 =
-				((float64 < 0) ? 0x8000'0000'0000'0000 : 0) |
-				(integer_mantissa & 0x000f'ffff'ffff'ffff) |
-				(static_cast<uint64_t>(exponent) << 52);
-			push_int(binary64);
-
+			push_double(result, float64);
 			return;
 		}
 
@@ -325,7 +561,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		if(*type == typeid(std::string)) {
 			const uint8_t *address = reinterpret_cast<const uint8_t *>(get(key));
 			const std::string *const text = reinterpret_cast<const std::string *>(address + offset*sizeof(std::string));
-			push_string(*text);
+			push_named_string(*text);
 			return;
 		}
 
@@ -333,11 +569,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		if(*type == typeid(std::vector<uint8_t>)) {
 			result.push_back(0x05);
 			push_name(result, output_name);
-
-			auto source = reinterpret_cast<const std::vector<uint8_t> *>(get(key));
-			push_int(uint32_t(source->size()));
-			result.push_back(0x00);
-			std::copy(source->begin(), source->end(), std::back_inserter(result));
+			push_binary(result, *reinterpret_cast<const std::vector<uint8_t> *>(get(key)));
 			return;
 		}
 
@@ -348,8 +580,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 			push_name(result, output_name);
 
 			const Reflection::Struct *const child = reinterpret_cast<const Reflection::Struct *>(get(key));
-			const auto sub_document = child->serialise();
-			std::copy(sub_document.begin(), sub_document.end(), std::back_inserter(result));
+			child->append_bson(result);
 			return;
 		}
 
@@ -358,20 +589,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		assert(false);
 	};
 
-	auto wrap_object = [] (std::vector<uint8_t> &data) {
-		/*
-			document ::= int32 e_list "\x00"
-			The int32 is the total number of bytes comprising the document.
-		*/
-		data.push_back(0);
-		const uint32_t size_with_prefix = uint32_t(data.size()) + 4;
-		data.insert(data.begin(), uint8_t(size_with_prefix >> 24));
-		data.insert(data.begin(), uint8_t(size_with_prefix >> 16));
-		data.insert(data.begin(), uint8_t(size_with_prefix >> 8));
-		data.insert(data.begin(), uint8_t(size_with_prefix & 0xff));
-	};
-
-	std::vector<uint8_t> result;
+	const size_t document = open_object(result);
 
 	for(const auto &key: all_keys()) {
 		if(!should_serialise(key)) continue;
@@ -385,20 +603,17 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 			result.push_back(0x04);
 			push_name(result, key);
 
-			std::vector<uint8_t> array;
+			const size_t array = open_object(result);
 			for(size_t c = 0; c < count; ++c) {
-				append(array, key, std::to_string(c), type, c);
+				append(result, key, std::to_string(c), type, c);
 			}
-			wrap_object(array);
-
-			std::copy(array.begin(), array.end(), std::back_inserter(result));
+			close_object(result, array);
 		} else {
 			append(result, key, key, type, 0);
 		}
 	}
 
-	wrap_object(result);
-	return result;
+	close_object(result, document);
 }
 
 bool Reflection::Struct::deserialise(const std::vector<uint8_t> &bson) {
@@ -444,17 +659,230 @@ struct ArrayReceiver: public Reflection::Struct {
 
 }
 
+bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size, const Plan &plan) {
+	using Kind = PlannedField::Kind;
+	const auto base = reinterpret_cast<uint8_t *>(this);
+
+	// Validate the object's declared size.
+	const auto end = bson + size;
+	auto read_int = [&bson] (auto &target) {
+		// Assemble as unsigned so that shifting doesn't sign extend.
+		uint64_t value = 0;
+		for(size_t c = 0; c < sizeof(target); ++c) {
+			value |= uint64_t(*bson) << (8 * c);
+			++bson;
+		}
+		target = std::remove_reference_t<decltype(target)>(value);
+	};
+
+	uint32_t object_size;
+	read_int(object_size);
+	if(object_size > size) return false;
+
+	// Integers are accepted by fields of any integral type, truncating as required, and by enums.
+	const auto store_int = [] (Kind kind, uint8_t *address, int64_t value) {
+		const auto store = [address] (auto value) {
+			memcpy(address, &value, sizeof(value));
+		};
+
+		switch(kind) {
+			case Kind::Enum:
+			case Kind::Int32:	store(int32_t(value));	break;
+			case Kind::Int8:	store(int8_t(value));	break;
+			case Kind::UInt8:	store(uint8_t(value));	break;
+			case Kind::Int16:	store(int16_t(value));	break;
+			case Kind::UInt16:	store(uint16_t(value));	break;
+			case Kind::UInt32:	store(uint32_t(value));	break;
+			case Kind::Int64:	store(int64_t(value));	break;
+			case Kind::UInt64:	store(uint64_t(value));	break;
+			default: break;
+		}
+	};
+
+	// Reads a value of BSON type @c type, storing it to @c address if @c field is able to accept it;
+	// @returns @c false if @c type is unrecognised.
+	const auto read_value = [&] (uint8_t type, const PlannedField *field, uint8_t *address) {
+		const Kind kind = field ? field->kind : Kind::Unsupported;
+
+		switch(type) {
+			default:
+			return false;
+
+			// A subdocument or array; only subdocuments are supported within an array.
+			case 0x03:
+			case 0x04: {
+				uint32_t subobject_size;
+				read_int(subobject_size);
+
+				if(type == 0x03 && kind == Kind::Struct) {
+					auto child = reinterpret_cast<Reflection::Struct *>(address);
+					child->deserialise(bson - 4, size_t(end - bson + 4));
+				}
+				bson += subobject_size - 4;
+			} break;
+
+			// Binary data.
+			case 0x05: {
+				uint32_t subobject_size;
+				read_int(subobject_size);
+
+				// Skip the binary subtype.
+				++bson;
+
+				if(kind == Kind::Binary) {
+					reinterpret_cast<std::vector<uint8_t> *>(address)->assign(bson, bson + subobject_size);
+				}
+				bson += subobject_size;
+			} break;
+
+			// String.
+			case 0x02: {
+				uint32_t length;
+				read_int(length);
+
+				if(kind == Kind::String) {
+					reinterpret_cast<std::string *>(address)->assign(bson, bson + length - 1);
+				}
+				if(kind == Kind::Enum) {
+					const auto &values = *field->enum_values;
+					const auto value = std::find_if(values.begin(), values.end(), [&] (const std::string &name) {
+						return name.size() == length - 1 && !memcmp(name.data(), bson, name.size());
+					});
+					if(value != values.end()) {
+						store_int(kind, address, value - values.begin());
+					}
+				}
+
+				bson += length;
+			} break;
+
+			// Boolean.
+			case 0x08: {
+				const bool value = *bson;
+				++bson;
+				if(kind == Kind::Bool) {
+					*reinterpret_cast<bool *>(address) = value;
+				}
+			} break;
+
+			// 32-bit int.
+			case 0x10: {
+				int32_t value;
+				read_int(value);
+				store_int(kind, address, value);
+			} break;
+
+			// 64-bit int.
+			case 0x12: {
+				int64_t value;
+				read_int(value);
+				store_int(kind, address, value);
+			} break;
+
+			// 64-bit double.
+			case 0x01: {
+				uint64_t value;
+				read_int(value);
+
+				if(kind == Kind::Float) {
+					*reinterpret_cast<float *>(address) = float(to_double(value));
+				}
+				if(kind == Kind::Double) {
+					*reinterpret_cast<double *>(address) = to_double(value);
+				}
+			} break;
+		}
+
+		return true;
+	};
+
+	size_t next_field = 0;
+	while(true) {
+		const uint8_t next_type = *bson;
+		++bson;
+		if(!next_type)
+			break;
+
+		const uint8_t *const name = bson;
+		while(*bson) {
+			++bson;
+		}
+		const size_t name_length = size_t(bson - name);
+		++bson;
+
+		// Fields will usually be in plan order, so check the next one before searching.
+		const auto matches = [&] (const PlannedField &field) {
+			return field.key.size() == name_length && !memcmp(field.key.data(), name, name_length);
+		};
+		const PlannedField *field = nullptr;
+		if(next_field < plan.size() && matches(plan[next_field])) {
+			field = &plan[next_field];
+		} else {
+			const auto located = std::find_if(plan.begin(), plan.end(), matches);
+			if(located != plan.end()) {
+				field = &*located;
+			}
+		}
+		if(field) {
+			next_field = size_t(field - plan.data()) + 1;
+		}
+
+		// Arrays are presented as a subobject with objects serialised in array order but given
+		// the string keys "0", "1", etc; decode each directly into its slot.
+		if(next_type == 0x04) {
+			uint32_t subobject_size;
+			read_int(subobject_size);
+			const uint8_t *const array_end = bson + subobject_size - 4;
+
+			while(true) {
+				const uint8_t element_type = *bson;
+				++bson;
+				if(!element_type)
+					break;
+
+				size_t index = 0;
+				while(*bson) {
+					index = (*bson >= '0' && *bson <= '9' && index <= 0xffff'ffff) ? index * 10 + size_t(*bson - '0') : std::numeric_limits<size_t>::max();
+					++bson;
+				}
+				++bson;
+
+				const bool is_in_range = field && index < field->count;
+				if(!read_value(
+					element_type,
+					is_in_range ? field : nullptr,
+					is_in_range ? base + field->offset + index * field->size : nullptr)
+				) break;
+			}
+
+			bson = array_end;
+			continue;
+		}
+
+		if(!read_value(next_type, field, field ? base + field->offset : nullptr)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
+	if(const auto plan = this->plan()) {
+		return deserialise(bson, size, *plan);
+	}
+
+	// Without a plan, locate and convert each field by name.
 	// Validate the object's declared size.
 	const auto end = bson + size;
 	auto read_int = [&bson] (auto &target) {
-		constexpr auto shift = 8 * (sizeof(target) - 1);
-		target = 0;
+		// Assemble as unsigned so that shifting doesn't sign extend.
+		uint64_t value = 0;
 		for(size_t c = 0; c < sizeof(target); ++c) {
-			target >>= 8;
-			target |= decltype(target)(*bson) << shift;
+			value |= uint64_t(*bson) << (8 * c);
 			++bson;
 		}
+		target = std::remove_reference_t<decltype(target)>(value);
 	};
 
 	uint32_t object_size;
@@ -487,15 +915,22 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 				uint32_t subobject_size;
 				read_int(subobject_size);
 
-				if(next_type == 0x03 && *type == typeid(Reflection::Struct)) {
-					auto child = reinterpret_cast<Reflection::Struct *>(get(key));
-					child->deserialise(bson - 4, size_t(end - bson + 4));
+				if(next_type == 0x03) {
+					if(type && *type == typeid(Reflection::Struct)) {
+						auto child = reinterpret_cast<Reflection::Struct *>(get(key));
+						child->deserialise(bson - 4, size_t(end - bson + 4));
+					}
 					bson += subobject_size - 4;
 				}
 
-				if(next_type == 0x05 && *type == typeid(std::vector<uint8_t>)) {
-					auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
-					*child = std::vector<uint8_t>(bson, bson + subobject_size);
+				if(next_type == 0x05) {
+					// Skip the binary subtype.
+					++bson;
+
+					if(type && *type == typeid(std::vector<uint8_t>)) {
+						auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
+						*child = std::vector<uint8_t>(bson, bson + subobject_size);
+					}
 					bson += subobject_size;
 				}
 			} break;
@@ -551,13 +986,7 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 			case 0x01: {
 				uint64_t value;
 				read_int(value);
-
-				const double mantissa = 0.5 + double(value & 0x000f'ffff'ffff'ffff) / 9007199254740992.0;
-				const int exponent = ((value >> 52) & 2047) - 1022;
-				const double double_value = ldexp(mantissa, exponent);
-				const double sign = (value & 0x8000'0000'0000'0000) ? -1 : 1;
-
-				::Reflection::set(*this, key, double_value * sign);
+				::Reflection::set(*this, key, to_double(value));
 			} break;
 		}
 	}
@@ -64,6 +64,12 @@ struct Struct {
 	*/
 	std::vector<uint8_t> serialise() const;
 
+	/*!
+		Serialises as per @c serialise() but into @c target, replacing its contents and reusing
+		its existing storage; intended for callers that serialise repeatedly.
+	*/
+	void serialise(std::vector<uint8_t> &target) const;
+
 	/*!
 		Applies as many fields as possible from the incoming BSON. Supports the same types
 		as @c serialise.
@@ -75,9 +81,55 @@ struct Struct {
 	*/
 	virtual bool should_serialise([[maybe_unused]] const std::string &key) const { return true; }
 
+	protected:
+		/*!
+			Describes how a single declared field is serialised: as what, where it is relative to the
+			struct and under what name. Built once per struct type by @c StructImpl.
+		*/
+		struct PlannedField {
+			enum class Kind: uint8_t {
+				Bool, Enum,
+				Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64,
+				Float, Double,
+				String, Binary, Struct,
+				Unsupported,
+			} kind;
+
+			/// The BSON element type used for each value; 0 if this field can't be serialised.
+			uint8_t bson_type;
+
+			std::string key;
+			ssize_t offset;
+			size_t size;
+			size_t count;
+
+			/// The member names of this field's type, if it is an enum.
+			const std::vector<std::string> *enum_values;
+
+			/// The BSON element type and name of this field, ready to be copied to the output.
+			std::vector<uint8_t> encoded_name;
+		};
+		using Plan = std::vector<PlannedField>;
+
+		/*!
+			@returns The plan for serialising a field of type @c type named @c key, which is @c count
+				consecutive instances of @c size bytes each, starting @c offset bytes from the struct.
+		*/
+		static PlannedField plan_field(const std::string &key, const std::type_info &type, ssize_t offset, size_t size, size_t count);
+
 	private:
+		/*!
+			@returns The plan for serialising this struct, with offsets relative to its @c Struct base, or @c nullptr
+				if fields should instead be located and converted by name.
+		*/
+		virtual const Plan *plan() const { return nullptr; }
+
 		void append(std::ostringstream &stream, const std::string &key, const std::type_info *type, size_t offset) const;
+		void append_bson(std::vector<uint8_t> &target) const;
+		void append_bson(std::vector<uint8_t> &target, const Plan &plan) const;
+		size_t bson_size(const Plan &plan) const;
 		bool deserialise(const uint8_t *bson, size_t size);
+		bool deserialise(const uint8_t *bson, size_t size, const Plan &plan);
 };
 
 /*!
@@ -234,6 +286,19 @@ template <typename Owner> class StructImpl: public Struct {
 			return keys;
 		}
 
+	private:
+		const Plan *plan() const final {
+			// Built upon first use, by which time all fields have been declared; in the same order as all_keys().
+			static const Plan plan = [] {
+				Plan plan;
+				for(const auto &pair: contents_) {
+					plan.push_back(plan_field(pair.first, *pair.second.type, pair.second.offset, pair.second.size, pair.second.count));
+				}
+				return plan;
+			}();
+			return &plan;
+		}
+
 	protected:
 		/*
 			This interface requires reflective structs to declare all fields;
@@ -377,7 +442,7 @@ template <typename Type> bool get(const Struct &target, const std::string &name,
 	// If the type is a registered enum and the value type is int, copy.
 	if constexpr (std::is_integral<Type>::value && sizeof(Type) == sizeof(int)) {
 		if(!Enum::name(*target_type).empty()) {
-			memcpy(&value, target.get(name), sizeof(int));
+			memcpy(&value, reinterpret_cast<const uint8_t *>(target.get(name)) + offset * sizeof(int), sizeof(int));
 			return true;
 		}
 	}
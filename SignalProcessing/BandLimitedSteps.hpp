@@ -0,0 +1,204 @@
+//
+//  BandLimitedSteps.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "FIRFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace SignalProcessing {
+
+/*!
+	Produces band-limited output at a fixed sample rate from a signal described only as a series of
+	instantaneous changes in level, each of which may fall at any point in time.
+
+	Output is that of applying a given low-pass FIR filter to the input at its original rate, and then
+	sampling at the output rate. Each step is therefore added to a buffer of pending output as the
+	difference between successive output samples of that filter's step response, positioned to the
+	nearest 1/Phases of an output sample; output is the running sum of that buffer. Every phase of the
+	kernel sums to exactly unity in fixed point, so output always settles at exactly the sum of all steps so far.
+
+	Output lags input by half the length of the filter.
+*/
+template <int channels> class BandLimitedSteps {
+	static_assert(channels == 1 || channels == 2);
+
+	public:
+		/*!
+			Sets the sample rate of input, which is the unit of time for step offsets, and of output, and
+			describes the filter to apply: @c input_taps taps at the input rate, retaining frequencies up to @c cutoff.
+			Any steps already added are unaffected.
+		*/
+		void set_rates(float input_rate, float output_rate, float cutoff, std::size_t input_taps) {
+			const double input_samples_per_output = double(input_rate) / double(output_rate);
+			step_ = uint64_t(double(OneSample) / input_samples_per_output);
+
+			// Obtain the step response of the prototype filter; step_response[n] is the output n input samples
+			// after a unit step.
+			const auto prototype = FIRFilter::coefficients(
+				input_taps,
+				input_rate,
+				0.0f,
+				cutoff,
+				FIRFilter::DefaultAttenuation);
+			std::vector<double> step_response(prototype.size() + 1);
+			double total = 0.0;
+			for(std::size_t c = 0; c < prototype.size(); c++) {
+				total += double(prototype[c]);
+				step_response[c] = total;
+			}
+			for(auto &value: step_response) {
+				value /= total;
+			}
+			step_response.back() = 1.0;
+
+			// Interpolate linearly for any time between input samples.
+			const auto response = [&](double time) {
+				if(time < 0.0) return 0.0;
+				const auto index = std::size_t(time);
+				if(index + 1 >= step_response.size()) return 1.0;
+				const double fraction = time - double(index);
+				return step_response[index] * (1.0 - fraction) + step_response[index + 1] * fraction;
+			};
+
+			// Sample the step response at the output rate for each phase, and keep only the differences.
+			taps_ = std::min(
+				MaximumTaps,
+				std::size_t(std::ceil(double(prototype.size()) / input_samples_per_output)) + 2
+			);
+			kernels_.resize(Phases * taps_);
+			for(std::size_t phase = 0; phase < Phases; phase++) {
+				int32_t *const kernel = &kernels_[phase * taps_];
+				const double offset = double(phase) / double(Phases);
+				int32_t total = 0;
+				std::size_t peak = 0;
+				for(std::size_t tap = 0; tap < taps_; tap++) {
+					const double time = (double(tap) - offset) * input_samples_per_output;
+					kernel[tap] = int32_t(std::round(
+						(response(time) - response(time - input_samples_per_output)) * double(Unity)
+					));
+					total += kernel[tap];
+					if(std::abs(kernel[tap]) > std::abs(kernel[peak])) peak = tap;
+				}
+				kernel[peak] += Unity - total;
+			}
+
+			// Never shrink the buffer, as that might lose pending output.
+			const std::size_t size = (Capacity + taps_) * channels;
+			if(buffer_.size() < size) {
+				buffer_.resize(size, 0);
+			}
+		}
+
+		/// Adds a change in level of @c delta to every channel, @c offset input samples after the current position.
+		void add_step(std::size_t offset, int16_t delta) {
+			if(!delta) return;
+
+			const auto [output, kernel] = locate(offset);
+			for(std::size_t tap = 0; tap < taps_; tap++) {
+				const int32_t value = kernel[tap] * delta;
+				for(int channel = 0; channel < channels; channel++) {
+					output[tap * channels + channel] += value;
+				}
+			}
+		}
+
+		/// Adds changes in level of @c left and @c right, @c offset input samples after the current position.
+		void add_step(std::size_t offset, int16_t left, int16_t right) {
+			static_assert(channels == 2);
+			if(!left && !right) return;
+
+			const auto [output, kernel] = locate(offset);
+			for(std::size_t tap = 0; tap < taps_; tap++) {
+				output[tap * 2 + 0] += kernel[tap] * left;
+				output[tap * 2 + 1] += kernel[tap] * right;
+			}
+		}
+
+		/// Advances the current position by @c count input samples.
+		void advance(std::size_t count) {
+			position_ += count * step_;
+		}
+
+		/// @returns The largest number of input samples by which it is safe to @c advance before calling @c read.
+		std::size_t maximum_advance() const {
+			return std::size_t(((uint64_t(Capacity) << FractionalBits) - position_) / step_);
+		}
+
+		/// @returns The number of output samples that can now be read; no subsequent step can affect them.
+		std::size_t available() const {
+			return std::size_t(position_ >> FractionalBits);
+		}
+
+		/*!
+			Writes @c count samples — at most @c available() — to @c target, interleaving channels if there are two.
+			If @c target is @c nullptr then the samples are discarded.
+		*/
+		void read(int16_t *target, std::size_t count) {
+			for(std::size_t sample = 0; sample < count; sample++) {
+				for(int channel = 0; channel < channels; channel++) {
+					integral_[channel] += buffer_[sample * channels + channel];
+					if(target) {
+						target[sample * channels + channel] =
+							int16_t(std::clamp((integral_[channel] + Unity / 2) >> Precision, -32768, 32767));
+					}
+				}
+			}
+
+			const std::size_t consumed = count * channels;
+			std::memmove(buffer_.data(), &buffer_[consumed], (buffer_.size() - consumed) * sizeof(int32_t));
+			std::fill(buffer_.end() - ptrdiff_t(consumed), buffer_.end(), 0);
+			position_ -= uint64_t(count) << FractionalBits;
+		}
+
+	private:
+		static constexpr int FractionalBits = 32;
+		static constexpr uint64_t OneSample = uint64_t(1) << FractionalBits;
+
+		static constexpr int PhaseBits = 8;
+		static constexpr std::size_t Phases = 1 << PhaseBits;
+
+		// Kernels are signed fixed point with this many fractional bits. Each source's levels already
+		// fit within 16 bits so a pending sample can't overflow.
+		static constexpr int Precision = 15;
+		static constexpr int32_t Unity = 1 << Precision;
+
+		static constexpr std::size_t MaximumTaps = 256;
+
+		// The number of output samples that may be pending; this is also the limit on a single advance.
+		static constexpr std::size_t Capacity = 256;
+
+		std::size_t taps_ = 0;
+		std::vector<int32_t> kernels_;
+
+		// Pending output, with channels interleaved; the first entry is the next to be output.
+		std::vector<int32_t> buffer_;
+		int32_t integral_[channels]{};
+
+		// Current position and the length of an input sample, both in output samples.
+		uint64_t position_ = 0;
+		uint64_t step_ = OneSample;
+
+		/// @returns The first pending output sample affected by a step @c offset input samples from now, and the kernel to apply.
+		std::pair<int32_t *, const int32_t *> locate(std::size_t offset) {
+			const uint64_t position = position_ + offset * step_;
+			const std::size_t phase = std::size_t(position >> (FractionalBits - PhaseBits)) & (Phases - 1);
+			return std::make_pair(
+				&buffer_[std::size_t(position >> FractionalBits) * channels],
+				&kernels_[phase * taps_]
+			);
+		}
+};
+
+}
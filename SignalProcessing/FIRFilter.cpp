@@ -10,12 +10,115 @@
 
 #include <cmath>
 
+#ifndef USE_ACCELERATE
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define USE_SSE2
+#if defined(__GNUC__)
+#define USE_AVX2
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define USE_NEON
+#endif
+#endif
+
 #ifndef M_PI
 static constexpr float M_PI = 3.1415926f;
 #endif
 
 using namespace SignalProcessing;
 
+#ifndef USE_ACCELERATE
+
+// MARK: - Dot products.
+
+namespace {
+
+using DotProduct = int (*)(const short *, const short *, std::size_t);
+
+int scalar_dot_product(const short *coefficients, const short *src, std::size_t length) {
+	int result = 0;
+	for(std::size_t c = 0; c < length; ++c) {
+		result += coefficients[c] * src[c];
+	}
+	return result;
+}
+
+#ifdef USE_SSE2
+int sse2_dot_product(const short *coefficients, const short *src, std::size_t length) {
+	__m128i sum = _mm_setzero_si128();
+	std::size_t c = 0;
+	for(; c + 8 <= length; c += 8) {
+		const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&coefficients[c]));
+		const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[c]));
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(lhs, rhs));
+	}
+
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum) + scalar_dot_product(&coefficients[c], &src[c], length - c);
+}
+#endif
+
+#ifdef USE_AVX2
+__attribute__((target("avx2")))
+int avx2_dot_product(const short *coefficients, const short *src, std::size_t length) {
+	__m256i sum = _mm256_setzero_si256();
+	std::size_t c = 0;
+	for(; c + 16 <= length; c += 16) {
+		const __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&coefficients[c]));
+		const __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[c]));
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(lhs, rhs));
+	}
+
+	__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(half) + sse2_dot_product(&coefficients[c], &src[c], length - c);
+}
+#endif
+
+#ifdef USE_NEON
+int neon_dot_product(const short *coefficients, const short *src, std::size_t length) {
+	int32x4_t sum = vdupq_n_s32(0);
+	std::size_t c = 0;
+	for(; c + 8 <= length; c += 8) {
+		const int16x8_t lhs = vld1q_s16(&coefficients[c]);
+		const int16x8_t rhs = vld1q_s16(&src[c]);
+		sum = vmlal_s16(sum, vget_low_s16(lhs), vget_low_s16(rhs));
+		sum = vmlal_s16(sum, vget_high_s16(lhs), vget_high_s16(rhs));
+	}
+
+	const int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(pair, pair), 0) + scalar_dot_product(&coefficients[c], &src[c], length - c);
+}
+#endif
+
+DotProduct best_dot_product() {
+#ifdef USE_AVX2
+	if(__builtin_cpu_supports("avx2")) {
+		return avx2_dot_product;
+	}
+#endif
+#if defined(USE_SSE2)
+	return sse2_dot_product;
+#elif defined(USE_NEON)
+	return neon_dot_product;
+#else
+	return scalar_dot_product;
+#endif
+}
+
+}
+
+int FIRFilter::dot_product(const short *coefficients, const short *src, std::size_t length) {
+	static const DotProduct implementation = best_dot_product();
+	return implementation(coefficients, src, length);
+}
+
+#endif
+
 /*
 
 	A Kaiser-Bessel filter is a real time window filter. It looks at the last n samples
@@ -51,7 +154,7 @@ float FIRFilter::ino(float a) {
 	return s;
 }
 
-void FIRFilter::coefficients_for_idealised_filter_response(short *filter_coefficients, float *A, float attenuation, std::size_t number_of_taps) {
+std::vector<float> FIRFilter::coefficients_for_idealised_filter_response(float *A, float attenuation, std::size_t number_of_taps) {
 	/* calculate alpha, which is the Kaiser-Bessel window shape factor */
 	float a;	// to take the place of alpha in the normal derivation
 
@@ -88,11 +191,12 @@ void FIRFilter::coefficients_for_idealised_filter_response(short *filter_coeffic
 		coefficientTotal += filter_coefficients_float[i];
 	}
 
-	/* we'll also need integer versions, potentially */
 	float coefficientMultiplier = 1.0f / coefficientTotal;
 	for(std::size_t i = 0; i < number_of_taps; ++i) {
-		filter_coefficients[i] = short(filter_coefficients_float[i] * FixedMultiplier * coefficientMultiplier);
+		filter_coefficients_float[i] *= coefficientMultiplier;
 	}
+
+	return filter_coefficients_float;
 }
 
 std::vector<float> FIRFilter::get_coefficients() const {
@@ -103,7 +207,10 @@ std::vector<float> FIRFilter::get_coefficients() const {
 	return coefficients;
 }
 
-FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation) {
+FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation) :
+	FIRFilter(coefficients(number_of_taps, input_sample_rate, low_frequency, high_frequency, attenuation)) {}
+
+std::vector<float> FIRFilter::coefficients(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation) {
 	// we must be asked to filter based on an odd number of
 	// taps, and at least three
 	if(number_of_taps < 3) number_of_taps = 3;
@@ -112,9 +219,6 @@ FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float
 	// ensure we have an odd number of taps
 	number_of_taps |= 1;
 
-	// store instance variables
-	filter_coefficients_.resize(number_of_taps);
-
 	/* calculate idealised filter response */
 	std::size_t Np = (number_of_taps - 1) / 2;
 	float two_over_sample_rate = 2.0f / input_sample_rate;
@@ -133,7 +237,7 @@ FIRFilter::FIRFilter(std::size_t number_of_taps, float input_sample_rate, float
 			) / i_pi;
 	}
 
-	FIRFilter::coefficients_for_idealised_filter_response(filter_coefficients_.data(), A.data(), attenuation, number_of_taps);
+	return FIRFilter::coefficients_for_idealised_filter_response(A.data(), attenuation, number_of_taps);
 }
 
 FIRFilter::FIRFilter(const std::vector<float> &coefficients) {
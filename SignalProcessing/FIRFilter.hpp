@@ -47,6 +47,12 @@ class FIRFilter {
 		FIRFilter(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation = DefaultAttenuation);
 		FIRFilter(const std::vector<float> &coefficients);
 
+		/*!
+			@returns The coefficients that an @c FIRFilter constructed with the same parameters would use, in floating point
+				and normalised so as to sum to 1.
+		*/
+		static std::vector<float> coefficients(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation = DefaultAttenuation);
+
 		/*!
 			Applies the filter to one batch of input samples, returning the net result.
 
@@ -59,6 +65,10 @@ class FIRFilter {
 				vDSP_dotpr_s1_15(filter_coefficients_.data(), 1, src, vDSP_Stride(stride), &result, filter_coefficients_.size());
 				return result;
 			#else
+				if(stride == 1) {
+					return short(dot_product(filter_coefficients_.data(), src, filter_coefficients_.size()) >> FixedShift);
+				}
+
 				int outputValue = 0;
 				for(std::size_t c = 0; c < filter_coefficients_.size(); ++c) {
 					outputValue += filter_coefficients_[c] * src[c * stride];
@@ -95,7 +105,15 @@ class FIRFilter {
 	private:
 		std::vector<short> filter_coefficients_;
 
-		static void coefficients_for_idealised_filter_response(short *filterCoefficients, float *A, float attenuation, std::size_t numberOfTaps);
+		static std::vector<float> coefficients_for_idealised_filter_response(float *A, float attenuation, std::size_t numberOfTaps);
+
+#ifndef USE_ACCELERATE
+		/*!
+			@returns The sum of the products of @c length pairs of elements from @c coefficients and @c src,
+			using whichever vector unit the host offers.
+		*/
+		static int dot_product(const short *coefficients, const short *src, std::size_t length);
+#endif
 		static float ino(float a);
 };
 
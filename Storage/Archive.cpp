@@ -0,0 +1,383 @@
+//
+//  Archive.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Archive.hpp"
+
+#include "ByteView.hpp"
+#include "FileHolder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+
+#include <zlib.h>
+
+using namespace Storage;
+
+namespace {
+
+using Contents = std::shared_ptr<const std::vector<uint8_t>>;
+
+uint16_t get16le(const uint8_t *data) {
+	return uint16_t(data[0] | (data[1] << 8));
+}
+
+uint32_t get32le(const uint8_t *data) {
+	return uint32_t(data[0] | (data[1] << 8) | (data[2] << 16) | (uint32_t(data[3]) << 24));
+}
+
+uint32_t crc32_of(ByteView data) {
+	return uint32_t(crc32(crc32(0, nullptr, 0), data.data, uInt(data.size)));
+}
+
+/*!
+	Identifies decompressed contents by the CRC and size either of those contents or, if @c is_archive is @c true,
+	of the entire archive from which they were produced.
+*/
+struct Key {
+	uint32_t crc, size;
+	bool is_archive;
+
+	bool operator <(const Key &rhs) const {
+		return std::tie(crc, size, is_archive) < std::tie(rhs.crc, rhs.size, rhs.is_archive);
+	}
+};
+
+/*!
+	A process-wide store of recently-decompressed files, holding up to @c Capacity bytes in total
+	and discarding the oldest entries when full.
+*/
+class ContentsCache {
+	public:
+		Contents find(const Key &key) {
+			std::lock_guard lock(mutex_);
+			const auto entry = entries_.find(key);
+			return entry != entries_.end() ? entry->second : nullptr;
+		}
+
+		void insert(const Key &key, const Contents &contents) {
+			if(contents->size() > Capacity) return;
+
+			std::lock_guard lock(mutex_);
+			if(!entries_.emplace(key, contents).second) return;
+
+			order_.push_back(key);
+			total_size_ += contents->size();
+			while(total_size_ > Capacity) {
+				total_size_ -= entries_[order_.front()]->size();
+				entries_.erase(order_.front());
+				order_.pop_front();
+			}
+		}
+
+	private:
+		static constexpr size_t Capacity = 64 * 1024 * 1024;
+
+		std::mutex mutex_;
+		std::map<Key, Contents> entries_;
+		std::deque<Key> order_;
+		size_t total_size_ = 0;
+};
+
+ContentsCache &cache() {
+	static ContentsCache cache;
+	return cache;
+}
+
+/*!
+	Inflates the raw deflate stream at the start of @c source.
+
+	@c expected_size is as declared by the archive, so is untrusted; if it is non-zero then any stream that
+	inflates to more than @c expected_size bytes is rejected.
+
+	@returns The inflated data, or @c nullptr if the stream is incomplete or corrupt. If @c consumed is supplied then
+		the number of bytes of @c source occupied by the stream is stored to it.
+*/
+std::shared_ptr<std::vector<uint8_t>> decompress(ByteView source, size_t expected_size, size_t *consumed = nullptr) {
+	// Deflate can't expand data by more than a factor of 1032, so don't preallocate beyond that.
+	constexpr size_t MaximumRatio = 1032;
+	const size_t initial_size = std::min(expected_size, source.size * MaximumRatio);
+	auto result = std::make_shared<std::vector<uint8_t>>(std::max(initial_size, size_t(1)));
+
+	z_stream stream{};
+	if(inflateInit2(&stream, -MAX_WBITS) != Z_OK) return nullptr;
+	stream.next_in = const_cast<Bytef *>(source.data);
+	stream.avail_in = uInt(source.size);
+
+	size_t output_size = 0;
+	int status;
+	while(true) {
+		if(output_size == result->size()) {
+			size_t new_size = result->size() * 2;
+			if(expected_size) {
+				// Allow a single byte of overflow, to distinguish a stream that is merely awaiting its end.
+				if(output_size > expected_size) {
+					status = Z_DATA_ERROR;
+					break;
+				}
+				new_size = std::min(new_size, expected_size + 1);
+			}
+			result->resize(new_size);
+		}
+		stream.next_out = result->data() + output_size;
+		stream.avail_out = uInt(result->size() - output_size);
+
+		status = inflate(&stream, Z_NO_FLUSH);
+		output_size = result->size() - stream.avail_out;
+
+		if(status == Z_STREAM_END) break;
+		if(status != Z_OK && status != Z_BUF_ERROR) break;
+		if(status == Z_BUF_ERROR && !stream.avail_in) break;
+	}
+	inflateEnd(&stream);
+
+	if(status != Z_STREAM_END) return nullptr;
+	if(consumed) *consumed = source.size - stream.avail_in;
+	result->resize(output_size);
+	return result;
+}
+
+/// Appends to @c files all files within the zip archive @c archive.
+void expand_zip(ByteView archive, std::vector<std::pair<std::string, Contents>> &files) {
+	// Locate the end of central directory record; it is the final thing in the file other than
+	// a comment of up to 65535 bytes.
+	constexpr size_t EndRecordSize = 22;
+	if(archive.size < EndRecordSize) return;
+	const uint8_t *end_record = nullptr;
+	const size_t earliest = archive.size > EndRecordSize + 65535 ? archive.size - EndRecordSize - 65535 : 0;
+	for(size_t offset = archive.size - EndRecordSize + 1; offset-- > earliest;) {
+		if(get32le(&archive.data[offset]) == 0x0605'4b50) {
+			end_record = &archive.data[offset];
+			break;
+		}
+	}
+	if(!end_record) return;
+
+	// Walk the central directory.
+	auto entries = get16le(&end_record[10]);
+	size_t pointer = get32le(&end_record[16]);
+	while(entries--) {
+		constexpr size_t HeaderSize = 46;
+		if(pointer + HeaderSize > archive.size) return;
+		const uint8_t *const header = &archive.data[pointer];
+		if(get32le(header) != 0x0201'4b50) return;
+
+		const uint16_t flags = get16le(&header[8]);
+		const uint16_t method = get16le(&header[10]);
+		const uint32_t crc = get32le(&header[16]);
+		const uint32_t compressed_size = get32le(&header[20]);
+		const uint32_t size = get32le(&header[24]);
+		const uint16_t name_length = get16le(&header[28]);
+		const size_t local_header_offset = get32le(&header[42]);
+		pointer += HeaderSize + name_length + get16le(&header[30]) + get16le(&header[32]);
+		if(pointer > archive.size) return;
+
+		const std::string name(reinterpret_cast<const char *>(&header[HeaderSize]), name_length);
+
+		// Skip directories, encrypted files, ZIP64 files and anything compressed other than by deflate.
+		if(name.empty() || name.back() == '/') continue;
+		if(flags & 1) continue;
+		if(method != 0 && method != 8) continue;
+		if(size == 0xffff'ffff || compressed_size == 0xffff'ffff) continue;
+
+		auto contents = cache().find(Key{crc, size, false});
+		if(!contents) {
+			// Find the data via its local header, which may have a different amount of extra data.
+			constexpr size_t LocalHeaderSize = 30;
+			if(local_header_offset + LocalHeaderSize > archive.size) continue;
+			const uint8_t *const local_header = &archive.data[local_header_offset];
+			if(get32le(local_header) != 0x0403'4b50) continue;
+
+			const size_t data_offset =
+				local_header_offset + LocalHeaderSize + get16le(&local_header[26]) + get16le(&local_header[28]);
+			if(data_offset + compressed_size > archive.size) continue;
+			const ByteView data(&archive.data[data_offset], compressed_size);
+
+			std::shared_ptr<std::vector<uint8_t>> decompressed;
+			if(method == 0) {
+				decompressed = std::make_shared<std::vector<uint8_t>>(data.begin(), data.end());
+			} else {
+				decompressed = decompress(data, size);
+			}
+			if(!decompressed || decompressed->size() != size || crc32_of(*decompressed) != crc) continue;
+
+			contents = decompressed;
+			cache().insert(Key{crc, size, false}, contents);
+		}
+
+		files.emplace_back(name, contents);
+	}
+}
+
+/*!
+	Parses the header of the gzip member that begins at @c offset within @c archive, storing to @c name
+	the file name it records, if any.
+
+	@returns The offset of the member's compressed data, or @c 0 if there is no member at @c offset.
+*/
+size_t gzip_member(ByteView archive, size_t offset, std::string &name) {
+	constexpr size_t HeaderSize = 10;
+	constexpr size_t TrailerSize = 8;
+	if(offset + HeaderSize + TrailerSize > archive.size) return 0;
+
+	const uint8_t *const header = &archive.data[offset];
+	if(header[0] != 0x1f || header[1] != 0x8b || header[2] != 8) return 0;
+
+	const uint8_t flags = header[3];
+	size_t pointer = offset + HeaderSize;
+	if(flags & 0x04) {	// FEXTRA.
+		if(pointer + 2 > archive.size) return 0;
+		pointer += 2 + get16le(&archive.data[pointer]);
+	}
+	if(flags & 0x08) {	// FNAME.
+		name.clear();
+		while(pointer < archive.size && archive.data[pointer]) {
+			name.push_back(char(archive.data[pointer]));
+			++pointer;
+		}
+		++pointer;
+	}
+	if(flags & 0x10) {	// FCOMMENT.
+		while(pointer < archive.size && archive.data[pointer]) {
+			++pointer;
+		}
+		++pointer;
+	}
+	if(flags & 0x02) {	// FHCRC.
+		pointer += 2;
+	}
+
+	return pointer < archive.size ? pointer : 0;
+}
+
+/*!
+	Appends to @c files the single file within the gzip archive @c archive, which is named @c archive_name.
+
+	The file is the concatenation of the contents of each of the archive's members; anything following
+	the final member, such as padding, is ignored.
+*/
+void expand_gzip(ByteView archive, const std::string &archive_name, std::vector<std::pair<std::string, Contents>> &files) {
+	// Use the original file name if one was recorded.
+	std::string name;
+	size_t pointer = gzip_member(archive, 0, name);
+	if(!pointer) return;
+
+	const auto separator = name.find_last_of("/\\");
+	if(separator != std::string::npos) {
+		name.erase(0, separator + 1);
+	}
+
+	// Otherwise derive one from the archive's.
+	if(name.empty()) {
+		name = archive_name.substr(archive_name.find_last_of("/\\") + 1);
+
+		const auto final_dot = name.find_last_of('.');
+		std::string extension = name.substr(final_dot + 1);
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		name.erase(final_dot);
+		if(extension == "adz") {
+			name += ".adf";
+		}
+	}
+
+	// Members record the CRCs of their contents only at their ends, so cache by the CRC of the whole archive.
+	const Key key{crc32_of(archive), uint32_t(archive.size), true};
+	Contents contents = cache().find(key);
+	if(!contents) {
+		auto decompressed = std::make_shared<std::vector<uint8_t>>();
+		std::string member_name;
+		while(pointer) {
+			size_t consumed;
+			const auto member = decompress(ByteView(&archive.data[pointer], archive.size - pointer), 0, &consumed);
+			if(!member) return;
+
+			// Check the member's contents against its trailer.
+			constexpr size_t TrailerSize = 8;
+			pointer += consumed;
+			if(pointer + TrailerSize > archive.size) return;
+			const uint8_t *const trailer = &archive.data[pointer];
+			if(get32le(trailer) != crc32_of(*member) || get32le(&trailer[4]) != uint32_t(member->size())) return;
+			pointer += TrailerSize;
+
+			decompressed->insert(decompressed->end(), member->begin(), member->end());
+			pointer = gzip_member(archive, pointer, member_name);
+		}
+
+		contents = decompressed;
+		cache().insert(key, contents);
+	}
+
+	files.emplace_back(name, contents);
+}
+
+std::mutex &registrations_mutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+/// @returns A map from archive names to the names of the files registered on their behalf.
+std::map<std::string, std::vector<std::string>> &registrations() {
+	static std::map<std::string, std::vector<std::string>> registrations;
+	return registrations;
+}
+
+}
+
+std::vector<std::string> Archive::expand(const std::string &file_name) {
+	std::string extension = file_name.substr(file_name.find_last_of('.') + 1);
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	const bool is_zip = extension == "zip";
+	if(!is_zip && extension != "gz" && extension != "adz") return {};
+
+	std::vector<std::pair<std::string, Contents>> files;
+	try {
+		FileHolder file(file_name, FileHolder::FileMode::Map);
+		const ByteView archive = file.read_view(size_t(file.stats().st_size));
+		if(archive.size < 4) return {};
+
+		if(is_zip) {
+			if(get32le(archive.data) != 0x0403'4b50) return {};
+			expand_zip(archive, files);
+		} else {
+			if(archive.data[0] != 0x1f || archive.data[1] != 0x8b) return {};
+			expand_gzip(archive, file_name, files);
+		}
+	} catch(FileHolder::Error) {
+		return {};
+	} catch(std::bad_alloc) {
+		return {};
+	}
+
+	std::vector<std::string> names;
+	release(file_name);
+
+	std::lock_guard lock(registrations_mutex());
+	for(const auto &entry: files) {
+		names.push_back(file_name + "/" + entry.first);
+		FileHolder::add_in_memory_file(names.back(), entry.second);
+	}
+	registrations()[file_name] = names;
+
+	return names;
+}
+
+void Archive::release(const std::string &file_name) {
+	std::lock_guard lock(registrations_mutex());
+	const auto registered = registrations().find(file_name);
+	if(registered == registrations().end()) return;
+
+	for(const auto &name: registered->second) {
+		FileHolder::remove_in_memory_file(name);
+	}
+	registrations().erase(registered);
+}
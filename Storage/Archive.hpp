@@ -0,0 +1,46 @@
+//
+//  Archive.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Storage::Archive {
+
+/*!
+	If @c file_name is a zip or gzip archive — as indicated by an extension of .zip, .gz or .adz
+	and confirmed by its contents — decompresses each file it contains into memory and registers
+	it via @c FileHolder::add_in_memory_file, so that any @c FileHolder subsequently constructed
+	with one of the returned names will read the decompressed contents.
+
+	Names take the form [archive name]/[inner name]; a gzip archive contains a single file, named
+	either as recorded in its header or by removing the archive's extension, with .adz becoming .adf.
+
+	A gzip archive may consist of several members, whose contents are concatenated; anything that follows
+	the final member, such as padding, is ignored.
+
+	Decompressed contents are cached by CRC and size, so repeatedly opening the same archive, or
+	different archives holding the same files, decompresses each only once.
+
+	Registrations persist until a call to @c release or until this archive is next expanded. Call
+	@c release once all media has been constructed from the returned names; the decompressed contents
+	will then be retained only by the resulting media, for as long as it exists.
+
+	@returns The names of all files found, in archive order, or an empty vector if @c file_name
+		is not an archive or cannot be read.
+*/
+std::vector<std::string> expand(const std::string &file_name);
+
+/*!
+	Removes all registrations made by the most recent call to @c expand for @c file_name.
+	@c FileHolder instances already constructed are unaffected.
+*/
+void release(const std::string &file_name);
+
+}
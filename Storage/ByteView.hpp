@@ -0,0 +1,32 @@
+//
+//  ByteView.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Storage {
+
+/*!
+	A non-owning view of a contiguous run of bytes.
+*/
+struct ByteView {
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+
+	ByteView() = default;
+	ByteView(const uint8_t *data, size_t size) : data(data), size(size) {}
+	ByteView(const std::vector<uint8_t> &vector) : data(vector.data()), size(vector.size()) {}
+
+	const uint8_t *begin() const	{	return data;		}
+	const uint8_t *end() const		{	return data + size;	}
+};
+
+}
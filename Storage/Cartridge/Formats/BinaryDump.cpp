@@ -8,23 +8,19 @@
 
 #include "BinaryDump.hpp"
 
-#include <cstdio>
-#include <sys/stat.h>
+#include "../../FileHolder.hpp"
 
 using namespace Storage::Cartridge;
 
 BinaryDump::BinaryDump(const std::string &file_name) {
-	// the file should be exactly 16 kb
-	struct stat file_stats;
-	stat(file_name.c_str(), &file_stats);
-
 	// grab contents
-	FILE *file = std::fopen(file_name.c_str(), "rb");
-	if(!file) throw ErrorNotAccessible;
-	std::size_t data_length = size_t(file_stats.st_size);
-	std::vector<uint8_t> contents(data_length);
-	contents.resize(std::fread(&contents[0], 1, size_t(data_length), file));
-	std::fclose(file);
+	std::vector<uint8_t> contents;
+	try {
+		Storage::FileHolder file(file_name, Storage::FileHolder::FileMode::Read);
+		contents = file.read(size_t(file.stats().st_size));
+	} catch(Storage::FileHolder::Error) {
+		throw ErrorNotAccessible;
+	}
 
 	// enshrine
 	segments_.emplace_back(
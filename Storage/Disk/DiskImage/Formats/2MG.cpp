@@ -24,7 +24,7 @@ using namespace Storage::Disk;
 // So, I guess: go factory, pervasively. And probably stop the strict disk/mass storage/tape
 // distinction, given that clearly some platforms just capture volumes abstractly from media.
 
-Disk2MG::DiskOrMassStorageDevice Disk2MG::open(const std::string &file_name) {
+Disk2MG::DiskOrMassStorageDevice Disk2MG::open(const std::string &file_name, bool copy_on_write) {
 	FileHolder file(file_name);
 
 	// Check the signature.
@@ -84,7 +84,7 @@ Disk2MG::DiskOrMassStorageDevice Disk2MG::open(const std::string &file_name) {
 			// TODO: Apple II-style.
 
 			// Try a hard-disk image. For now this assumes: for an Apple IIe or GS.
-			return new MassStorage::HDV(file_name, data_start, data_size);
+			return new MassStorage::HDV(file_name, data_start, data_size, copy_on_write);
 		break;
 		case 2:
 			// TODO: NIB data (yuck!).
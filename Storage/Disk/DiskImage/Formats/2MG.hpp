@@ -30,7 +30,11 @@ namespace Storage::Disk {
 class Disk2MG {
 	public:
 		using DiskOrMassStorageDevice = std::variant<std::nullptr_t, DiskImageHolderBase *, Storage::MassStorage::MassStorageDevice *>;
-		static DiskOrMassStorageDevice open(const std::string &file_name);
+		/*!
+			Opens the 2MG file @c file_name; any mass storage device within will be opened
+			copy-on-write if @c copy_on_write is @c true.
+		*/
+		static DiskOrMassStorageDevice open(const std::string &file_name, bool copy_on_write = false);
 };
 
 }
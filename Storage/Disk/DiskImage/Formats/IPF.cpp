@@ -36,7 +36,7 @@ size_t block_size(Storage::FileHolder &file, uint8_t header) {
 
 }
 
-IPF::IPF(const std::string &file_name) : file_(file_name) {
+IPF::IPF(const std::string &file_name) : file_(file_name, FileHolder::FileMode::Map) {
 	std::map<uint32_t, Track::Address> tracks_by_data_key;
 
 	// For now, just build up a list of tracks that exist, noting the file position at which their data begins
@@ -389,7 +389,7 @@ class TrackConstructor {
 
 }
 
-STX::STX(const std::string &file_name) : file_(file_name) {
+STX::STX(const std::string &file_name) : file_(file_name, FileHolder::FileMode::Map) {
 	// Require that this be a version 3 Pasti.
 	if(!file_.check_signature("RSY", 4)) throw Error::InvalidFormat;
 	if(file_.get16le() != 3) throw Error::InvalidFormat;
@@ -468,8 +468,8 @@ std::shared_ptr<::Storage::Disk::Track> STX::get_track_at_position(::Storage::Di
 
 	// If this is a trivial .ST-style sector dump, life is easy.
 	if(!(flags & 1)) {
-		const auto sector_contents = file_.read(sector_count * 512);
-		return track_for_sectors(sector_contents.data(), sector_count, uint8_t(address.position.as_int()), uint8_t(address.head), 1, 2, Storage::Encodings::MFM::Density::Double);
+		const auto sector_contents = file_.read_view(sector_count * 512);
+		return track_for_sectors(sector_contents.data, sector_count, uint8_t(address.position.as_int()), uint8_t(address.head), 1, 2, Storage::Encodings::MFM::Density::Double);
 	}
 
 	// Grab sector records, if provided.
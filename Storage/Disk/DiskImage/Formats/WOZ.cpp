@@ -22,7 +22,7 @@ constexpr uint32_t chunk(const char *str) {
 }
 
 WOZ::WOZ(const std::string &file_name) :
-	file_(file_name) {
+	file_(file_name, FileHolder::FileMode::Map) {
 
 	constexpr const char signature1[8] = {
 		'W', 'O', 'Z', '1',
@@ -43,11 +43,9 @@ WOZ::WOZ(const std::string &file_name) :
 	// Get the file's CRC32.
 	const uint32_t crc = file_.get32le();
 
-	// Get the collection of all data that contributes to the CRC.
-	post_crc_contents_ = file_.read(size_t(file_.stats().st_size - 12));
-
-	// Test the CRC.
-	const uint32_t computed_crc = crc_generator.compute_crc(post_crc_contents_);
+	// Test the CRC of all data that follows it.
+	const auto post_crc_contents = file_.read_view(size_t(file_.stats().st_size - 12));
+	const uint32_t computed_crc = CRC::CRC32::compute(post_crc_contents.data, post_crc_contents.size);
 	if(crc != computed_crc) {
 		 throw Error::InvalidFormat;
 	}
@@ -189,6 +187,12 @@ std::shared_ptr<Track> WOZ::get_track_at_position(Track::Address address) {
 void WOZ::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
 	if(type_ == Type::WOZ2) return;
 
+	std::lock_guard lock_guard(file_.get_file_access_mutex());
+	if(post_crc_contents_.empty()) {
+		file_.seek(12, SEEK_SET);
+		post_crc_contents_ = file_.read(size_t(file_.stats().st_size - 12));
+	}
+
 	for(const auto &pair: tracks) {
 		// Decode the track and store, patching into the post_crc_contents_.
 		auto segment = Storage::Disk::track_serialisation(*pair.second, Storage::Time(1, 50000));
@@ -209,10 +213,9 @@ void WOZ::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tra
 	}
 
 	// Calculate the new CRC.
-	const uint32_t crc = crc_generator.compute_crc(post_crc_contents_);
+	const uint32_t crc = CRC::CRC32::compute(post_crc_contents_);
 
-	// Grab the file lock, then write the CRC, then just dump the entire file buffer.
-	std::lock_guard lock_guard(file_.get_file_access_mutex());
+	// Write the CRC, then just dump the entire file buffer.
 	file_.seek(8, SEEK_SET);
 	file_.put_le(crc);
 	file_.write(post_crc_contents_);
@@ -224,6 +227,8 @@ bool WOZ::get_is_read_only() {
 		of multiple addresses mapping to the same track, yet it maintains a cache of track contents. Therefore
 		if a WOZ is written to, what's written will magically be exactly 1/4 track wide, not affecting its
 		neighbours. I've made WOZs readonly until I can correct that issue.
+
+		The file is also currently mapped for reading only; it'll need to be opened for writing if that changes.
 	*/
 	return true;
 //	return file_.get_is_known_read_only() || is_read_only_ || type_ == Type::WOZ2;	// WOZ 2 disks are currently read only.
@@ -81,7 +81,7 @@ enum class SurfaceItem {
 
 class MFMEncoder: public Encoder {
 	public:
-		MFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
+		MFMEncoder(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
 		virtual ~MFMEncoder() {}
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
@@ -139,7 +139,7 @@ class MFMEncoder: public Encoder {
 class FMEncoder: public Encoder {
 	// encodes each 16-bit part as clock, data, clock, data [...]
 	public:
-		FMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
+		FMEncoder(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
 			crc_generator_.add(input);
@@ -303,10 +303,10 @@ template<class T> std::shared_ptr<Storage::Disk::Track>
 	return std::make_shared<Storage::Disk::PCMTrack>(std::move(segment));
 }
 
-Encoder::Encoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target) :
+Encoder::Encoder(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target) :
 	target_(&target), fuzzy_target_(fuzzy_target) {}
 
-void Encoder::reset_target(std::vector<bool> &target, std::vector<bool> *fuzzy_target) {
+void Encoder::reset_target(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target) {
 	target_ = &target;
 	fuzzy_target_ = fuzzy_target;
 }
@@ -389,10 +389,10 @@ std::shared_ptr<Storage::Disk::Track> Storage::Encodings::MFM::TrackWithSectors(
 	}
 }
 
-std::unique_ptr<Encoder> Storage::Encodings::MFM::GetMFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target) {
+std::unique_ptr<Encoder> Storage::Encodings::MFM::GetMFMEncoder(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target) {
 	return std::make_unique<MFMEncoder>(target, fuzzy_target);
 }
 
-std::unique_ptr<Encoder> Storage::Encodings::MFM::GetFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target) {
+std::unique_ptr<Encoder> Storage::Encodings::MFM::GetFMEncoder(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target) {
 	return std::make_unique<FMEncoder>(target, fuzzy_target);
 }
@@ -15,6 +15,7 @@
 
 #include "Constants.hpp"
 #include "Sector.hpp"
+#include "../../Track/BitVector.hpp"
 #include "../../Track/Track.hpp"
 #include "../../../../Numeric/CRC.hpp"
 
@@ -41,9 +42,9 @@ std::shared_ptr<Storage::Disk::Track> TrackWithSectors(
 
 class Encoder {
 	public:
-		Encoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target);
+		Encoder(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target);
 		virtual ~Encoder() {}
-		virtual void reset_target(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr);
+		virtual void reset_target(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target = nullptr);
 
 		virtual void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) = 0;
 		virtual void add_index_address_mark() = 0;
@@ -70,11 +71,11 @@ class Encoder {
 		CRC::CCITT crc_generator_;
 
 	private:
-		std::vector<bool> *target_ = nullptr;
-		std::vector<bool> *fuzzy_target_ = nullptr;
+		Storage::Disk::BitVector *target_ = nullptr;
+		Storage::Disk::BitVector *fuzzy_target_ = nullptr;
 };
 
-std::unique_ptr<Encoder> GetMFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr);
-std::unique_ptr<Encoder> GetFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr);
+std::unique_ptr<Encoder> GetMFMEncoder(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target = nullptr);
+std::unique_ptr<Encoder> GetFMEncoder(Storage::Disk::BitVector &target, Storage::Disk::BitVector *fuzzy_target = nullptr);
 
 }
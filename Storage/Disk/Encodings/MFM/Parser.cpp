@@ -10,10 +10,315 @@
 
 #include "Constants.hpp"
 #include "../../Track/TrackSerialiser.hpp"
+#include "../../../FileHolder.hpp"
 #include "SegmentParser.hpp"
 
+#include "../../../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 using namespace Storage::Encodings::MFM;
 
+namespace {
+
+/*!
+	@returns A hash of the events that make up a single revolution of @c track, beginning from
+	the index hole. Serialisation depends on nothing else, so tracks with the same hash will
+	always decode identically.
+*/
+uint64_t content_hash(const Storage::Disk::Track &track) {
+	std::unique_ptr<Storage::Disk::Track> track_copy(track.clone());
+	track_copy->seek_to(0.0f);
+
+	// FNV-1a.
+	uint64_t hash = 0xcbf2'9ce4'8422'2325;
+	const auto add = [&hash](uint32_t value) {
+		for(int c = 0; c < 4; c++) {
+			hash = (hash ^ (value & 0xff)) * 0x0000'0100'0000'01b3;
+			value >>= 8;
+		}
+	};
+
+	while(true) {
+		const auto event = track_copy->get_next_event();
+		add(event.type);
+		add(event.length.length);
+		add(event.length.clock_rate);
+		if(event.type == Storage::Disk::Track::Event::IndexHole) break;
+	}
+	return hash;
+}
+
+/*!
+	A process-wide store of the sectors found on previously-decoded tracks.
+
+	Tracks are identified primarily by object: disks retain the tracks they supply, so further parsers of the
+	same disk will usually be handed the same tracks. Results for a track are discarded if it has since been
+	modified, e.g. by a drive writing to it. Once persistence has been enabled via @c load, a track
+	not identified by object is also identified by a hash of its contents, allowing results to be shared with
+	other runs and with other images.
+
+	Each form of identification holds up to @c Capacity entries, discarding the oldest when full.
+*/
+class SectorCache {
+	public:
+		std::shared_ptr<const SectorMap> find(const std::shared_ptr<Storage::Disk::Track> &track, Density density) {
+			std::optional<uint64_t> hash;
+			{
+				std::lock_guard lock(mutex_);
+				auto &identity = identity_for(track);
+				const auto &sectors = identity.sectors[size_t(density)];
+				if(sectors || !is_persistent_) return sectors;
+				hash = identity.hash;
+			}
+
+			// Calculate the hash outside of the lock, as it requires a pass over the whole track.
+			const auto revision = track->revision();
+			if(!hash) hash = content_hash(*track);
+
+			std::lock_guard lock(mutex_);
+			auto &identity = identity_for(track);
+			if(identity.revision != revision) return nullptr;
+			identity.hash = hash;
+
+			const auto sectors = by_hash_.find(HashKey{*hash, density});
+			if(sectors == by_hash_.end()) return nullptr;
+			identity.sectors[size_t(density)] = sectors->second;
+			return sectors->second;
+		}
+
+		/// Records @c sectors as the result of parsing @c track at @c density when it was at revision @c revision.
+		void insert(const std::shared_ptr<Storage::Disk::Track> &track, unsigned int revision, Density density, const std::shared_ptr<const SectorMap> &sectors) {
+			std::lock_guard lock(mutex_);
+			auto &identity = identity_for(track);
+			if(identity.revision != revision) return;
+			identity.sectors[size_t(density)] = sectors;
+			if(identity.hash) {
+				insert(HashKey{*identity.hash, density}, sectors);
+			}
+		}
+
+		void clear() {
+			std::lock_guard lock(mutex_);
+			by_identity_.clear();
+			identity_order_.clear();
+			by_hash_.clear();
+			hash_order_.clear();
+		}
+
+		bool load(const std::string &file_name) {
+			{
+				std::lock_guard lock(mutex_);
+				is_persistent_ = true;
+			}
+
+			try {
+				Storage::FileHolder file(file_name, Storage::FileHolder::FileMode::Read);
+				if(!file.check_signature(Signature)) return false;
+				const long file_size = long(file.stats().st_size);
+
+				while(true) {
+					const uint64_t hash = file.get32le() | (uint64_t(file.get32le()) << 32);
+					if(file.eof()) break;
+
+					const auto density = Density(file.get8());
+					auto sectors = std::make_shared<SectorMap>();
+					auto count = file.get32le();
+					while(count--) {
+						const auto position = file.get32le();
+
+						Sector sector;
+						sector.address.track = file.get8();
+						sector.address.side = file.get8();
+						sector.address.sector = file.get8();
+						sector.size = file.get8();
+
+						const uint8_t flags = file.get8();
+						sector.has_data_crc_error = flags & 1;
+						sector.has_header_crc_error = flags & 2;
+						sector.is_deleted = flags & 4;
+
+						// Each sample occupies at least four bytes, which bounds the plausible sample count.
+						const auto sample_count = file.get32le();
+						if(file.eof() || sample_count > uint32_t(file_size - file.tell()) / 4) return false;
+
+						sector.samples.resize(sample_count);
+						for(auto &sample: sector.samples) {
+							const auto length = file.get32le();
+							if(length > MaxSectorSize) return false;
+							sample = file.read(length);
+						}
+
+						if(file.eof()) return false;
+						sectors->emplace(position, std::move(sector));
+					}
+
+					std::lock_guard lock(mutex_);
+					insert(HashKey{hash, density}, sectors);
+				}
+			} catch(Storage::FileHolder::Error) {
+				return false;
+			}
+
+			return true;
+		}
+
+		bool save(const std::string &file_name) {
+			try {
+				Storage::FileHolder file(file_name, Storage::FileHolder::FileMode::Rewrite);
+				file.write(reinterpret_cast<const uint8_t *>(Signature), sizeof(Signature) - 1);
+
+				std::lock_guard lock(mutex_);
+				for(const auto &key: hash_order_) {
+					file.put_le(key.hash);
+					file.put8(uint8_t(key.density));
+
+					const auto &sectors = *by_hash_[key];
+					file.put_le(uint32_t(sectors.size()));
+					for(const auto &pair: sectors) {
+						const auto &sector = pair.second;
+						file.put_le(uint32_t(pair.first));
+						file.put8(sector.address.track);
+						file.put8(sector.address.side);
+						file.put8(sector.address.sector);
+						file.put8(sector.size);
+						file.put8(
+							(sector.has_data_crc_error ? 1 : 0) |
+							(sector.has_header_crc_error ? 2 : 0) |
+							(sector.is_deleted ? 4 : 0)
+						);
+
+						file.put_le(uint32_t(sector.samples.size()));
+						for(const auto &sample: sector.samples) {
+							file.put_le(uint32_t(sample.size()));
+							file.write(sample);
+						}
+					}
+				}
+			} catch(Storage::FileHolder::Error) {
+				return false;
+			}
+
+			return true;
+		}
+
+	private:
+		static constexpr size_t Capacity = 8192;
+		static constexpr uint32_t MaxSectorSize = 128 << 7;
+		static constexpr char Signature[] = "CLK MFM sectors 2";
+
+		std::mutex mutex_;
+		bool is_persistent_ = false;
+
+		// Results by track object.
+		struct Identity {
+			std::weak_ptr<Storage::Disk::Track> track;
+			unsigned int revision;
+			std::optional<uint64_t> hash;
+			std::array<std::shared_ptr<const SectorMap>, 3> sectors;
+		};
+		std::unordered_map<const Storage::Disk::Track *, Identity> by_identity_;
+		std::deque<const Storage::Disk::Track *> identity_order_;
+
+		/// @returns The entry for @c track, creating it if necessary; any entry left by an earlier track
+		/// at the same address, or by this track prior to its most recent modification, is discarded.
+		Identity &identity_for(const std::shared_ptr<Storage::Disk::Track> &track) {
+			const auto existing = by_identity_.find(track.get());
+			if(existing != by_identity_.end()) {
+				if(!existing->second.track.expired() && existing->second.revision == track->revision()) {
+					return existing->second;
+				}
+				existing->second = Identity{track, track->revision()};
+				return existing->second;
+			}
+
+			if(identity_order_.size() == Capacity) {
+				by_identity_.erase(identity_order_.front());
+				identity_order_.pop_front();
+			}
+			identity_order_.push_back(track.get());
+			return by_identity_.emplace(track.get(), Identity{track, track->revision()}).first->second;
+		}
+
+		// Results by content.
+		struct HashKey {
+			uint64_t hash;
+			Density density;
+
+			bool operator ==(const HashKey &rhs) const {
+				return hash == rhs.hash && density == rhs.density;
+			}
+		};
+		struct HashKeyHash {
+			size_t operator()(const HashKey &key) const {
+				return size_t(key.hash) ^ size_t(key.density);
+			}
+		};
+		std::unordered_map<HashKey, std::shared_ptr<const SectorMap>, HashKeyHash> by_hash_;
+		std::deque<HashKey> hash_order_;
+
+		void insert(const HashKey &key, const std::shared_ptr<const SectorMap> &sectors) {
+			if(!by_hash_.emplace(key, sectors).second) return;
+
+			hash_order_.push_back(key);
+			if(hash_order_.size() > Capacity) {
+				by_hash_.erase(hash_order_.front());
+				hash_order_.pop_front();
+			}
+		}
+};
+
+SectorCache &cache() {
+	static SectorCache cache;
+	return cache;
+}
+
+/*!
+	A pool of worker threads, retained so that each call to @c Parser::decode_all_tracks needn't create its own.
+*/
+class WorkerPool {
+	public:
+		/// Performs @c function on up to @c count threads, including the calling thread, returning once all have finished.
+		void perform(const std::function<void(void)> &function, size_t count) {
+			std::lock_guard lock(mutex_);
+
+			if(workers_.empty()) {
+				const size_t worker_count = std::max(size_t(std::thread::hardware_concurrency()), size_t(1)) - 1;
+				for(size_t c = 0; c < worker_count; c++) {
+					workers_.push_back(std::make_unique<Concurrency::AsyncTaskQueue<true>>());
+				}
+			}
+
+			const size_t helpers = std::min(count, workers_.size() + 1) - 1;
+			for(size_t c = 0; c < helpers; c++) {
+				workers_[c]->enqueue(function);
+			}
+			function();
+			for(size_t c = 0; c < helpers; c++) {
+				workers_[c]->flush();
+			}
+		}
+
+	private:
+		std::mutex mutex_;
+		std::vector<std::unique_ptr<Concurrency::AsyncTaskQueue<true>>> workers_;
+};
+
+WorkerPool &workers() {
+	static WorkerPool workers;
+	return workers;
+}
+
+}
+
 Parser::Parser(const std::shared_ptr<Storage::Disk::Disk> &disk) :
 		disk_(disk) {}
 
@@ -30,23 +335,70 @@ void Parser::install_track(const Storage::Disk::Track::Address &address) {
 		return;
 	}
 
+	sectors_by_address_by_track_.emplace(address, decode_track(track));
+}
+
+void Parser::decode_all_tracks() {
+	// Gather all tracks on this thread, as disks don't offer thread-safe access.
+	std::vector<std::pair<Storage::Disk::Track::Address, std::shared_ptr<Storage::Disk::Track>>> tracks;
+	const int head_count = disk_->get_head_count();
+	const int track_count = disk_->get_maximum_head_position().as_int();
+	for(int head = 0; head < head_count; head++) {
+		for(int position = 0; position < track_count; position++) {
+			const Disk::Track::Address address(head, Storage::Disk::HeadPosition(position));
+			if(sectors_by_address_by_track_.find(address) != sectors_by_address_by_track_.end()) {
+				continue;
+			}
+
+			auto track = disk_->get_track_at_position(address);
+			if(track) {
+				tracks.emplace_back(address, std::move(track));
+			}
+		}
+	}
+	if(tracks.empty()) return;
+
+	// Decode them on the worker pool, each thread taking whichever track is next until all are done.
+	std::vector<std::map<int, Sector>> results(tracks.size());
+	std::atomic<size_t> next_track = 0;
+	workers().perform([&] {
+		while(true) {
+			const size_t index = next_track++;
+			if(index >= tracks.size()) break;
+			results[index] = decode_track(tracks[index].second);
+		}
+	}, tracks.size());
+
+	for(size_t c = 0; c < tracks.size(); c++) {
+		sectors_by_address_by_track_.emplace(tracks[c].first, std::move(results[c]));
+	}
+}
+
+std::map<int, Sector> Parser::decode_track(const std::shared_ptr<Storage::Disk::Track> &track) const {
 	std::map<int, Storage::Encodings::MFM::Sector> sectors_by_id;
 	if(density_) {
-		append(parse_track(*track, *density_), sectors_by_id);
+		append(*parse_track(track, *density_), sectors_by_id);
 	} else {
 		// Just try all three in succession.
-		append(parse_track(*track, Density::Single), sectors_by_id);
-		append(parse_track(*track, Density::Double), sectors_by_id);
-		append(parse_track(*track, Density::High), sectors_by_id);;
+		append(*parse_track(track, Density::Single), sectors_by_id);
+		append(*parse_track(track, Density::Double), sectors_by_id);
+		append(*parse_track(track, Density::High), sectors_by_id);
 	}
-
-	sectors_by_address_by_track_.emplace(address, std::move(sectors_by_id));
+	return sectors_by_id;
 }
 
-SectorMap Parser::parse_track(const Storage::Disk::Track &track, Density density) {
-	return sectors_from_segment(
-		Storage::Disk::track_serialisation(track, bit_length(density)),
-		density);
+std::shared_ptr<const SectorMap> Parser::parse_track(const std::shared_ptr<Storage::Disk::Track> &track, Density density) {
+	const auto revision = track->revision();
+	auto sectors = cache().find(track, density);
+	if(!sectors) {
+		sectors = std::make_shared<SectorMap>(
+			sectors_from_segment(
+				Storage::Disk::track_serialisation(*track, bit_length(density)),
+				density)
+		);
+		cache().insert(track, revision, density, sectors);
+	}
+	return sectors;
 }
 
 void Parser::append(const SectorMap &source, std::map<int, Sector> &destination) {
@@ -71,3 +423,15 @@ const Sector *Parser::sector(int head, int track, uint8_t sector) {
 
 	return &stored_sector->second;
 }
+
+bool Parser::load_cache(const std::string &file_name) {
+	return cache().load(file_name);
+}
+
+bool Parser::save_cache(const std::string &file_name) {
+	return cache().save(file_name);
+}
+
+void Parser::clear_cache() {
+	cache().clear();
+}
@@ -14,7 +14,10 @@
 #include "../../Track/Track.hpp"
 #include "../../Drive.hpp"
 
+#include <map>
+#include <memory>
 #include <optional>
+#include <string>
 
 namespace Storage::Encodings::MFM {
 
@@ -37,14 +40,48 @@ class Parser {
 		*/
 		const Storage::Encodings::MFM::Sector *sector(int head, int track, uint8_t sector);
 
+		/*!
+			Decodes every track on the disk that has not yet been decoded, spreading the work
+			across a pool of worker threads that is shared by all parsers.
+		*/
+		void decode_all_tracks();
+
 		// TODO: set_sector.
 
+		/*!
+			Decoded tracks are cached process-wide so that multiple parsers of the same disk need not
+			repeat the work.
+
+			Enables persistence of that cache: from now on tracks are also identified by a hash of their
+			contents, so that results can be shared across runs, and everything stored in @c file_name by
+			an earlier call to @c save_cache is added to the cache. Persistence is enabled even if
+			@c file_name cannot be read.
+
+			@returns @c true if the file was read successfully; @c false otherwise.
+		*/
+		static bool load_cache(const std::string &file_name);
+
+		/*!
+			Writes to @c file_name all tracks in the process-wide cache that have been identified by content,
+			i.e. those decoded or loaded since a call to @c load_cache.
+
+			@returns @c true if the file was written successfully; @c false otherwise.
+		*/
+		static bool save_cache(const std::string &file_name);
+
+		/*!
+			Discards the entire contents of the process-wide cache of decoded tracks. Persistence,
+			if enabled, remains so.
+		*/
+		static void clear_cache();
+
 	private:
 		std::shared_ptr<Storage::Disk::Disk> disk_;
 		std::optional<Density> density_;
 
 		void install_track(const Storage::Disk::Track::Address &address);
-		static SectorMap parse_track(const Storage::Disk::Track &track, Density density);
+		std::map<int, Sector> decode_track(const std::shared_ptr<Storage::Disk::Track> &track) const;
+		static std::shared_ptr<const SectorMap> parse_track(const std::shared_ptr<Storage::Disk::Track> &track, Density density);
 		static void append(const SectorMap &source, std::map<int, Sector> &destination);
 
 		// Maps from a track address, i.e. head and position, to a map from
@@ -88,6 +88,11 @@ std::unique_ptr<Storage::Disk::CPM::Catalogue> Storage::Disk::CPM::GetCatalogue(
 	// Sort the catalogue entries and then map to files.
 	std::sort(catalogue_entries.begin(), catalogue_entries.end());
 
+	// Every file will be read in full, which will touch most of the disk; decode all tracks up front, in parallel.
+	if(!catalogue_entries.empty()) {
+		parser.decode_all_tracks();
+	}
+
 	std::unique_ptr<Catalogue> result(new Catalogue);
 
 	bool has_long_allocation_units = (parameters.tracks * parameters.sectors_per_track * int(sector_size) / parameters.block_size) >= 256;
@@ -0,0 +1,280 @@
+//
+//  BitVector.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Storage::Disk {
+
+/*!
+	A sequence of bits, stored packed into 64-bit words with bit @c n in bit @c n%64 of word @c n/64.
+
+	Broadly mirrors the subset of the @c std::vector<bool> interface used for PCM data, while also
+	exposing word-level operations such as searching for the next set bit.
+*/
+class BitVector {
+	public:
+		using Word = uint64_t;
+		static constexpr std::size_t BitsPerWord = 64;
+
+		BitVector() = default;
+		BitVector(std::size_t size, bool value = false) {
+			resize(size, value);
+		}
+		BitVector(std::initializer_list<bool> bits) {
+			reserve(bits.size());
+			for(const auto bit: bits) push_back(bit);
+		}
+
+		// MARK: - Size.
+
+		std::size_t size() const {
+			return size_;
+		}
+
+		bool empty() const {
+			return !size_;
+		}
+
+		void clear() {
+			words_.clear();
+			size_ = 0;
+		}
+
+		void reserve(std::size_t size) {
+			words_.reserve(word_count(size));
+		}
+
+		/// Changes the number of bits stored; any new bits take the value @c value.
+		void resize(std::size_t size, bool value = false) {
+			const std::size_t original_size = size_;
+			words_.resize(word_count(size), 0);
+			size_ = size;
+
+			if(size < original_size) {
+				clear_tail();
+			} else if(value) {
+				fill(original_size, size, true);
+			}
+		}
+
+		// MARK: - Access.
+
+		/// A proxy for a single bit, allowing it to be assigned to.
+		class Reference {
+			public:
+				operator bool() const {
+					return word_ & mask_;
+				}
+
+				Reference &operator =(bool value) {
+					if(value) word_ |= mask_;
+					else word_ &= ~mask_;
+					return *this;
+				}
+
+				Reference &operator =(const Reference &rhs) {
+					return *this = bool(rhs);
+				}
+
+			private:
+				friend BitVector;
+				Reference(Word &word, Word mask) : word_(word), mask_(mask) {}
+				Word &word_;
+				const Word mask_;
+		};
+
+		bool operator[](std::size_t index) const {
+			return (words_[index / BitsPerWord] >> (index % BitsPerWord)) & 1;
+		}
+
+		Reference operator[](std::size_t index) {
+			return Reference(words_[index / BitsPerWord], Word(1) << (index % BitsPerWord));
+		}
+
+		bool back() const {
+			return (*this)[size_ - 1];
+		}
+
+		void push_back(bool value) {
+			if(!(size_ % BitsPerWord)) words_.push_back(0);
+			words_.back() |= Word(value) << (size_ % BitsPerWord);
+			++size_;
+		}
+
+		/// Sets all bits in the range [@c begin, @c end) to @c value.
+		void fill(std::size_t begin, std::size_t end, bool value) {
+			if(begin >= end) return;
+
+			std::size_t word = begin / BitsPerWord;
+			const std::size_t end_word = (end - 1) / BitsPerWord;
+			Word mask = ~Word(0) << (begin % BitsPerWord);
+			while(true) {
+				if(word == end_word) {
+					mask &= ~Word(0) >> (BitsPerWord - 1 - ((end - 1) % BitsPerWord));
+				}
+				if(value) words_[word] |= mask;
+				else words_[word] &= ~mask;
+
+				if(word == end_word) break;
+				++word;
+				mask = ~Word(0);
+			}
+		}
+
+		/// Appends the bits in the range [@c begin, @c end) of @c source.
+		void append(const BitVector &source, std::size_t begin, std::size_t end) {
+			reserve(size_ + end - begin);
+			while(begin < end) {
+				const auto count = std::min(BitsPerWord, end - begin);
+				push_back_word(source.word_at(begin), count);
+				begin += count;
+			}
+		}
+
+		void append(const BitVector &source) {
+			append(source, 0, source.size());
+		}
+
+		/// @returns The index of the first set bit at or after @c index, or @c size() if there is none.
+		std::size_t next_set_bit(std::size_t index) const {
+			if(index >= size_) return size_;
+
+			std::size_t word = index / BitsPerWord;
+			Word bits = words_[word] & (~Word(0) << (index % BitsPerWord));
+			while(!bits) {
+				++word;
+				if(word == words_.size()) return size_;
+				bits = words_[word];
+			}
+
+			// Bits beyond the end are always clear, so this is guaranteed to be in range.
+			return word * BitsPerWord + trailing_zeros(bits);
+		}
+
+		/// @returns The packed words; bits beyond @c size() in the final word are always clear.
+		const std::vector<Word> &words() const {
+			return words_;
+		}
+
+		bool operator ==(const BitVector &rhs) const {
+			return size_ == rhs.size_ && words_ == rhs.words_;
+		}
+
+		bool operator !=(const BitVector &rhs) const {
+			return !(*this == rhs);
+		}
+
+		// MARK: - Iteration.
+
+		class const_iterator {
+			public:
+				bool operator *() const {
+					return (*vector_)[index_];
+				}
+
+				const_iterator &operator ++() {
+					++index_;
+					return *this;
+				}
+
+				bool operator ==(const const_iterator &rhs) const {
+					return index_ == rhs.index_;
+				}
+
+				bool operator !=(const const_iterator &rhs) const {
+					return index_ != rhs.index_;
+				}
+
+			private:
+				friend BitVector;
+				const_iterator(const BitVector *vector, std::size_t index) : vector_(vector), index_(index) {}
+				const BitVector *vector_;
+				std::size_t index_;
+		};
+
+		const_iterator begin() const {
+			return const_iterator(this, 0);
+		}
+
+		const_iterator end() const {
+			return const_iterator(this, size_);
+		}
+
+	private:
+		std::vector<Word> words_;
+		std::size_t size_ = 0;
+
+		static constexpr std::size_t word_count(std::size_t bits) {
+			return (bits + BitsPerWord - 1) / BitsPerWord;
+		}
+
+		static int trailing_zeros(Word word) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, word);
+			return int(index);
+#else
+			int count = 0;
+			while(!(word & 1)) {
+				word >>= 1;
+				++count;
+			}
+			return count;
+#endif
+		}
+
+		/// @returns The up-to 64 bits starting from @c index, with any beyond the end being clear.
+		Word word_at(std::size_t index) const {
+			const std::size_t word = index / BitsPerWord;
+			const std::size_t shift = index % BitsPerWord;
+			Word result = words_[word] >> shift;
+			if(shift && word + 1 < words_.size()) {
+				result |= words_[word + 1] << (BitsPerWord - shift);
+			}
+			return result;
+		}
+
+		/// Appends the low @c count bits of @c value.
+		void push_back_word(Word value, std::size_t count) {
+			if(count < BitsPerWord) {
+				value &= (Word(1) << count) - 1;
+			}
+
+			const std::size_t shift = size_ % BitsPerWord;
+			if(!shift) {
+				words_.push_back(value);
+			} else {
+				words_.back() |= value << shift;
+				if(shift + count > BitsPerWord) {
+					words_.push_back(value >> (BitsPerWord - shift));
+				}
+			}
+			size_ += count;
+		}
+
+		/// Clears any bits in the final word beyond the end.
+		void clear_tail() {
+			if(size_ % BitsPerWord) {
+				words_.back() &= (Word(1) << (size_ % BitsPerWord)) - 1;
+			}
+		}
+};
+
+}
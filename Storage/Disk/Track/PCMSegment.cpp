@@ -8,6 +8,7 @@
 
 #include "PCMSegment.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
@@ -47,7 +48,7 @@ void PCMSegmentEventSource::reset() {
 }
 
 PCMSegment &PCMSegment::operator +=(const PCMSegment &rhs) {
-	data.insert(data.end(), rhs.data.begin(), rhs.data.end());
+	data.append(rhs.data);
 	return *this;
 }
 
@@ -55,18 +56,19 @@ void PCMSegment::rotate_right(size_t length) {
 	length %= data.size();
 	if(!length) return;
 
-	// To rotate to the right, front-insert the proper number
-	// of bits from the end and then resize. To rotate to
-	// the left, do the opposite.
-	std::vector<uint8_t> data_copy;
-	if(length > 0) {
-		data_copy.insert(data_copy.end(), data.end() - ptrdiff_t(length), data.end());
-		data.erase(data.end() - ptrdiff_t(length), data.end());
-		data.insert(data.begin(), data_copy.begin(), data_copy.end());
-	} else {
-		data_copy.insert(data_copy.end(), data.begin(), data.begin() - ptrdiff_t(length));
-		data.erase(data.begin(), data.begin() - ptrdiff_t(length));
-		data.insert(data.end(), data_copy.begin(), data_copy.end());
+	// Build the rotated data from the final length bits followed by everything else.
+	BitVector rotated;
+	rotated.append(data, data.size() - length, data.size());
+	rotated.append(data, 0, data.size() - length);
+	data = std::move(rotated);
+
+	if(!fuzzy_mask.empty()) {
+		fuzzy_mask.resize(data.size());
+
+		BitVector rotated_mask;
+		rotated_mask.append(fuzzy_mask, fuzzy_mask.size() - length, fuzzy_mask.size());
+		rotated_mask.append(fuzzy_mask, 0, fuzzy_mask.size() - length);
+		fuzzy_mask = std::move(rotated_mask);
 	}
 }
 
@@ -79,16 +81,32 @@ Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// is set, it should be in the centre of its window.
 	next_event_.length.length = bit_pointer_ ? 0 : -(segment_->length_of_a_bit.length >> 1);
 
-	// search for the next bit that is set, if any
-	while(bit_pointer_ < segment_->data.size()) {
-		bool bit = segment_->data[bit_pointer_];
-		++bit_pointer_;	// so this always points one beyond the most recent bit returned
-		next_event_.length.length += segment_->length_of_a_bit.length;
-
-		// if this bit is set, or is fuzzy and a random bit of 1 is selected, return the event.
-		if(bit ||
-			(!segment_->fuzzy_mask.empty() && segment_->fuzzy_mask[bit_pointer_] && lfsr_.next())
-		)	return next_event_;
+	// Search for the next bit that is set, if any.
+	const auto &data = segment_->data;
+	if(bit_pointer_ < data.size()) {
+		std::size_t next_bit = data.next_set_bit(bit_pointer_);
+
+		// Any fuzzy bit before that may instead produce an event, if a random bit of 1 is selected.
+		const auto &fuzzy_mask = segment_->fuzzy_mask;
+		const std::size_t fuzzy_end = std::min(next_bit, fuzzy_mask.size());
+		for(
+			std::size_t fuzzy_bit = fuzzy_mask.next_set_bit(bit_pointer_);
+			fuzzy_bit < fuzzy_end;
+			fuzzy_bit = fuzzy_mask.next_set_bit(fuzzy_bit + 1)
+		) {
+			if(lfsr_.next()) {
+				next_bit = fuzzy_bit;
+				break;
+			}
+		}
+
+		// Advance to one beyond the bit found, or to the end if none was.
+		const std::size_t end = std::min(next_bit + 1, data.size());
+		next_event_.length.length += segment_->length_of_a_bit.length * unsigned(end - bit_pointer_);
+		bit_pointer_ = end;
+		if(next_bit < data.size()) {
+			return next_event_;
+		}
 	}
 
 	// If the end is reached without a bit being set, it'll be index holes from now on.
@@ -14,6 +14,7 @@
 
 #include "../../Storage.hpp"
 #include "../../../Numeric/LFSR.hpp"
+#include "BitVector.hpp"
 #include "Track.hpp"
 
 namespace Storage::Disk {
@@ -29,27 +30,27 @@ struct PCMSegment {
 	Time length_of_a_bit = Time(1);
 
 	/*!
-		This is the actual data, taking advantage of the std::vector<bool>
-		specialisation to use whatever one-bit-per-value encoding is
-		most suited to this architecture.
+		This is the actual data, packed into 64-bit words so that flux transitions
+		can be located a word at a time.
 
 		If a value is @c true then a flux transition occurs in that window.
 		If it is @c false then no flux transition occurs.
 	*/
-	std::vector<bool> data;
+	BitVector data;
 
 	/*!
 		If a segment has a fuzzy mask then anywhere the mask has a value
 		of @c true, a random bit will be ORd onto whatever is in the
-		corresponding slot in @c data.
+		corresponding slot in @c data. The mask may be shorter than @c data,
+		in which case all subsequent bits are not fuzzy.
 	*/
-	std::vector<bool> fuzzy_mask;
+	BitVector fuzzy_mask;
 
 	/*!
 		Constructs an instance of PCMSegment with the specified @c length_of_a_bit
 		and @c data.
 	*/
-	PCMSegment(Time length_of_a_bit, const std::vector<bool> &data)
+	PCMSegment(Time length_of_a_bit, const BitVector &data)
 		: length_of_a_bit(length_of_a_bit), data(data) {}
 
 	/*!
@@ -113,8 +114,6 @@ struct PCMSegment {
 
 	/*!
 		Rotates all bits in this segment by @c length bits.
-
-		@c length is signed; to rotate left provide a negative number.
 	*/
 	void rotate_right(size_t length);
 
@@ -154,6 +154,8 @@ float PCMTrack::seek_to(float time_since_index_hole) {
 }
 
 void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bool clamp_to_index_hole) {
+	did_modify();
+
 	// Get a reference to the destination.
 	PCMSegment &destination = segment_event_sources_.front().segment();
 
@@ -170,15 +172,17 @@ void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bo
 		const size_t selected_end_bit = std::min(end_bit, destination.data.size());
 
 		// Reset the destination.
-		std::fill(destination.data.begin() + ptrdiff_t(start_bit), destination.data.begin() + ptrdiff_t(selected_end_bit), false);
-
-		// Step through the source data from start to finish, stopping early if it goes out of bounds.
-		for(size_t bit = 0; bit < segment.data.size(); ++bit) {
-			if(segment.data[bit]) {
-				const size_t output_bit = start_bit + half_offset + (bit * target_width) / segment.data.size();
-				if(output_bit >= destination.data.size()) return;
-				destination.data[output_bit] = true;
-			}
+		destination.data.fill(start_bit, selected_end_bit, false);
+
+		// Step through the flux transitions in the source data from start to finish, stopping early if it goes out of bounds.
+		for(
+			size_t bit = segment.data.next_set_bit(0);
+			bit < segment.data.size();
+			bit = segment.data.next_set_bit(bit + 1)
+		) {
+			const size_t output_bit = start_bit + half_offset + (bit * target_width) / segment.data.size();
+			if(output_bit >= destination.data.size()) return;
+			destination.data[output_bit] = true;
 		}
 	} else {
 		// Clamping is not enabled, so the supplied segment loops over the index hole, arbitrarily many times.
@@ -187,10 +191,10 @@ void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bo
 		// This definitely runs over the index hole; check whether the whole track needs clearing, or whether
 		// a centre segment is untouched.
 		if(target_width >= destination.data.size()) {
-			std::fill(destination.data.begin(), destination.data.end(), false);
+			destination.data.fill(0, destination.data.size(), false);
 		} else {
-			std::fill(destination.data.begin(), destination.data.begin() + ptrdiff_t(end_bit % destination.data.size()), false);
-			std::fill(destination.data.begin() + ptrdiff_t(start_bit), destination.data.end(), false);
+			destination.data.fill(0, end_bit % destination.data.size(), false);
+			destination.data.fill(start_bit, destination.data.size(), false);
 		}
 
 		// Run backwards from final bit back to first, stopping early if overlapping the beginning.
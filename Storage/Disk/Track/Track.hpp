@@ -122,6 +122,23 @@ class Track {
 			The virtual copy constructor pattern; returns a copy of the Track.
 		*/
 		virtual Track *clone() const = 0;
+
+		/*!
+			@returns A count of the modifications made to this track in place, allowing anything derived
+			from its contents to be recognised as stale.
+		*/
+		unsigned int revision() const {
+			return revision_;
+		}
+
+	protected:
+		/// Records that the contents of this track have been modified in place.
+		void did_modify() {
+			++revision_;
+		}
+
+	private:
+		unsigned int revision_ = 0;
 };
 
 }
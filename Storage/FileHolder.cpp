@@ -19,6 +19,22 @@ FileHolder::~FileHolder() {
 
 FileHolder::FileHolder(const std::string &file_name, FileMode ideal_mode)
 	: name_(file_name) {
+	if(ideal_mode != FileMode::Rewrite) {
+		std::lock_guard lock(in_memory_files_mutex());
+		const auto in_memory_file = in_memory_files().find(file_name);
+		if(in_memory_file != in_memory_files().end()) {
+			memory_ = in_memory_file->second;
+			contents_ = ByteView(*memory_);
+			is_in_memory_ = true;
+			is_read_only_ = true;
+
+			file_stats_ = {};
+			file_stats_.st_mode = S_IFREG;
+			file_stats_.st_size = decltype(file_stats_.st_size)(memory_->size());
+			return;
+		}
+	}
+
 	stat(file_name.c_str(), &file_stats_);
 	is_read_only_ = false;
 
@@ -36,74 +52,96 @@ FileHolder::FileHolder(const std::string &file_name, FileMode ideal_mode)
 		case FileMode::Rewrite:
 			file_ = std::fopen(file_name.c_str(), "w");
 		break;
+
+		case FileMode::Map:
+			is_read_only_ = true;
+			try {
+				mapping_.emplace(file_name, MappedFile::Mode::Read);
+				contents_ = ByteView(mapping_->data(), mapping_->size());
+				is_in_memory_ = true;
+				return;
+			} catch(MappedFile::Error) {}
+			file_ = std::fopen(file_name.c_str(), "rb");
+		break;
 	}
 
 	if(!file_) throw Error::CantOpen;
 }
 
 uint32_t FileHolder::get32le() {
-	uint32_t result = uint32_t(std::fgetc(file_));
-	result |= uint32_t(std::fgetc(file_)) << 8;
-	result |= uint32_t(std::fgetc(file_)) << 16;
-	result |= uint32_t(std::fgetc(file_)) << 24;
+	uint32_t result = uint32_t(get_byte());
+	result |= uint32_t(get_byte()) << 8;
+	result |= uint32_t(get_byte()) << 16;
+	result |= uint32_t(get_byte()) << 24;
 
 	return result;
 }
 
 uint32_t FileHolder::get32be() {
-	uint32_t result = uint32_t(std::fgetc(file_)) << 24;
-	result |= uint32_t(std::fgetc(file_)) << 16;
-	result |= uint32_t(std::fgetc(file_)) << 8;
-	result |= uint32_t(std::fgetc(file_));
+	uint32_t result = uint32_t(get_byte()) << 24;
+	result |= uint32_t(get_byte()) << 16;
+	result |= uint32_t(get_byte()) << 8;
+	result |= uint32_t(get_byte());
 
 	return result;
 }
 
 uint32_t FileHolder::get24le() {
-	uint32_t result = uint32_t(std::fgetc(file_));
-	result |= uint32_t(std::fgetc(file_)) << 8;
-	result |= uint32_t(std::fgetc(file_)) << 16;
+	uint32_t result = uint32_t(get_byte());
+	result |= uint32_t(get_byte()) << 8;
+	result |= uint32_t(get_byte()) << 16;
 
 	return result;
 }
 
 uint32_t FileHolder::get24be() {
-	uint32_t result = uint32_t(std::fgetc(file_)) << 16;
-	result |= uint32_t(std::fgetc(file_)) << 8;
-	result |= uint32_t(std::fgetc(file_));
+	uint32_t result = uint32_t(get_byte()) << 16;
+	result |= uint32_t(get_byte()) << 8;
+	result |= uint32_t(get_byte());
 
 	return result;
 }
 
 uint16_t FileHolder::get16le() {
-	uint16_t result = uint16_t(std::fgetc(file_));
-	result |= uint16_t(uint16_t(std::fgetc(file_)) << 8);
+	uint16_t result = uint16_t(get_byte());
+	result |= uint16_t(uint16_t(get_byte()) << 8);
 
 	return result;
 }
 
 uint16_t FileHolder::get16be() {
-	uint16_t result = uint16_t(uint16_t(std::fgetc(file_)) << 8);
-	result |= uint16_t(std::fgetc(file_));
+	uint16_t result = uint16_t(uint16_t(get_byte()) << 8);
+	result |= uint16_t(get_byte());
 
 	return result;
 }
 
 uint8_t FileHolder::get8() {
-	return uint8_t(std::fgetc(file_));
+	return uint8_t(get_byte());
+}
+
+int FileHolder::get_byte() {
+	if(!is_in_memory_) return std::fgetc(file_);
+
+	if(position_ >= long(contents_.size)) {
+		eof_ = true;
+		return EOF;
+	}
+	return contents_.data[position_++];
 }
 
 void FileHolder::put16be(uint16_t value) {
-	std::fputc(value >> 8, file_);
-	std::fputc(value, file_);
+	put8(uint8_t(value >> 8));
+	put8(uint8_t(value));
 }
 
 void FileHolder::put16le(uint16_t value) {
-	std::fputc(value, file_);
-	std::fputc(value >> 8, file_);
+	put8(uint8_t(value));
+	put8(uint8_t(value >> 8));
 }
 
 void FileHolder::put8(uint8_t value) {
+	if(is_in_memory_) return;
 	std::fputc(value, file_);
 }
 
@@ -112,50 +150,113 @@ void FileHolder::putn(std::size_t repeats, uint8_t value) {
 }
 
 std::vector<uint8_t> FileHolder::read(std::size_t size) {
+	if(is_in_memory_) {
+		const auto view = read_view(size);
+		return std::vector<uint8_t>(view.begin(), view.end());
+	}
+
 	std::vector<uint8_t> result(size);
 	result.resize(std::fread(result.data(), 1, size, file_));
 	return result;
 }
 
 std::size_t FileHolder::read(uint8_t *buffer, std::size_t size) {
+	if(is_in_memory_) {
+		const auto view = read_view(size);
+		std::copy(view.begin(), view.end(), buffer);
+		return view.size;
+	}
+
 	return std::fread(buffer, 1, size, file_);
 }
 
+ByteView FileHolder::read_view(std::size_t size) {
+	if(!is_in_memory_) {
+		view_buffer_ = read(size);
+		return view_buffer_;
+	}
+
+	const auto file_size = long(contents_.size);
+	const auto available = size_t(std::max(file_size - position_, 0l));
+	if(available < size) {
+		eof_ = true;
+		size = available;
+	}
+
+	const ByteView result(contents_.data + position_, size);
+	position_ += long(size);
+	return result;
+}
+
+bool FileHolder::is_in_memory() const {
+	return is_in_memory_;
+}
+
 std::size_t FileHolder::write(const std::vector<uint8_t> &buffer) {
-	return std::fwrite(buffer.data(), 1, buffer.size(), file_);
+	return write(buffer.data(), buffer.size());
 }
 
 std::size_t FileHolder::write(const uint8_t *buffer, std::size_t size) {
+	if(is_in_memory_) return 0;
 	return std::fwrite(buffer, 1, size, file_);
 }
 
 void FileHolder::seek(long offset, int whence) {
-	std::fseek(file_, offset, whence);
+	if(!is_in_memory_) {
+		std::fseek(file_, offset, whence);
+		return;
+	}
+
+	switch(whence) {
+		default:
+		case SEEK_SET:	break;
+		case SEEK_CUR:	offset += position_;					break;
+		case SEEK_END:	offset += long(contents_.size);		break;
+	}
+	if(offset < 0) return;
+
+	position_ = offset;
+	eof_ = false;
 }
 
 long FileHolder::tell() {
+	if(is_in_memory_) return position_;
 	return std::ftell(file_);
 }
 
 void FileHolder::flush() {
+	if(is_in_memory_) return;
 	std::fflush(file_);
 }
 
 bool FileHolder::eof() {
+	if(is_in_memory_) return eof_;
 	return std::feof(file_);
 }
 
+FileHolder::Cursor FileHolder::cursor() {
+	return Cursor{tell(), eof()};
+}
+
+void FileHolder::set_cursor(const Cursor &cursor) {
+	seek(cursor.position, SEEK_SET);
+
+	// Seeking clears the end-of-file indicator; if it was previously set then the cursor
+	// was at the end of the file, so an attempt to read will set it again.
+	if(cursor.eof) get_byte();
+}
+
 FileHolder::BitStream FileHolder::get_bitstream(bool lsb_first) {
-	return BitStream(file_, lsb_first);
+	return BitStream(*this, lsb_first);
 }
 
 bool FileHolder::check_signature(const char *signature, std::size_t length) {
 	if(!length) length = std::strlen(signature);
 
 	// read and check the file signature
-	std::vector<uint8_t> stored_signature = read(length);
-	if(stored_signature.size() != length)							return false;
-	if(std::memcmp(stored_signature.data(), signature, length))		return false;
+	const ByteView stored_signature = read_view(length);
+	if(stored_signature.size != length)								return false;
+	if(std::memcmp(stored_signature.data, signature, length))		return false;
 	return true;
 }
 
@@ -170,6 +271,8 @@ std::string FileHolder::extension() {
 }
 
 void FileHolder::ensure_is_at_least_length(long length) {
+	if(is_in_memory_) return;
+
 	std::fseek(file_, 0, SEEK_END);
 	long bytes_to_write = length - ftell(file_);
 	if(bytes_to_write > 0) {
@@ -189,3 +292,23 @@ struct stat &FileHolder::stats() {
 std::mutex &FileHolder::get_file_access_mutex() {
 	return file_access_mutex_;
 }
+
+std::map<std::string, std::shared_ptr<const std::vector<uint8_t>>> &FileHolder::in_memory_files() {
+	static std::map<std::string, std::shared_ptr<const std::vector<uint8_t>>> files;
+	return files;
+}
+
+std::mutex &FileHolder::in_memory_files_mutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+void FileHolder::add_in_memory_file(const std::string &file_name, const std::shared_ptr<const std::vector<uint8_t>> &contents) {
+	std::lock_guard lock(in_memory_files_mutex());
+	in_memory_files()[file_name] = contents;
+}
+
+void FileHolder::remove_in_memory_file(const std::string &file_name) {
+	std::lock_guard lock(in_memory_files_mutex());
+	in_memory_files().erase(file_name);
+}
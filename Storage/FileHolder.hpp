@@ -8,11 +8,17 @@
 
 #pragma once
 
+#include "ByteView.hpp"
+#include "MappedFile.hpp"
+
 #include <sys/stat.h>
 #include <array>
 #include <cstdio>
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -27,7 +33,8 @@ class FileHolder final {
 		enum class FileMode {
 			ReadWrite,
 			Read,
-			Rewrite
+			Rewrite,
+			Map
 		};
 
 		~FileHolder();
@@ -41,11 +48,27 @@ class FileHolder final {
 				Read		attempts to open this file for reading only.
 				Rewrite		opens the file for rewriting; none of the original content is preserved; whatever
 							the caller outputs will replace the existing file.
+				Map			attempts to map this file into memory for reading only, so that reads need not
+							go via the C library and @c read_view can avoid copying. Writes are ignored.
+							If mapping fails, will open in Read mode.
 
 			@throws ErrorCantOpen if the file cannot be opened.
 		*/
 		FileHolder(const std::string &file_name, FileMode ideal_mode = FileMode::ReadWrite);
 
+		/*!
+			Causes any FileHolder subsequently constructed with @c file_name, other than for rewriting, to read
+			from @c contents rather than from the filesystem until a matching call to @c remove_in_memory_file.
+			Such FileHolders are read-only.
+		*/
+		static void add_in_memory_file(const std::string &file_name, const std::shared_ptr<const std::vector<uint8_t>> &contents);
+
+		/*!
+			Ends the substitution established by @c add_in_memory_file; FileHolders already constructed
+			are unaffected.
+		*/
+		static void remove_in_memory_file(const std::string &file_name);
+
 		/*!
 			Performs @c get8 four times on @c file, casting each result to a @c uint32_t
 			and returning the four assembled in little endian order.
@@ -134,6 +157,21 @@ class FileHolder final {
 		/*! Reads @c size bytes and writes them to @c buffer. */
 		std::size_t read(uint8_t *buffer, std::size_t size);
 
+		/*!
+			Reads up to @c size bytes without copying them if this file has been mapped into memory.
+
+			@returns A view of the bytes read. If the file is in memory this points directly to its contents
+				and remains valid for the lifetime of this FileHolder; otherwise it remains valid only until
+				the next call to @c read_view.
+		*/
+		ByteView read_view(std::size_t size);
+
+		/*!
+			@returns @c true if this file's contents are in memory, either because it has been mapped or
+				because it was supplied via @c add_in_memory_file; @c false otherwise.
+		*/
+		bool is_in_memory() const;
+
 		/*! Writes @c buffer one byte at a time in order. */
 		std::size_t write(const std::vector<uint8_t> &buffer);
 
@@ -152,6 +190,18 @@ class FileHolder final {
 		/*! @returns @c true if the end-of-file indicator is set, @c false otherwise. */
 		bool eof();
 
+		/*! Records both the cursor position and the state of the end-of-file indicator. */
+		struct Cursor {
+			long position;
+			bool eof;
+		};
+
+		/*! @returns The current cursor position and end-of-file state, for later restoration via @c set_cursor. */
+		Cursor cursor();
+
+		/*! Restores the cursor position and end-of-file state to that recorded by a prior call to @c cursor. */
+		void set_cursor(const Cursor &);
+
 		class BitStream {
 			public:
 				uint8_t get_bits(int q) {
@@ -163,14 +213,14 @@ class FileHolder final {
 				}
 
 			private:
-				BitStream(FILE *file, bool lsb_first) :
+				BitStream(FileHolder &file, bool lsb_first) :
 					file_(file),
 					lsb_first_(lsb_first),
 					next_value_(0),
 					bits_remaining_(0) {}
 				friend FileHolder;
 
-				FILE *file_;
+				FileHolder &file_;
 				bool lsb_first_;
 				uint8_t next_value_;
 				int bits_remaining_;
@@ -178,7 +228,7 @@ class FileHolder final {
 				uint8_t get_bit() {
 					if(!bits_remaining_) {
 						bits_remaining_ = 8;
-						next_value_ = uint8_t(fgetc(file_));
+						next_value_ = file_.get8();
 					}
 
 					uint8_t bit;
@@ -241,6 +291,22 @@ class FileHolder final {
 		FILE *file_ = nullptr;
 		const std::string name_;
 
+		// If in memory, the file is accessed through contents_ rather than file_, which
+		// will be nullptr; position_ and eof_ stand in for the C library's cursor.
+		// contents_ points into either mapping_ or memory_.
+		bool is_in_memory_ = false;
+		ByteView contents_;
+		std::optional<MappedFile> mapping_;
+		std::shared_ptr<const std::vector<uint8_t>> memory_;
+		long position_ = 0;
+		bool eof_ = false;
+		std::vector<uint8_t> view_buffer_;
+
+		int get_byte();
+
+		static std::map<std::string, std::shared_ptr<const std::vector<uint8_t>>> &in_memory_files();
+		static std::mutex &in_memory_files_mutex();
+
 		struct stat file_stats_;
 		bool is_read_only_ = false;
 
@@ -0,0 +1,84 @@
+//
+//  MappedFile.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "MappedFile.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Storage;
+
+#ifdef HAS_MMAP
+
+namespace {
+
+/// Calls msync for the pages that include the range [@c offset, @c offset + @c length) of the mapping at @c data.
+void sync(uint8_t *data, std::size_t offset, std::size_t length, int flags) {
+	static const auto page_size = std::size_t(sysconf(_SC_PAGESIZE));
+	const std::size_t start = offset - (offset % page_size);
+	msync(data + start, length + (offset - start), flags);
+}
+
+}
+
+MappedFile::MappedFile(const std::string &file_name, Mode mode) : mode_(mode) {
+	const int fd = open(file_name.c_str(), mode == Mode::ReadWrite ? O_RDWR : O_RDONLY);
+	if(fd < 0) throw Error::CantMap;
+
+	struct stat file_stats;
+	if(fstat(fd, &file_stats) || file_stats.st_size <= 0) {
+		close(fd);
+		throw Error::CantMap;
+	}
+	size_ = std::size_t(file_stats.st_size);
+
+	void *const mapping = mmap(
+		nullptr,
+		size_,
+		mode == Mode::Read ? PROT_READ : PROT_READ | PROT_WRITE,
+		mode == Mode::CopyOnWrite ? MAP_PRIVATE : MAP_SHARED,
+		fd,
+		0
+	);
+
+	// The mapping holds its own reference to the file, so the descriptor is no longer needed.
+	close(fd);
+	if(mapping == MAP_FAILED) throw Error::CantMap;
+	data_ = static_cast<uint8_t *>(mapping);
+}
+
+MappedFile::~MappedFile() {
+	munmap(data_, size_);
+}
+
+void MappedFile::flush(std::size_t offset, std::size_t length) {
+	if(mode_ != Mode::ReadWrite) return;
+	sync(data_, offset, length, MS_SYNC);
+}
+
+void MappedFile::schedule_flush(std::size_t offset, std::size_t length) {
+	if(mode_ != Mode::ReadWrite) return;
+	sync(data_, offset, length, MS_ASYNC);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &, Mode mode) : mode_(mode) {
+	throw Error::CantMap;
+}
+
+MappedFile::~MappedFile() {}
+void MappedFile::flush(std::size_t, std::size_t) {}
+void MappedFile::schedule_flush(std::size_t, std::size_t) {}
+
+#endif
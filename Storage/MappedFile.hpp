@@ -0,0 +1,94 @@
+//
+//  MappedFile.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Storage {
+
+/*!
+	Maps the entire contents of a file into memory, providing direct access to it.
+
+	Mapping is supported only on POSIX platforms. Elsewhere, or if mapping fails for any other reason,
+	construction will throw; callers should be prepared to fall back on a @c FileHolder.
+*/
+class MappedFile final {
+	public:
+		enum class Error {
+			CantMap = -1
+		};
+
+		enum class Mode {
+			/// The file can only be read; writing to @c data() is undefined behaviour.
+			Read,
+			/// Changes to @c data() are written back to the file asynchronously; call @c flush
+			/// to ensure that they have been.
+			ReadWrite,
+			/// Changes to @c data() are visible only to this mapping; the file is never modified.
+			CopyOnWrite,
+		};
+
+		/*!
+			Attempts to map the file indicated by @c file_name in the mode @c mode.
+
+			@throws Error::CantMap if the file cannot be mapped.
+		*/
+		MappedFile(const std::string &file_name, Mode mode);
+		~MappedFile();
+
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator =(const MappedFile &) = delete;
+
+		/*! @returns A pointer to the start of the file's contents. */
+		uint8_t *data() {
+			return data_;
+		}
+		const uint8_t *data() const {
+			return data_;
+		}
+
+		/*! @returns The size of the file in bytes. */
+		std::size_t size() const {
+			return size_;
+		}
+
+		/*! @returns The mode in which this file was mapped. */
+		Mode mode() const {
+			return mode_;
+		}
+
+		/*!
+			Blocks until all changes made in the range [@c offset, @c offset + @c length) have been written back to the
+			file if this is a @c ReadWrite mapping; otherwise has no effect.
+		*/
+		void flush(std::size_t offset, std::size_t length);
+
+		/*!
+			Blocks until all changes have been written back to the file if this is a @c ReadWrite mapping; otherwise
+			has no effect.
+		*/
+		void flush() {
+			flush(0, size_);
+		}
+
+		/*!
+			Requests that changes made in the range [@c offset, @c offset + @c length) be written back to the file
+			at some point in the near future, without waiting for that to happen.
+		*/
+		void schedule_flush(std::size_t offset, std::size_t length);
+
+	private:
+		uint8_t *data_ = nullptr;
+		std::size_t size_ = 0;
+		Mode mode_;
+};
+
+}
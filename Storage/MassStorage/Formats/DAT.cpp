@@ -10,7 +10,7 @@
 
 using namespace Storage::MassStorage;
 
-DAT::DAT(const std::string &file_name) : RawSectorDump(file_name) {
+DAT::DAT(const std::string &file_name, bool copy_on_write) : RawSectorDump(file_name, 0, -1, copy_on_write) {
 	// Does the third sector contain the 'Hugo' signature?
 	const auto sector3 = get_block(2);
 	if(sector3.size() != 256) {
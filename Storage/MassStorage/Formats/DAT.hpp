@@ -19,7 +19,7 @@ namespace Storage::MassStorage {
 */
 class DAT: public RawSectorDump<256> {
 	public:
-		DAT(const std::string &file_name);
+		DAT(const std::string &file_name, bool copy_on_write = false);
 };
 
 }
@@ -19,7 +19,7 @@ namespace Storage::MassStorage {
 */
 class DSK: public RawSectorDump<512> {
 	public:
-		DSK(const std::string &file_name);
+		DSK(const std::string &file_name, bool copy_on_write = false);
 };
 
 }
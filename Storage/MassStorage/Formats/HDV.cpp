@@ -12,10 +12,10 @@
 
 using namespace Storage::MassStorage;
 
-HDV::HDV(const std::string &file_name, long start, long size):
-	file_(file_name),
+HDV::HDV(const std::string &file_name, long start, long size, bool copy_on_write):
+	image_(file_name, copy_on_write),
 	file_start_(start),
-	image_size_(std::min(size, long(file_.stats().st_size)))
+	image_size_(std::min(size, long(image_.file().stats().st_size)))
 {
 	mapper_.set_drive_type(
 		Storage::MassStorage::Encodings::Apple::DriveType::SCSI,
@@ -31,28 +31,32 @@ size_t HDV::get_number_of_blocks() {
 	return mapper_.get_number_of_blocks();
 }
 
-std::vector<uint8_t> HDV::get_block(size_t address) {
+Storage::ByteView HDV::get_block_view(size_t address) {
 	const auto source_address = mapper_.to_source_address(address);
 	const auto file_offset = offset_for_block(source_address);
 
 	if(source_address >= 0) {
-		file_.seek(file_offset, SEEK_SET);
-		return mapper_.convert_source_block(source_address, file_.read(get_block_size()));
+		// Blocks from the volume itself are passed through unmodified by the mapper.
+		return image_.read(file_offset, get_block_size());
 	} else {
-		return mapper_.convert_source_block(source_address);
+		synthesised_block_ = mapper_.convert_source_block(source_address);
+		return synthesised_block_;
 	}
 }
 
-void HDV::set_block(size_t address, const std::vector<uint8_t> &data) {
+void HDV::set_block(size_t address, ByteView data) {
 	const auto source_address = mapper_.to_source_address(address);
 	const auto file_offset = offset_for_block(source_address);
 
 	if(source_address >= 0 && file_offset >= 0) {
-		file_.seek(file_offset, SEEK_SET);
-		file_.write(data);
+		image_.write(file_offset, data);
 	}
 }
 
+void HDV::flush() {
+	image_.flush();
+}
+
 long HDV::offset_for_block(ssize_t address) {
 	if(address < 0) return -1;
 
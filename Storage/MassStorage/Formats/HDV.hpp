@@ -9,7 +9,7 @@
 #pragma once
 
 #include "../MassStorageDevice.hpp"
-#include "../../FileHolder.hpp"
+#include "../ImageFile.hpp"
 #include "../Encodings/AppleIIVolume.hpp"
 
 #include <limits>
@@ -30,10 +30,10 @@ class HDV: public MassStorageDevice {
 			Raises an exception if the file name doesn't appear to identify a valid
 			Apple II mass storage image.
 		*/
-		HDV(const std::string &file_name, long start = 0, long size = std::numeric_limits<long>::max());
+		HDV(const std::string &file_name, long start = 0, long size = std::numeric_limits<long>::max(), bool copy_on_write = false);
 
 	private:
-		FileHolder file_;
+		ImageFile image_;
 		long file_start_, image_size_;
 		Storage::MassStorage::Encodings::AppleII::Mapper mapper_;
 
@@ -44,8 +44,11 @@ class HDV: public MassStorageDevice {
 		/* MassStorageDevices overrides. */
 		size_t get_block_size() final;
 		size_t get_number_of_blocks() final;
-		std::vector<uint8_t> get_block(size_t address) final;
-		void set_block(size_t address, const std::vector<uint8_t> &) final;
+		ByteView get_block_view(size_t address) final;
+		void set_block(size_t address, ByteView) final;
+		void flush() final;
+
+		std::vector<uint8_t> synthesised_block_;
 };
 
 }
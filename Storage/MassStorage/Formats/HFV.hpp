@@ -9,7 +9,7 @@
 #pragma once
 
 #include "../MassStorageDevice.hpp"
-#include "../../FileHolder.hpp"
+#include "../ImageFile.hpp"
 #include "../Encodings/MacintoshVolume.hpp"
 
 #include <vector>
@@ -27,18 +27,22 @@ class HFV: public MassStorageDevice, public Encodings::Macintosh::Volume {
 			Constructs an HFV with the contents of the file named @c file_name.
 			Raises an exception if the file name doesn't appear to identify a valid
 			Macintosh mass storage image.
+
+			If @c copy_on_write is @c true then the file will never be modified; writes will be retained in memory only.
 		*/
-		HFV(const std::string &file_name);
+		HFV(const std::string &file_name, bool copy_on_write = false);
 
 	private:
-		FileHolder file_;
+		ImageFile image_;
+		std::vector<uint8_t> synthesised_block_;
 		Encodings::Macintosh::Mapper mapper_;
 
 		/* MassStorageDevices overrides. */
 		size_t get_block_size() final;
 		size_t get_number_of_blocks() final;
-		std::vector<uint8_t> get_block(size_t address) final;
-		void set_block(size_t address, const std::vector<uint8_t> &) final;
+		ByteView get_block_view(size_t address) final;
+		void set_block(size_t address, ByteView) final;
+		void flush() final;
 
 		/* Encodings::Macintosh::Volume overrides. */
 		void set_drive_type(Encodings::Macintosh::DriveType) final;
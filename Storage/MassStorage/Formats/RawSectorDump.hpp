@@ -9,7 +9,7 @@
 #pragma once
 
 #include "../MassStorageDevice.hpp"
-#include "../../FileHolder.hpp"
+#include "../ImageFile.hpp"
 
 #include <cassert>
 
@@ -17,9 +17,9 @@ namespace Storage::MassStorage {
 
 template <long sector_size> class RawSectorDump: public MassStorageDevice {
 	public:
-		RawSectorDump(const std::string &file_name, long offset = 0, long length = -1) :
-			file_(file_name),
-			file_size_((length == -1) ? long(file_.stats().st_size) : length),
+		RawSectorDump(const std::string &file_name, long offset = 0, long length = -1, bool copy_on_write = false) :
+			image_(file_name, copy_on_write),
+			file_size_((length == -1) ? long(image_.file().stats().st_size) : length),
 			file_start_(offset)
 		{
 			// Is the file a multiple of sector_size bytes in size?
@@ -35,19 +35,21 @@ template <long sector_size> class RawSectorDump: public MassStorageDevice {
 			return size_t(file_size_ / sector_size);
 		}
 
-		std::vector<uint8_t> get_block(size_t address) final {
-			file_.seek(file_start_ + long(address * sector_size), SEEK_SET);
-			return file_.read(sector_size);
+		ByteView get_block_view(size_t address) final {
+			return image_.read(file_start_ + long(address * sector_size), sector_size);
 		}
 
-		void set_block(size_t address, const std::vector<uint8_t> &contents) final {
-			assert(contents.size() == sector_size);
-			file_.seek(file_start_ + long(address * sector_size), SEEK_SET);
-			file_.write(contents);
+		void set_block(size_t address, ByteView contents) final {
+			assert(contents.size == sector_size);
+			image_.write(file_start_ + long(address * sector_size), contents);
+		}
+
+		void flush() final {
+			image_.flush();
 		}
 
 	private:
-		FileHolder file_;
+		ImageFile image_;
 		const long file_size_, file_start_;
 };
 
@@ -0,0 +1,112 @@
+//
+//  ImageFile.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#pragma once
+
+#include "MassStorageDevice.hpp"
+#include "../FileHolder.hpp"
+#include "../MappedFile.hpp"
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Storage::MassStorage {
+
+/*!
+	Provides access to the contents of a mass storage image file, via a memory mapping where
+	possible and via a @c FileHolder otherwise.
+
+	Writes to a mapped file reach the page cache immediately and are written back to the file
+	asynchronously, until @c flush is called.
+
+	If constructed with @c copy_on_write, or if the file can be opened only for reading, writes
+	are retained in memory as an overlay and the file itself is never modified.
+*/
+class ImageFile {
+	public:
+		ImageFile(const std::string &file_name, bool copy_on_write = false) :
+			file_(file_name),
+			copy_on_write_(copy_on_write || file_.get_is_known_read_only())
+		{
+			try {
+				mapping_.emplace(file_name, copy_on_write_ ? MappedFile::Mode::CopyOnWrite : MappedFile::Mode::ReadWrite);
+			} catch(MappedFile::Error) {}
+		}
+
+		/// @returns The underlying file.
+		FileHolder &file() {
+			return file_;
+		}
+
+		/*!
+			@returns A view of the @c length bytes at @c offset, or of as many as exist if that range
+				extends beyond the end of the file. The view remains valid until the next call to
+				@c read or @c write.
+		*/
+		ByteView read(long offset, size_t length) {
+			if(mapping_ && offset >= 0 && size_t(offset) + length <= mapping_->size()) {
+				return ByteView(mapping_->data() + offset, length);
+			}
+
+			if(copy_on_write_) {
+				const auto written = overlay_.find(offset);
+				if(written != overlay_.end()) {
+					return written->second;
+				}
+			}
+
+			file_.seek(offset, SEEK_SET);
+			buffer_ = file_.read(length);
+			return buffer_;
+		}
+
+		/*!
+			Writes @c contents to @c offset.
+		*/
+		void write(long offset, ByteView contents) {
+			if(mapping_ && offset >= 0 && size_t(offset) + contents.size <= mapping_->size()) {
+				std::memcpy(mapping_->data() + offset, contents.data, contents.size);
+				mapping_->schedule_flush(size_t(offset), contents.size);
+				return;
+			}
+
+			if(copy_on_write_) {
+				overlay_[offset] = std::vector<uint8_t>(contents.begin(), contents.end());
+				return;
+			}
+
+			file_.seek(offset, SEEK_SET);
+			file_.write(contents.data, contents.size);
+		}
+
+		/*!
+			Blocks until all writes have been committed to the file, if they are destined for it.
+		*/
+		void flush() {
+			if(mapping_) {
+				mapping_->flush();
+			} else {
+				file_.flush();
+			}
+		}
+
+	private:
+		FileHolder file_;
+		const bool copy_on_write_;
+		std::optional<MappedFile> mapping_;
+
+		// Storage for contents that are read from rather than mapped to the file, or written
+		// without a mapping in copy-on-write mode.
+		std::vector<uint8_t> buffer_;
+		std::unordered_map<long, std::vector<uint8_t>> overlay_;
+};
+
+}
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "../ByteView.hpp"
+
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -43,14 +45,28 @@ class MassStorageDevice {
 		virtual size_t get_number_of_blocks() = 0;
 
 		/*!
-			@returns The current contents of the block at @c address.
+			@returns The current contents of the block at @c address. The view is valid only until the
+				next call to any method of this device.
+		*/
+		virtual ByteView get_block_view(size_t address) = 0;
+
+		/*!
+			@returns A copy of the current contents of the block at @c address.
 		*/
-		virtual std::vector<uint8_t> get_block(size_t address) = 0;
+		std::vector<uint8_t> get_block(size_t address) {
+			const auto block = get_block_view(address);
+			return std::vector<uint8_t>(block.begin(), block.end());
+		}
 
 		/*!
 			Sets new contents for the block at @c address.
 		*/
-		virtual void set_block([[maybe_unused]] size_t address, const std::vector<uint8_t> &) {}
+		virtual void set_block([[maybe_unused]] size_t address, ByteView) {}
+
+		/*!
+			Blocks until all contents supplied via @c set_block have been committed to the underlying storage.
+		*/
+		virtual void flush() {}
 };
 
 }
@@ -17,7 +17,12 @@ Log::Logger<Log::Source::DirectAccessDevice> logger;
 
 }
 
+DirectAccessDevice::~DirectAccessDevice() {
+	if(device_) device_->flush();
+}
+
 void DirectAccessDevice::set_storage(const std::shared_ptr<Storage::MassStorage::MassStorageDevice> &device) {
+	if(device_) device_->flush();
 	device_ = device;
 }
 
@@ -27,10 +32,11 @@ bool DirectAccessDevice::read(const Target::CommandState &state, Target::Respond
 	const auto specs = state.read_write_specs();
 	logger.info().append("Read: %d from %d", specs.number_of_blocks, specs.address);
 
-	std::vector<uint8_t> output = device_->get_block(specs.address);
-	for(uint32_t offset = 1; offset < specs.number_of_blocks; ++offset) {
-		const auto next_block = device_->get_block(specs.address + offset);
-		std::copy(next_block.begin(), next_block.end(), std::back_inserter(output));
+	std::vector<uint8_t> output;
+	output.reserve(device_->get_block_size() * specs.number_of_blocks);
+	for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
+		const auto next_block = device_->get_block_view(specs.address + offset);
+		output.insert(output.end(), next_block.begin(), next_block.end());
 	}
 
 	responder.send_data(std::move(output), [] (const Target::CommandState &, Target::Responder &responder) {
@@ -47,12 +53,13 @@ bool DirectAccessDevice::write(const Target::CommandState &state, Target::Respon
 	logger.info().append("Write: %d to %d", specs.number_of_blocks, specs.address);
 
 	responder.receive_data(device_->get_block_size() * specs.number_of_blocks, [this, specs] (const Target::CommandState &state, Target::Responder &responder) {
-		const auto received_data = state.received_data();
-		const auto block_size = ssize_t(device_->get_block_size());
+		const auto &received_data = state.received_data();
+		const auto block_size = device_->get_block_size();
 		for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
-			// TODO: clean up this gross inefficiency when std::span is standard.
-			std::vector<uint8_t> sub_vector(received_data.begin() + ssize_t(offset)*block_size, received_data.begin() + ssize_t(offset+1)*block_size);
-			this->device_->set_block(specs.address + offset, sub_vector);
+			this->device_->set_block(
+				specs.address + offset,
+				Storage::ByteView(&received_data[offset * block_size], block_size)
+			);
 		}
 		responder.terminate_command(Target::Responder::Status::Good);
 	});
@@ -17,9 +17,11 @@ namespace SCSI {
 
 class DirectAccessDevice: public Target::Executor {
 	public:
+		~DirectAccessDevice();
 
 		/*!
-			Sets the backing storage exposed by this direct-access device.
+			Sets the backing storage exposed by this direct-access device, first flushing
+			any writes to the storage it replaces.
 		*/
 		void set_storage(const std::shared_ptr<Storage::MassStorage::MassStorageDevice> &device);
 
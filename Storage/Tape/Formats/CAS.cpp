@@ -168,10 +168,18 @@ CAS::CAS(const std::string &file_name) {
 	}
 }
 
-bool CAS::is_at_end() {
+bool CAS::virtual_is_at_end() {
 	return phase_ == Phase::EndOfFile;
 }
 
+std::size_t CAS::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	return fill(
+		target, count,
+		[this] { return CAS::virtual_get_next_pulse(); },
+		[this] { return CAS::virtual_is_at_end(); }
+	);
+}
+
 void CAS::virtual_reset() {
 	phase_ = Phase::Header;
 	chunk_pointer_ = 0;
@@ -179,6 +187,18 @@ void CAS::virtual_reset() {
 	distance_into_bit_ = 0;
 }
 
+std::any CAS::get_resume_state() {
+	return ResumeState{chunk_pointer_, phase_, distance_into_phase_, distance_into_bit_};
+}
+
+void CAS::set_resume_state(const std::any &state) {
+	const auto &resume_state = std::any_cast<const ResumeState &>(state);
+	chunk_pointer_ = resume_state.chunk_pointer;
+	phase_ = resume_state.phase;
+	distance_into_phase_ = resume_state.distance_into_phase;
+	distance_into_bit_ = resume_state.distance_into_bit;
+}
+
 Tape::Pulse CAS::virtual_get_next_pulse() {
 	Pulse pulse;
 	pulse.length.clock_rate = 9600;
@@ -33,12 +33,11 @@ class CAS: public Tape {
 			ErrorNotCAS
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		std::size_t virtual_get_next_pulses(Pulse *, std::size_t);
+		bool virtual_is_at_end();
 
 		// Storage for the array of data blobs to transcribe into audio;
 		// each chunk is preceded by a header which may be long, and is optionally
@@ -63,6 +62,15 @@ class CAS: public Tape {
 		} phase_ = Phase::Header;
 		std::size_t distance_into_phase_ = 0;
 		std::size_t distance_into_bit_ = 0;
+
+		struct ResumeState {
+			std::size_t chunk_pointer;
+			Phase phase;
+			std::size_t distance_into_phase;
+			std::size_t distance_into_bit;
+		};
+		std::any get_resume_state();
+		void set_resume_state(const std::any &);
 };
 
 }
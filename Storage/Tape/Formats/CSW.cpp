@@ -16,7 +16,7 @@ using namespace Storage::Tape;
 
 CSW::CSW(const std::string &file_name) :
 	source_data_pointer_(0) {
-	Storage::FileHolder file(file_name);
+	Storage::FileHolder file(file_name, FileHolder::FileMode::Map);
 	if(file.stats().st_size < 0x20) throw ErrorNotCSW;
 
 	// Check signature.
@@ -62,10 +62,7 @@ CSW::CSW(const std::string &file_name) :
 	}
 
 	// Grab all data remaining in the file.
-	std::vector<uint8_t> file_data;
-	std::size_t remaining_data = size_t(file.stats().st_size) - size_t(file.tell());
-	file_data.resize(remaining_data);
-	file.read(file_data.data(), remaining_data);
+	const auto file_data = file.read_view(size_t(file.stats().st_size) - size_t(file.tell()));
 
 	if(compression_type_ == CompressionType::ZRLE) {
 		// The only clue given by CSW as to the output size in bytes is that there will be
@@ -77,18 +74,19 @@ CSW::CSW(const std::string &file_name) :
 		// modification of output_length to throw away all the memory that isn't actually
 		// needed.
 		uLongf output_length = uLongf(number_of_waves * 5);
-		uncompress(source_data_.data(), &output_length, file_data.data(), file_data.size());
+		uncompress(source_data_.data(), &output_length, file_data.data, file_data.size);
 		source_data_.resize(std::size_t(output_length));
 	} else {
-		source_data_ = std::move(file_data);
+		source_data_.assign(file_data.begin(), file_data.end());
 	}
 
 	invert_pulse();
+	initial_type_ = pulse_.type;
 }
 
 CSW::CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate) : compression_type_(compression_type) {
 	pulse_.length.clock_rate = sampling_rate;
-	pulse_.type = initial_level ? Pulse::High : Pulse::Low;
+	pulse_.type = initial_type_ = initial_level ? Pulse::High : Pulse::Low;
 	source_data_ = std::move(data);
 }
 
@@ -114,12 +112,31 @@ void CSW::invert_pulse() {
 	pulse_.type = (pulse_.type == Pulse::High) ? Pulse::Low : Pulse::High;
 }
 
-bool CSW::is_at_end() {
+bool CSW::virtual_is_at_end() {
 	return source_data_pointer_ == source_data_.size();
 }
 
+std::size_t CSW::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	return fill(
+		target, count,
+		[this] { return CSW::virtual_get_next_pulse(); },
+		[this] { return CSW::virtual_is_at_end(); }
+	);
+}
+
 void CSW::virtual_reset() {
 	source_data_pointer_ = 0;
+	pulse_.type = initial_type_;
+}
+
+std::any CSW::get_resume_state() {
+	return ResumeState{pulse_, source_data_pointer_};
+}
+
+void CSW::set_resume_state(const std::any &state) {
+	const auto &resume_state = std::any_cast<const ResumeState &>(state);
+	pulse_ = resume_state.pulse;
+	source_data_pointer_ = resume_state.source_data_pointer;
 }
 
 Tape::Pulse CSW::virtual_get_next_pulse() {
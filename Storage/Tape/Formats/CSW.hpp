@@ -42,14 +42,14 @@ class CSW: public Tape {
 			ErrorNotCSW
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		std::size_t virtual_get_next_pulses(Pulse *, std::size_t);
+		bool virtual_is_at_end();
 
 		Pulse pulse_;
+		Pulse::Type initial_type_;
 		CompressionType compression_type_;
 
 		uint8_t get_next_byte();
@@ -58,6 +58,13 @@ class CSW: public Tape {
 
 		std::vector<uint8_t> source_data_;
 		std::size_t source_data_pointer_;
+
+		struct ResumeState {
+			Pulse pulse;
+			std::size_t source_data_pointer;
+		};
+		std::any get_resume_state();
+		void set_resume_state(const std::any &);
 };
 
 }
@@ -45,10 +45,29 @@ void CommodoreTAP::virtual_reset() {
 	is_at_end_ = false;
 }
 
-bool CommodoreTAP::is_at_end() {
+bool CommodoreTAP::virtual_is_at_end() {
 	return is_at_end_;
 }
 
+std::size_t CommodoreTAP::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	return fill(
+		target, count,
+		[this] { return CommodoreTAP::virtual_get_next_pulse(); },
+		[this] { return CommodoreTAP::virtual_is_at_end(); }
+	);
+}
+
+std::any CommodoreTAP::get_resume_state() {
+	return ResumeState{file_.cursor(), current_pulse_, is_at_end_};
+}
+
+void CommodoreTAP::set_resume_state(const std::any &state) {
+	const auto &resume_state = std::any_cast<const ResumeState &>(state);
+	file_.set_cursor(resume_state.cursor);
+	current_pulse_ = resume_state.current_pulse;
+	is_at_end_ = resume_state.is_at_end;
+}
+
 Storage::Tape::Tape::Pulse CommodoreTAP::virtual_get_next_pulse() {
 	if(is_at_end_) {
 		return current_pulse_;
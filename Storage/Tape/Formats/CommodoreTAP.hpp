@@ -32,19 +32,26 @@ class CommodoreTAP: public Tape {
 			ErrorNotCommodoreTAP
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		Storage::FileHolder file_;
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		std::size_t virtual_get_next_pulses(Pulse *, std::size_t);
+		bool virtual_is_at_end();
 
 		bool updated_layout_;
 		uint32_t file_size_;
 
 		Pulse current_pulse_;
 		bool is_at_end_ = false;
+
+		struct ResumeState {
+			Storage::FileHolder::Cursor cursor;
+			Pulse current_pulse;
+			bool is_at_end;
+		};
+		std::any get_resume_state();
+		void set_resume_state(const std::any &);
 };
 
 }
@@ -41,6 +41,28 @@ void OricTAP::virtual_reset() {
 	pulse_counter_ = 0;
 }
 
+std::any OricTAP::get_resume_state() {
+	return ResumeState{
+		file_.cursor(),
+		current_value_, bit_count_, pulse_counter_,
+		phase_, next_phase_, phase_counter_,
+		data_end_address_, data_start_address_
+	};
+}
+
+void OricTAP::set_resume_state(const std::any &state) {
+	const auto &resume_state = std::any_cast<const ResumeState &>(state);
+	file_.set_cursor(resume_state.cursor);
+	current_value_ = resume_state.current_value;
+	bit_count_ = resume_state.bit_count;
+	pulse_counter_ = resume_state.pulse_counter;
+	phase_ = resume_state.phase;
+	next_phase_ = resume_state.next_phase;
+	phase_counter_ = resume_state.phase_counter;
+	data_end_address_ = resume_state.data_end_address;
+	data_start_address_ = resume_state.data_start_address;
+}
+
 Tape::Pulse OricTAP::virtual_get_next_pulse() {
 	// Each byte byte is written as 13 bits: 0, eight bits of data, parity, three 1s.
 	if(bit_count_ == 13) {
@@ -158,6 +180,14 @@ Tape::Pulse OricTAP::virtual_get_next_pulse() {
 	return pulse;
 }
 
-bool OricTAP::is_at_end() {
+bool OricTAP::virtual_is_at_end() {
 	return phase_ == End;
 }
+
+std::size_t OricTAP::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	return fill(
+		target, count,
+		[this] { return OricTAP::virtual_get_next_pulse(); },
+		[this] { return OricTAP::virtual_is_at_end(); }
+	);
+}
@@ -32,13 +32,12 @@ class OricTAP: public Tape {
 			ErrorNotOricTAP
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		Storage::FileHolder file_;
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		std::size_t virtual_get_next_pulses(Pulse *, std::size_t);
+		bool virtual_is_at_end();
 
 		// byte serialisation and output
 		uint16_t current_value_;
@@ -50,6 +49,18 @@ class OricTAP: public Tape {
 		} phase_, next_phase_;
 		int phase_counter_;
 		uint16_t data_end_address_, data_start_address_;
+
+		struct ResumeState {
+			Storage::FileHolder::Cursor cursor;
+			uint16_t current_value;
+			int bit_count;
+			int pulse_counter;
+			Phase phase, next_phase;
+			int phase_counter;
+			uint16_t data_end_address, data_start_address;
+		};
+		std::any get_resume_state();
+		void set_resume_state(const std::any &);
 };
 
 }
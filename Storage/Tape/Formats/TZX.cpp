@@ -22,7 +22,7 @@ Log::Logger<Log::Source::TZX> logger;
 }
 
 TZX::TZX(const std::string &file_name) :
-	file_(file_name),
+	file_(file_name, FileHolder::FileMode::Map),
 	current_level_(false) {
 
 	// Check for signature followed by a 0x1a
@@ -51,6 +51,16 @@ void TZX::virtual_reset() {
 	post_gap(500);
 }
 
+std::any TZX::get_source_state() {
+	return SourceState{file_.cursor(), current_level_};
+}
+
+void TZX::set_source_state(const std::any &state) {
+	const auto &source_state = std::any_cast<const SourceState &>(state);
+	file_.set_cursor(source_state.cursor);
+	current_level_ = source_state.current_level;
+}
+
 void TZX::get_next_pulses() {
 	while(empty()) {
 		uint8_t chunk_id = file_.get8();
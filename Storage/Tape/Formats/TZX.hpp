@@ -39,6 +39,13 @@ class TZX: public PulseQueuedTape {
 
 		bool current_level_;
 
+		struct SourceState {
+			Storage::FileHolder::Cursor cursor;
+			bool current_level;
+		};
+		std::any get_source_state();
+		void set_source_state(const std::any &);
+
 		void get_standard_speed_data_block();
 		void get_turbo_speed_data_block();
 		void get_pure_tone_data_block();
@@ -95,10 +95,38 @@ void PRG::virtual_reset() {
 	copy_mask_ = 0x80;
 }
 
-bool PRG::is_at_end() {
+bool PRG::virtual_is_at_end() {
 	return file_phase_ == FilePhaseAtEnd;
 }
 
+std::size_t PRG::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	return fill(
+		target, count,
+		[this] { return PRG::virtual_get_next_pulse(); },
+		[this] { return PRG::virtual_is_at_end(); }
+	);
+}
+
+std::any PRG::get_resume_state() {
+	return ResumeState{
+		file_.cursor(),
+		file_phase_, phase_offset_, bit_phase_,
+		output_token_, output_byte_, check_digit_, copy_mask_
+	};
+}
+
+void PRG::set_resume_state(const std::any &state) {
+	const auto &resume_state = std::any_cast<const ResumeState &>(state);
+	file_.set_cursor(resume_state.cursor);
+	file_phase_ = resume_state.file_phase;
+	phase_offset_ = resume_state.phase_offset;
+	bit_phase_ = resume_state.bit_phase;
+	output_token_ = resume_state.output_token;
+	output_byte_ = resume_state.output_byte;
+	check_digit_ = resume_state.check_digit;
+	copy_mask_ = resume_state.copy_mask;
+}
+
 void PRG::get_next_output_token() {
 	constexpr int block_length = 192;	// not counting the checksum
 	constexpr int countdown_bytes = 9;
@@ -33,13 +33,12 @@ class PRG: public Tape {
 			ErrorBadFormat
 		};
 
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 	private:
 		FileHolder file_;
 		Pulse virtual_get_next_pulse();
 		void virtual_reset();
+		std::size_t virtual_get_next_pulses(Pulse *, std::size_t);
+		bool virtual_is_at_end();
 
 		uint16_t load_address_;
 		uint16_t length_;
@@ -66,6 +65,19 @@ class PRG: public Tape {
 		uint8_t output_byte_;
 		uint8_t check_digit_;
 		uint8_t copy_mask_ = 0x80;
+
+		struct ResumeState {
+			Storage::FileHolder::Cursor cursor;
+			FilePhase file_phase;
+			int phase_offset;
+			int bit_phase;
+			OutputToken output_token;
+			uint8_t output_byte;
+			uint8_t check_digit;
+			uint8_t copy_mask;
+		};
+		std::any get_resume_state();
+		void set_resume_state(const std::any &);
 };
 
 }
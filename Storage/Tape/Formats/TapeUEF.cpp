@@ -103,10 +103,23 @@ UEF::~UEF() {
 
 void UEF::virtual_reset() {
 	gzseek(file_, 12, SEEK_SET);
+	time_base_ = 1200;
+	is_300_baud_ = false;
 	set_is_at_end(false);
 	clear();
 }
 
+std::any UEF::get_source_state() {
+	return SourceState{gztell(file_), time_base_, is_300_baud_};
+}
+
+void UEF::set_source_state(const std::any &state) {
+	const auto &source_state = std::any_cast<const SourceState &>(state);
+	gzseek(file_, source_state.position, SEEK_SET);
+	time_base_ = source_state.time_base;
+	is_300_baud_ = source_state.is_300_baud;
+}
+
 // MARK: - Chunk navigator
 
 bool UEF::get_next_chunk(UEF::Chunk &result) {
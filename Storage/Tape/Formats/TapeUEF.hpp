@@ -55,6 +55,14 @@ class UEF : public PulseQueuedTape, public TargetPlatform::TypeDistinguisher {
 		bool get_next_chunk(Chunk &);
 		void get_next_pulses();
 
+		struct SourceState {
+			z_off_t position;
+			unsigned int time_base;
+			bool is_300_baud;
+		};
+		std::any get_source_state();
+		void set_source_state(const std::any &);
+
 		void queue_implicit_bit_pattern(uint32_t length);
 		void queue_explicit_bit_pattern(uint32_t length);
 
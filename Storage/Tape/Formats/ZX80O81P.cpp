@@ -42,14 +42,41 @@ void ZX80O81P::virtual_reset() {
 	bit_pointer_ = wave_pointer_ = 0;
 }
 
+std::any ZX80O81P::get_resume_state() {
+	return ResumeState{
+		byte_, bit_pointer_, wave_pointer_,
+		is_past_silence_, has_ended_final_byte_, is_high_,
+		data_pointer_
+	};
+}
+
+void ZX80O81P::set_resume_state(const std::any &state) {
+	const auto &resume_state = std::any_cast<const ResumeState &>(state);
+	byte_ = resume_state.byte;
+	bit_pointer_ = resume_state.bit_pointer;
+	wave_pointer_ = resume_state.wave_pointer;
+	is_past_silence_ = resume_state.is_past_silence;
+	has_ended_final_byte_ = resume_state.has_ended_final_byte;
+	is_high_ = resume_state.is_high;
+	data_pointer_ = resume_state.data_pointer;
+}
+
 bool ZX80O81P::has_finished_data() {
 	return (data_pointer_ == data_.size()) && !wave_pointer_ && !bit_pointer_;
 }
 
-bool ZX80O81P::is_at_end() {
+bool ZX80O81P::virtual_is_at_end() {
 	return has_finished_data() && has_ended_final_byte_;
 }
 
+std::size_t ZX80O81P::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	return fill(
+		target, count,
+		[this] { return ZX80O81P::virtual_get_next_pulse(); },
+		[this] { return ZX80O81P::virtual_is_at_end(); }
+	);
+}
+
 Tape::Pulse ZX80O81P::virtual_get_next_pulse() {
 	Tape::Pulse pulse;
 
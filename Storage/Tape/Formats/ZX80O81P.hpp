@@ -36,15 +36,15 @@ class ZX80O81P: public Tape, public TargetPlatform::TypeDistinguisher {
 		};
 
 	private:
-		// implemented to satisfy @c Tape
-		bool is_at_end();
-
 		// implemented to satisfy TargetPlatform::TypeDistinguisher
 		TargetPlatform::Type target_platform_type();
 		TargetPlatform::Type platform_type_;
 
+		// implemented to satisfy @c Tape
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		std::size_t virtual_get_next_pulses(Pulse *, std::size_t);
+		bool virtual_is_at_end();
 		bool has_finished_data();
 
 		uint8_t byte_;
@@ -55,6 +55,17 @@ class ZX80O81P: public Tape, public TargetPlatform::TypeDistinguisher {
 
 		std::vector<uint8_t> data_;
 		std::size_t data_pointer_;
+
+		struct ResumeState {
+			uint8_t byte;
+			int bit_pointer;
+			int wave_pointer;
+			bool is_past_silence, has_ended_final_byte;
+			bool is_high;
+			std::size_t data_pointer;
+		};
+		std::any get_resume_state();
+		void set_resume_state(const std::any &);
 };
 
 }
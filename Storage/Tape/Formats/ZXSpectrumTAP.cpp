@@ -37,15 +37,37 @@ ZXSpectrumTAP::ZXSpectrumTAP(const std::string &file_name) :
 	virtual_reset();
 }
 
-bool ZXSpectrumTAP::is_at_end() {
+bool ZXSpectrumTAP::virtual_is_at_end() {
 	return file_.tell() == file_.stats().st_size && phase_ == Phase::Gap;
 }
 
+std::size_t ZXSpectrumTAP::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	return fill(
+		target, count,
+		[this] { return ZXSpectrumTAP::virtual_get_next_pulse(); },
+		[this] { return ZXSpectrumTAP::virtual_is_at_end(); }
+	);
+}
+
 void ZXSpectrumTAP::virtual_reset() {
 	file_.seek(0, SEEK_SET);
 	read_next_block();
 }
 
+std::any ZXSpectrumTAP::get_resume_state() {
+	return ResumeState{file_.cursor(), block_length_, block_type_, data_byte_, phase_, distance_into_phase_};
+}
+
+void ZXSpectrumTAP::set_resume_state(const std::any &state) {
+	const auto &resume_state = std::any_cast<const ResumeState &>(state);
+	file_.set_cursor(resume_state.cursor);
+	block_length_ = resume_state.block_length;
+	block_type_ = resume_state.block_type;
+	data_byte_ = resume_state.data_byte;
+	phase_ = resume_state.phase;
+	distance_into_phase_ = resume_state.distance_into_phase;
+}
+
 Tape::Pulse ZXSpectrumTAP::virtual_get_next_pulse() {
 	// Adopt a general pattern of high then low.
 	Pulse pulse;
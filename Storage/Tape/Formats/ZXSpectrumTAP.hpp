@@ -47,10 +47,22 @@ class ZXSpectrumTAP: public Tape {
 		int distance_into_phase_ = 0;
 		void read_next_block();
 
+		struct ResumeState {
+			Storage::FileHolder::Cursor cursor;
+			uint16_t block_length;
+			uint8_t block_type;
+			uint8_t data_byte;
+			Phase phase;
+			int distance_into_phase;
+		};
+		std::any get_resume_state() override;
+		void set_resume_state(const std::any &) override;
+
 		// Implemented to satisfy @c Tape.
-		bool is_at_end() override;
+		bool virtual_is_at_end() override;
 		void virtual_reset() override;
 		Pulse virtual_get_next_pulse() override;
+		std::size_t virtual_get_next_pulses(Pulse *, std::size_t) override;
 };
 
 }
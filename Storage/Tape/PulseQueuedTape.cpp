@@ -8,11 +8,13 @@
 
 #include "PulseQueuedTape.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Tape;
 
 PulseQueuedTape::PulseQueuedTape() : pulse_pointer_(0), is_at_end_(false) {}
 
-bool PulseQueuedTape::is_at_end() {
+bool PulseQueuedTape::virtual_is_at_end() {
 	return is_at_end_;
 }
 
@@ -23,6 +25,7 @@ void PulseQueuedTape::set_is_at_end(bool is_at_end) {
 void PulseQueuedTape::clear() {
 	queued_pulses_.clear();
 	pulse_pointer_ = 0;
+	batch_state_.reset();
 }
 
 bool PulseQueuedTape::empty() {
@@ -45,21 +48,66 @@ Tape::Pulse PulseQueuedTape::silence() {
 	return silence;
 }
 
-Tape::Pulse PulseQueuedTape::virtual_get_next_pulse() {
+bool PulseQueuedTape::get_next_batch() {
 	if(is_at_end_) {
-		return silence();
+		return false;
 	}
 
 	if(pulse_pointer_ == queued_pulses_.size()) {
 		clear();
+		batch_state_ = get_source_state();
 		get_next_pulses();
 
 		if(is_at_end_ || pulse_pointer_ == queued_pulses_.size()) {
-			return silence();
+			return false;
 		}
 	}
 
+	return true;
+}
+
+Tape::Pulse PulseQueuedTape::virtual_get_next_pulse() {
+	if(!get_next_batch()) {
+		return silence();
+	}
+
 	std::size_t read_pointer = pulse_pointer_;
 	pulse_pointer_++;
 	return queued_pulses_[read_pointer];
 }
+
+std::size_t PulseQueuedTape::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	if(!get_next_batch()) {
+		*target = silence();
+		return 1;
+	}
+
+	const std::size_t length = std::min(count, queued_pulses_.size() - pulse_pointer_);
+	std::copy_n(&queued_pulses_[pulse_pointer_], length, target);
+	pulse_pointer_ += length;
+	return length;
+}
+
+std::any PulseQueuedTape::get_resume_state() {
+	// If the current batch has been exhausted then the source state alone is sufficient
+	// to resume; otherwise the batch will need to be regenerated from its original source state.
+	const bool regenerate_batch = pulse_pointer_ != queued_pulses_.size();
+	std::any source_state = regenerate_batch ? batch_state_ : get_source_state();
+	if(!source_state.has_value()) {
+		return {};
+	}
+	return ResumeState{std::move(source_state), regenerate_batch, pulse_pointer_, is_at_end_};
+}
+
+void PulseQueuedTape::set_resume_state(const std::any &state) {
+	const auto &resume_state = std::any_cast<const ResumeState &>(state);
+
+	clear();
+	set_source_state(resume_state.source_state);
+	if(resume_state.regenerate_batch) {
+		batch_state_ = resume_state.source_state;
+		get_next_pulses();
+		pulse_pointer_ = resume_state.pulse_pointer;
+	}
+	is_at_end_ = resume_state.is_at_end;
+}
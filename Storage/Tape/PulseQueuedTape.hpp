@@ -22,11 +22,14 @@ namespace Storage::Tape {
 	Otherwise get_next_pulse() returns something from the pulse queue if there is
 	anything there, and otherwise calls get_next_pulses(). get_next_pulses() is
 	virtual, giving subclasses a chance to provide the next batch of pulses.
+
+	Subclasses that can capture and restore whatever state determines the output of
+	get_next_pulses() may implement get_source_state() and set_source_state(), which
+	will be used to provide checkpoints to the underlying @c Tape.
 */
 class PulseQueuedTape: public Tape {
 	public:
 		PulseQueuedTape();
-		bool is_at_end();
 
 	protected:
 		void emplace_back(Tape::Pulse::Type type, Time length);
@@ -37,13 +40,35 @@ class PulseQueuedTape: public Tape {
 		void set_is_at_end(bool);
 		virtual void get_next_pulses() = 0;
 
+		/*!
+			@returns whatever state would be necessary to repeat the next call to get_next_pulses(),
+				or an empty @c std::any if that isn't possible.
+		*/
+		virtual std::any get_source_state() { return {}; }
+		virtual void set_source_state(const std::any &) {}
+
 	private:
 		Pulse virtual_get_next_pulse();
+		std::size_t virtual_get_next_pulses(Pulse *, std::size_t);
+		bool virtual_is_at_end();
 		Pulse silence();
+		bool get_next_batch();
 
 		std::vector<Pulse> queued_pulses_;
 		std::size_t pulse_pointer_;
 		bool is_at_end_;
+
+		// The source state prior to generation of the current contents of queued_pulses_.
+		std::any batch_state_;
+
+		struct ResumeState {
+			std::any source_state;
+			bool regenerate_batch;
+			std::size_t pulse_pointer;
+			bool is_at_end;
+		};
+		std::any get_resume_state();
+		void set_resume_state(const std::any &);
 };
 
 }
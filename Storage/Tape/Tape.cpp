@@ -8,6 +8,8 @@
 
 #include "Tape.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Tape;
 
 // MARK: - Lifecycle
@@ -19,34 +21,110 @@ TapePlayer::TapePlayer(int input_clock_rate) :
 // MARK: - Seeking
 
 void Storage::Tape::Tape::seek(Time &seek_time) {
-	Time next_time(0);
-	reset();
-	while(next_time <= seek_time) {
-		get_next_pulse();
-		next_time += pulse_.length;
+	last_pulses_.is_valid = false;
+
+	// Resume from the final checkpoint that isn't after seek_time, if that's
+	// nearer than the current position; otherwise go back to the start of the
+	// tape if the current position is after seek_time.
+	const auto next_checkpoint = std::upper_bound(
+		checkpoints_.begin(), checkpoints_.end(), seek_time,
+		[](const Time &time, const Checkpoint &checkpoint) {
+			return time < checkpoint.time;
+		});
+	const bool is_ahead = seek_time < current_time_;
+	if(next_checkpoint != checkpoints_.begin() && (is_ahead || (next_checkpoint - 1)->offset > offset_)) {
+		resume(*(next_checkpoint - 1));
+	} else if(is_ahead) {
+		reset();
 	}
+
+	// Proceed to the first pulse that ends after seek_time.
+	do {
+		get_next_pulse();
+	} while(current_time_ <= seek_time);
 }
 
 Storage::Time Tape::get_current_time() {
-	Time time(0);
-	uint64_t steps = get_offset();
-	reset();
-	while(steps--) {
-		get_next_pulse();
-		time += pulse_.length;
-	}
-	return time;
+	return current_time_;
 }
 
 void Storage::Tape::Tape::reset() {
 	offset_ = 0;
+	current_time_ = Time(0);
+	pulse_pointer_ = pulse_count_ = 0;
+	last_pulses_.is_valid = false;
 	virtual_reset();
 }
 
-Tape::Pulse Tape::get_next_pulse() {
-	pulse_ = virtual_get_next_pulse();
-	offset_++;
-	return pulse_;
+std::size_t Tape::get_next_pulses(Pulse *target, std::size_t count) {
+	if(pulse_pointer_ == pulse_count_) {
+		get_next_batch();
+	}
+
+	// Supply only from the current batch, so that return_pulses can step back within it.
+	count = std::min(count, pulse_count_ - pulse_pointer_);
+	last_pulses_.pulse_pointer = pulse_pointer_;
+	last_pulses_.offset = offset_;
+	last_pulses_.time = current_time_;
+	last_pulses_.is_valid = true;
+
+	for(std::size_t c = 0; c < count; c++) {
+		target[c] = pulses_[pulse_pointer_ + c];
+		current_time_ += target[c].length;
+	}
+	pulse_pointer_ += count;
+	offset_ += count;
+	return count;
+}
+
+void Tape::return_pulses(std::size_t count) {
+	// Pulses can be returned only if the tape is still within the batch from which they were supplied,
+	// and no more can be returned than have been supplied since.
+	if(!last_pulses_.is_valid) return;
+	const std::size_t supplied = pulse_pointer_ - last_pulses_.pulse_pointer;
+	count = std::min(count, supplied);
+	if(!count) return;
+
+	// Rewind to the start of the most recent call to get_next_pulses and replay whatever
+	// wasn't returned, to reproduce exactly the same current time.
+	const std::size_t retained = supplied - count;
+	pulse_pointer_ = last_pulses_.pulse_pointer;
+	offset_ = last_pulses_.offset;
+	current_time_ = last_pulses_.time;
+	for(std::size_t c = 0; c < retained; c++) {
+		get_next_pulse();
+	}
+}
+
+void Tape::get_next_batch() {
+	// The subclass is now exactly in step with offset_, so this is the moment at which to extend
+	// the checkpoint index if this is new territory.
+	if(offset_ >= (checkpoints_.empty() ? 0 : checkpoints_.back().offset) + CheckpointInterval) {
+		auto state = get_resume_state();
+		if(state.has_value()) {
+			checkpoints_.push_back(Checkpoint{offset_, current_time_, std::move(state)});
+		}
+	}
+
+	pulse_count_ = virtual_get_next_pulses(pulses_.data(), pulses_.size());
+	pulse_pointer_ = 0;
+	last_pulses_.is_valid = false;
+}
+
+std::size_t Tape::virtual_get_next_pulses(Pulse *target, std::size_t count) {
+	return fill(
+		target, count,
+		[this] { return virtual_get_next_pulse(); },
+		[this] { return virtual_is_at_end(); }
+	);
+}
+
+void Tape::resume(const Checkpoint &checkpoint) {
+	set_resume_state(checkpoint.state);
+	offset_ = checkpoint.offset;
+	current_time_ = checkpoint.time;
+	pulse_pointer_ = pulse_count_ = 0;
+	last_pulses_.is_valid = false;
 }
 
 uint64_t Tape::get_offset() {
@@ -55,20 +133,36 @@ uint64_t Tape::get_offset() {
 
 void Tape::set_offset(uint64_t offset) {
 	if(offset == offset_) return;
-	if(offset < offset_) {
+	last_pulses_.is_valid = false;
+
+	// Resume from the final checkpoint that isn't after offset, if that's
+	// nearer than the current position.
+	const auto next_checkpoint = std::upper_bound(
+		checkpoints_.begin(), checkpoints_.end(), offset,
+		[](uint64_t offset, const Checkpoint &checkpoint) {
+			return offset < checkpoint.offset;
+		});
+	if(next_checkpoint != checkpoints_.begin() && (offset < offset_ || (next_checkpoint - 1)->offset > offset_)) {
+		resume(*(next_checkpoint - 1));
+	} else if(offset < offset_) {
 		reset();
 	}
-	offset -= offset_;
-	while(offset--) get_next_pulse();
+
+	while(offset_ < offset) get_next_pulse();
 }
 
 // MARK: - Player
 
 ClockingHint::Preference TapePlayer::preferred_clocking() const {
-	return (!tape_ || tape_->is_at_end()) ? ClockingHint::Preference::None : ClockingHint::Preference::JustInTime;
+	return is_at_end() ? ClockingHint::Preference::None : ClockingHint::Preference::JustInTime;
+}
+
+bool TapePlayer::is_at_end() const {
+	return !tape_ || (pulse_pointer_ == pulse_count_ && tape_->is_at_end());
 }
 
 void TapePlayer::set_tape(std::shared_ptr<Storage::Tape::Tape> tape) {
+	return_pulses();
 	tape_ = tape;
 	reset_timer();
 	get_next_pulse();
@@ -76,9 +170,17 @@ void TapePlayer::set_tape(std::shared_ptr<Storage::Tape::Tape> tape) {
 }
 
 std::shared_ptr<Storage::Tape::Tape> TapePlayer::get_tape() {
+	return_pulses();
 	return tape_;
 }
 
+void TapePlayer::return_pulses() {
+	if(tape_) {
+		tape_->return_pulses(pulse_count_ - pulse_pointer_);
+	}
+	pulse_pointer_ = pulse_count_ = 0;
+}
+
 bool TapePlayer::has_tape() {
 	return bool(tape_);
 }
@@ -86,8 +188,13 @@ bool TapePlayer::has_tape() {
 void TapePlayer::get_next_pulse() {
 	// get the new pulse
 	if(tape_) {
-		current_pulse_ = tape_->get_next_pulse();
-		if(tape_->is_at_end()) update_clocking_observer();
+		if(pulse_pointer_ == pulse_count_) {
+			pulse_count_ = tape_->get_next_pulses(pulses_.data(), pulses_.size());
+			pulse_pointer_ = 0;
+		}
+		current_pulse_ = pulses_[pulse_pointer_];
+		++pulse_pointer_;
+		if(is_at_end()) update_clocking_observer();
 	} else {
 		current_pulse_.length.length = 1;
 		current_pulse_.length.clock_rate = 1;
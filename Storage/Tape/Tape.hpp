@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include <any>
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ClockingHintSource.hpp"
@@ -27,8 +30,12 @@ namespace Storage::Tape {
 		- zero pulses run along zero.
 
 	Subclasses should implement at least @c get_next_pulse and @c reset to provide a serial feeding
-	of pulses and the ability to return to the start of the feed. They may also implement @c seek if
-	a better implementation than a linear search from the @c reset time can be implemented.
+	of pulses and the ability to return to the start of the feed. Pulses are requested in batches
+	via @c virtual_get_next_pulses, which subclasses should implement natively if they are able
+	to produce batches more efficiently than individual pulses. Callers can similarly obtain
+	pulses in batches via @c get_next_pulses. They may also implement
+	@c get_resume_state and @c set_resume_state, in which case @c seek and @c set_offset will
+	resume from the nearest of a sparse series of checkpoints rather than from the @c reset time.
 */
 class Tape {
 	public:
@@ -48,13 +55,41 @@ class Tape {
 
 			@returns the pulse that begins at the current cursor position.
 		*/
-		Pulse get_next_pulse();
+		Pulse get_next_pulse() {
+			if(pulse_pointer_ == pulse_count_) {
+				get_next_batch();
+			}
+
+			const Pulse &pulse = pulses_[pulse_pointer_];
+			++pulse_pointer_;
+			++offset_;
+			current_time_ += pulse.length;
+			return pulse;
+		}
+
+		/*!
+			Writes at least one and at most @c count of the next pulses to @c target, advancing past them as if by
+			the equivalent number of calls to @c get_next_pulse. Fewer than @c count pulses may be written even if
+			the tape is not at its end.
+
+			@returns the number of pulses written.
+		*/
+		std::size_t get_next_pulses(Pulse *target, std::size_t count);
+
+		/*!
+			Steps back over the final @c count pulses written by the most recent call to @c get_next_pulses,
+			so that they will be returned again. The tape will step back no further than the start of that
+			call, and not at all if it has since been reset, seeked or otherwise repositioned.
+		*/
+		void return_pulses(std::size_t count);
 
 		/// Returns the tape to the beginning.
 		void reset();
 
 		/// @returns @c true if the tape has progressed beyond all recorded content; @c false otherwise.
-		virtual bool is_at_end() = 0;
+		bool is_at_end() {
+			return pulse_pointer_ == pulse_count_ && virtual_is_at_end();
+		}
 
 		/*!
 			Returns a numerical representation of progression into the tape. Precision is arbitrary but
@@ -69,23 +104,92 @@ class Tape {
 		virtual void set_offset(uint64_t);
 
 		/*!
-			Calculates and returns the amount of time that has elapsed since the time began. Potentially expensive.
+			@returns the amount of time that has elapsed since the tape began, i.e. the total length of all
+			pulses returned since the most recent @c reset.
 		*/
 		virtual Time get_current_time();
 
 		/*!
-			Seeks to @c time. Potentially expensive.
+			Seeks to @c time. Potentially expensive if this tape doesn't support checkpoints.
 		*/
 		virtual void seek(Time &time);
 
 		virtual ~Tape() {};
 
+	protected:
+		/*!
+			May be implemented by subclasses to capture whatever state would be necessary to resume pulse
+			generation from the current position. If so then such states will be captured periodically during
+			playback, providing the checkpoints from which @c seek and @c set_offset can resume.
+
+			@returns the current state, or an empty @c std::any if resumption from here isn't possible.
+		*/
+		virtual std::any get_resume_state() { return {}; }
+
+		/*!
+			Restores a state previously returned by @c get_resume_state.
+		*/
+		virtual void set_resume_state([[maybe_unused]] const std::any &state) {}
+
+		/*!
+			Fills @c target with up to @c count pulses using @c next_pulse, stopping early after any pulse
+			upon which @c is_at_end becomes @c true. Provided for subclasses that generate pulses individually
+			but which wish to implement @c virtual_get_next_pulses without a virtual call per pulse.
+
+			@returns the number of pulses written.
+		*/
+		template <typename NextPulseT, typename IsAtEndT>
+		static std::size_t fill(Pulse *target, std::size_t count, const NextPulseT &next_pulse, const IsAtEndT &is_at_end) {
+			for(std::size_t c = 0; c < count; c++) {
+				target[c] = next_pulse();
+				if(is_at_end()) return c + 1;
+			}
+			return count;
+		}
+
 	private:
-		uint64_t offset_;
-		Tape::Pulse pulse_;
+		uint64_t offset_ = 0;
+		Time current_time_;
 
 		virtual Pulse virtual_get_next_pulse() = 0;
 		virtual void virtual_reset() = 0;
+		virtual bool virtual_is_at_end() = 0;
+
+		/*!
+			Writes at least one and at most @c count of the next pulses to @c target, ending the batch with
+			the pulse upon which @c virtual_is_at_end first becomes @c true, if any.
+
+			The default implementation calls @c virtual_get_next_pulse and @c virtual_is_at_end for each pulse.
+
+			@returns the number of pulses written.
+		*/
+		virtual std::size_t virtual_get_next_pulses(Pulse *target, std::size_t count);
+
+		// Pulses obtained from the subclass but not yet returned by get_next_pulse.
+		static constexpr std::size_t BufferSize = 256;
+		std::array<Pulse, BufferSize> pulses_;
+		std::size_t pulse_pointer_ = 0, pulse_count_ = 0;
+		void get_next_batch();
+
+		// The position at the start of the most recent call to get_next_pulses; invalid if the
+		// tape has since been repositioned, or has moved on to another batch.
+		struct {
+			std::size_t pulse_pointer = 0;
+			uint64_t offset = 0;
+			Time time;
+			bool is_valid = false;
+		} last_pulses_;
+
+		// Checkpoints are recorded at most once every CheckpointInterval pulses, being built
+		// lazily as the tape is played; they're therefore ordered by both offset and time.
+		static constexpr uint64_t CheckpointInterval = 4096;
+		struct Checkpoint {
+			uint64_t offset;
+			Time time;
+			std::any state;
+		};
+		std::vector<Checkpoint> checkpoints_;
+		void resume(const Checkpoint &);
 };
 
 /*!
@@ -104,6 +208,10 @@ class TapePlayer: public TimedEventLoop, public ClockingHint::Source {
 		bool has_tape();
 		std::shared_ptr<Storage::Tape::Tape> get_tape();
 
+		/// @returns @c true if there is no tape, or if the tape has progressed beyond all recorded content
+		/// and all pulses obtained from it have been played; @c false otherwise.
+		bool is_at_end() const;
+
 		void run_for(const Cycles cycles);
 
 		void run_for_input_pulse();
@@ -122,6 +230,13 @@ class TapePlayer: public TimedEventLoop, public ClockingHint::Source {
 
 		std::shared_ptr<Storage::Tape::Tape> tape_;
 		Tape::Pulse current_pulse_;
+
+		// Pulses obtained from the tape but not yet played. These are returned to the tape whenever
+		// it is accessed via get_tape, so that anything else reading from it remains in step.
+		static constexpr std::size_t BufferSize = 64;
+		std::array<Tape::Pulse, BufferSize> pulses_;
+		std::size_t pulse_pointer_ = 0, pulse_count_ = 0;
+		void return_pulses();
 };
 
 /*!